@@ -0,0 +1,168 @@
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+
+/* __________________________ SML library ________ */
+#include "../inc/mesh.h"
+#include "../inc/meshbvh.h"
+
+using namespace std;
+
+/* ************************************************************************ */
+/* ***						  GLOBALS VARIABLES                  		*** */
+/* ************************************************************************ */
+
+int		__width = 1000;											/* Number of rays along each side of the picture. */
+double	__offset = 0;											/* Translation of the mesh along the three axes (the precision far from the origin is checked too). */
+int		__nChecked = 200;										/* Number of rays checked against a search over every face. */
+
+
+/* ************************************************************************ */
+/* ***						FUNCTIONS PROTOTYPES                  		*** */
+/* ************************************************************************ */
+double	seconds		( chrono::steady_clock::time_point _start );	/* Time elapsed since _start. */
+int		bruteHit	( Mesh& _mesh, Vector3D _origin, Vector3D _dir, double& _t );	/* First face hit by a ray, searched among every face. */
+int		main		( int _argc, char** _argv );				/* Main function, loads the mesh, builds its BVH, casts a picture of rays on it and checks some of them. */
+
+/* ************************************************************************ */
+/* ***						  MAIN PROGRAM								*** */
+/* ************************************************************************ */
+double seconds ( chrono::steady_clock::time_point _start )
+{
+	return chrono::duration<double>( chrono::steady_clock::now() - _start ).count();
+}
+
+int bruteHit ( Mesh& _mesh, Vector3D _origin, Vector3D _dir, double& _t )
+{
+	double	o[3] = { _origin.getX(), _origin.getY(), _origin.getZ() };
+	double	d[3] = { _dir.getX(), _dir.getY(), _dir.getZ() };
+	int		hit = -1;
+
+	/* The same fans of triangles and the same test (Moller-Trumbore) as the BVH. */
+	for ( Face f : _mesh.getFaceRange() )
+	{
+		int			size = f.getNEdges();
+		const Real*	p0 = f.getIEdge( size-1 ).getHead().getPosArray();
+
+		for ( int j = 1 ; j < size-1 ; j++ )
+		{
+			const Real*	p1 = f.getIEdge( j-1 ).getHead().getPosArray();
+			const Real*	p2 = f.getIEdge( j ).getHead().getPosArray();
+			Real		e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+			Real		e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+			double		p[3] = { d[1] * e2[2] - d[2] * e2[1], d[2] * e2[0] - d[0] * e2[2], d[0] * e2[1] - d[1] * e2[0] };
+			double		det = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+
+			if ( det == 0 )
+				continue;
+
+			double	s[3] = { o[0] - p0[0], o[1] - p0[1], o[2] - p0[2] };
+			double	u = ( s[0] * p[0] + s[1] * p[1] + s[2] * p[2] ) * ( 1.0 / det );
+			double	q[3] = { s[1] * e1[2] - s[2] * e1[1], s[2] * e1[0] - s[0] * e1[2], s[0] * e1[1] - s[1] * e1[0] };
+			double	v = ( d[0] * q[0] + d[1] * q[1] + d[2] * q[2] ) * ( 1.0 / det );
+			double	t = ( e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2] ) * ( 1.0 / det );
+
+			if ( u >= 0 && u <= 1 && v >= 0 && u + v <= 1 && t > 0 && ( hit == -1 || t < _t ) )
+			{
+				hit = f.getID();
+				_t = t;
+			}
+		}
+	}
+
+	return hit;
+}
+
+int main ( int _argc, char** _argv )
+{
+	Mesh		mesh;
+	MeshBVH		bvh;
+	Vector3D	bot, top;
+
+	if ( _argc < 2 || _argc > 4 )
+	{
+		cout<<"Usage : "<<_argv[0]<<" mesh.obj [width] [offset]"<<endl;
+		return -1;
+	}
+
+	if ( _argc >= 3 )
+		__width = max( 1, atoi( _argv[2] ) );
+	if ( _argc == 4 )
+		__offset = atof( _argv[3] );
+
+	if ( mesh.loadOBJ( _argv[1] ) == -1 )
+		return -1;
+
+	for ( Vertex v : mesh.getVertRange() )
+	{
+		Vector3D p = v.getPos();
+
+		v.setPos( Vector3D( p.getX() + __offset, p.getY() + __offset, p.getZ() + __offset ) );
+	}
+
+	if ( mesh.getBoundingBox( bot, top ) == -1 )
+		return -1;
+
+	cout<<"Nb vertices = "<<mesh.getNVerts()<<", Nb faces = "<<mesh.getNFaces()<<endl;
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+	bvh.build( mesh, 1 );
+	cout<<"Build, 1 thread    : "<<seconds( start )<<" s ("<<bvh.getNTriangles()<<" triangles, "<<bvh.getNNodes()<<" nodes)"<<endl;
+
+	start = chrono::steady_clock::now();
+	bvh.build( mesh, 0 );
+	cout<<"Build, every core  : "<<seconds( start )<<" s"<<endl;
+
+	/* The eye is out of the box of the mesh, the rays go through a grid over the middle of the box (a picking or visibility pass). */
+	double		size = tools_boxSize( bot, top );
+	Vector3D	center( ( bot.getX() + top.getX() ) / 2, ( bot.getY() + top.getY() ) / 2, ( bot.getZ() + top.getZ() ) / 2 );
+	Vector3D	eye( center.getX() + 0.3 * size, center.getY() - 1.5 * size, center.getZ() + 1.2 * size );
+	int			nRays = __width * __width;
+	int			nFirst = 0, nAny = 0;
+	double		tFirst, tAny;
+
+	start = chrono::steady_clock::now();
+	for ( int i = 0 ; i < nRays ; i++ )
+	{
+		Vector3D target( center.getX() + size * ( ( i % __width ) / (double)__width - 0.5 ), center.getY() + size * ( ( i / __width ) / (double)__width - 0.5 ), center.getZ() );
+
+		if ( bvh.firstHit( eye, Vector3D( target.getX() - eye.getX(), target.getY() - eye.getY(), target.getZ() - eye.getZ() ) ) != -1 )
+			nFirst++;
+	}
+	tFirst = seconds( start );
+
+	start = chrono::steady_clock::now();
+	for ( int i = 0 ; i < nRays ; i++ )
+	{
+		Vector3D target( center.getX() + size * ( ( i % __width ) / (double)__width - 0.5 ), center.getY() + size * ( ( i / __width ) / (double)__width - 0.5 ), center.getZ() );
+
+		if ( bvh.anyHit( eye, Vector3D( target.getX() - eye.getX(), target.getY() - eye.getY(), target.getZ() - eye.getZ() ) ) )
+			nAny++;
+	}
+	tAny = seconds( start );
+
+	cout<<"First hit : "<<nRays / tFirst / 1e6<<" Mrays/s ("<<nFirst<<" rays hit the mesh)"<<endl;
+	cout<<"Any hit   : "<<nRays / tAny / 1e6<<" Mrays/s ("<<nAny<<" rays hit the mesh)"<<endl;
+
+	/* Some rays spread over the picture are checked against a search among every face : same face and same distance. */
+	int nWrong = 0, nChecked = 0;
+
+	for ( int i = 0 ; i < nRays ; i += max( 1, nRays / __nChecked ) )
+	{
+		Vector3D	target( center.getX() + size * ( ( i % __width ) / (double)__width - 0.5 ), center.getY() + size * ( ( i / __width ) / (double)__width - 0.5 ), center.getZ() );
+		Vector3D	dir( target.getX() - eye.getX(), target.getY() - eye.getY(), target.getZ() - eye.getZ() );
+		double		t = 0, tBrute = 0;
+		int			face = bvh.firstHit( eye, dir, numeric_limits<double>::infinity(), &t );
+		int			faceBrute = bruteHit( mesh, eye, dir, tBrute );
+
+		if ( ( face == -1 ) != ( faceBrute == -1 ) || ( face != -1 && t != tBrute ) || bvh.anyHit( eye, dir ) != ( faceBrute != -1 ) )
+			nWrong++;
+		nChecked++;
+	}
+
+	cout<<"Checked   : "<<nWrong<<" wrong rays out of "<<nChecked<<endl;
+
+	return 0;
+}
@@ -0,0 +1,126 @@
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+
+/* __________________________ SML library ________ */
+#include "../inc/mesh.h"
+
+using namespace std;
+
+/* ************************************************************************ */
+/* ***						  GLOBALS VARIABLES                  		*** */
+/* ************************************************************************ */
+
+int		__nRuns = 5;											/* Number of times each pass is done, the best time is kept. */
+
+
+/* ************************************************************************ */
+/* ***						FUNCTIONS PROTOTYPES                  		*** */
+/* ************************************************************************ */
+double	normalsPass		( Mesh& _mesh );						/* Computes the normals of the mesh. */
+double	smoothingPass	( Mesh& _mesh );						/* Moves each vertex to the mean of its neighbours (one Laplacian smoothing step, written aside). */
+double	best			( Mesh& _mesh, double (*_pass)( Mesh& ) );	/* Best time of a pass over the mesh. */
+int		main			( int _argc, char** _argv );			/* Main function, loads the mesh, reorders copies of it and times the passes. */
+
+/* ************************************************************************ */
+/* ***						  MAIN PROGRAM								*** */
+/* ************************************************************************ */
+double normalsPass ( Mesh& _mesh )
+{
+	_mesh.computeNormals();
+
+	return _mesh.getNormals()[0];
+}
+
+double smoothingPass ( Mesh& _mesh )
+{
+	static vector<Real>	smoothed;
+	ArrayView<Real>		pos = _mesh.getPositions();
+	double				sum = 0;
+
+	smoothed.resize( pos.getSize() );
+
+	for ( Vertex v : _mesh.getVertRange() )
+	{
+		double	mean[3] = { 0, 0, 0 };
+		int		n = 0;
+
+		for ( Edge e : v.getEdgeRange() )
+		{
+			const Real* p = &pos[ 3 * (size_t)e.getHead().getID() ];
+
+			mean[0] += p[0];
+			mean[1] += p[1];
+			mean[2] += p[2];
+			n++;
+		}
+
+		for ( int k = 0 ; k < 3 ; k++ )
+			smoothed[ 3 * (size_t)v.getID() + k ] = ( n > 0 ) ? mean[k] / n : pos[ 3 * (size_t)v.getID() + k ];
+		sum += n;
+	}
+
+	return sum;
+}
+
+double best ( Mesh& _mesh, double (*_pass)( Mesh& ) )
+{
+	double time = -1;
+
+	for ( int r = 0 ; r < __nRuns ; r++ )
+	{
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+		_pass( _mesh );
+
+		double t = chrono::duration<double>( chrono::steady_clock::now() - start ).count();
+
+		if ( time < 0 || t < time )
+			time = t;
+	}
+
+	return time;
+}
+
+int main ( int _argc, char** _argv )
+{
+	Mesh		mesh;
+	const char*	names[3] = { "Morton ", "Hilbert", "RCM    " };
+	int			policies[3] = { REORDER_MORTON, REORDER_HILBERT, REORDER_RCM };
+
+	if ( _argc != 2 && _argc != 3 )
+	{
+		cout<<"Usage : "<<_argv[0]<<" mesh.obj [nRuns]"<<endl;
+		return -1;
+	}
+
+	if ( _argc == 3 )
+		__nRuns = max( 1, atoi( _argv[2] ) );
+
+	if ( mesh.loadOBJ( _argv[1] ) == -1 )
+		return -1;
+
+	cout<<"Nb vertices = "<<mesh.getNVerts()<<", Nb edges = "<<mesh.getNEdges()<<", Nb faces = "<<mesh.getNFaces()<<endl;
+
+	double normals = best( mesh, normalsPass );
+	double smoothing = best( mesh, smoothingPass );
+
+	cout<<"File order : normals "<<normals<<" s, smoothing "<<smoothing<<" s"<<endl;
+
+	for ( int i = 0 ; i < 3 ; i++ )
+	{
+		Mesh						copy = mesh.clone();
+		chrono::steady_clock::time_point	start = chrono::steady_clock::now();
+
+		copy.reorder( policies[i] );
+
+		double reorder = chrono::duration<double>( chrono::steady_clock::now() - start ).count();
+		double n = best( copy, normalsPass );
+		double s = best( copy, smoothingPass );
+
+		cout<<names[i]<<"    : normals "<<n<<" s (x"<<normals / n<<"), smoothing "<<s<<" s (x"<<smoothing / s<<"), reorder "<<reorder<<" s"<<endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,161 @@
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+
+/* __________________________ SML library ________ */
+#include "../inc/mesh.h"
+
+using namespace std;
+
+/* ************************************************************************ */
+/* ***						  GLOBALS VARIABLES                  		*** */
+/* ************************************************************************ */
+
+Mesh	__mesh;													/* Mesh whose elements are walked. */
+int		__nRuns = 5;											/* Number of times each traversal is done, the best time is kept. */
+
+
+/* ************************************************************************ */
+/* ***						FUNCTIONS PROTOTYPES                  		*** */
+/* ************************************************************************ */
+double	faceCornersCopy		();									/* Sums the corners of every face, through the vectors returned by the getters. */
+double	faceCornersRange	();									/* Same sum, through the ranges (nothing is copied). */
+double	oneRingsCopy		();									/* Sums the neighbours of every vertex, through the vectors returned by the getters. */
+double	oneRingsRange		();									/* Same sum, through the ranges (nothing is copied). */
+double	edgeFacesCopy		();									/* Sums the faces of every half edge, through the vectors returned by the getters. */
+double	edgeFacesRange		();									/* Same sum, through the ranges (nothing is copied). */
+void	bench				( const char* _name, double (*_copy)(), double (*_range)() );	/* Times both traversals and prints the speedup. */
+int		main				( int _argc, char** _argv );		/* Main function, loads the mesh and launches the benchmarks. */
+
+/* ************************************************************************ */
+/* ***						  MAIN PROGRAM								*** */
+/* ************************************************************************ */
+double faceCornersCopy ()
+{
+	double sum = 0;
+	vector<Face> faces = __mesh.getFaces();
+
+	/* One getter per corner, as the old display loops did. */
+	for ( int i = 0 ; i < (int)faces.size() ; i++ )
+		for ( int j = 0 ; j < faces[i].getNEdges() ; j++ )
+			sum += faces[i].getEdges()[j].getHead().getPosArray()[0];
+
+	return sum;
+}
+
+double faceCornersRange ()
+{
+	double sum = 0;
+
+	for ( Face f : __mesh.getFaceRange() )
+		for ( Edge e : f.getEdgeRange() )
+			sum += e.getHead().getPosArray()[0];
+
+	return sum;
+}
+
+double oneRingsCopy ()
+{
+	double sum = 0;
+	vector<Vertex> verts = __mesh.getVerts();
+
+	for ( int i = 0 ; i < (int)verts.size() ; i++ )
+	{
+		vector<Edge> edges = verts[i].getEdges();
+
+		for ( int j = 0 ; j < (int)edges.size() ; j++ )
+			sum += edges[j].getHead().getPosArray()[1];
+	}
+
+	return sum;
+}
+
+double oneRingsRange ()
+{
+	double sum = 0;
+
+	for ( Vertex v : __mesh.getVertRange() )
+		for ( Edge e : v.getEdgeRange() )
+			sum += e.getHead().getPosArray()[1];
+
+	return sum;
+}
+
+double edgeFacesCopy ()
+{
+	double sum = 0;
+	vector<Edge> edges = __mesh.getEdges();
+
+	for ( int i = 0 ; i < (int)edges.size() ; i++ )
+	{
+		vector<Face> faces = edges[i].getFaces();
+
+		for ( int j = 0 ; j < (int)faces.size() ; j++ )
+			sum += faces[j].getID();
+	}
+
+	return sum;
+}
+
+double edgeFacesRange ()
+{
+	double sum = 0;
+
+	for ( Edge e : __mesh.getEdgeRange() )
+		for ( Face f : e.getFaceRange() )
+			sum += f.getID();
+
+	return sum;
+}
+
+void bench ( const char* _name, double (*_copy)(), double (*_range)() )
+{
+	double	best[2] = { -1, -1 };
+	double	result[2] = { 0, 0 };
+
+	for ( int r = 0 ; r < __nRuns ; r++ )
+	{
+		for ( int k = 0 ; k < 2 ; k++ )
+		{
+			chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+			result[k] = ( k == 0 ) ? _copy() : _range();
+
+			double time = chrono::duration<double>( chrono::steady_clock::now() - start ).count();
+
+			if ( best[k] < 0 || time < best[k] )
+				best[k] = time;
+		}
+	}
+
+	cout<<_name<<" : vectors "<<best[0]<<" s, ranges "<<best[1]<<" s, speedup x"<<best[0] / best[1];
+
+	if ( result[0] != result[1] )
+		cout<<" (ERROR : the traversals differ, "<<result[0]<<" != "<<result[1]<<")";
+
+	cout<<endl;
+}
+
+int main ( int _argc, char** _argv )
+{
+	if ( _argc != 2 && _argc != 3 )
+	{
+		cout<<"Usage : "<<_argv[0]<<" mesh.obj [nRuns]"<<endl;
+		return -1;
+	}
+
+	if ( _argc == 3 )
+		__nRuns = max( 1, atoi( _argv[2] ) );
+
+	if ( __mesh.loadOBJ( _argv[1] ) == -1 )
+		return -1;
+
+	cout<<"Nb vertices = "<<__mesh.getNVerts()<<", Nb edges = "<<__mesh.getNEdges()<<", Nb faces = "<<__mesh.getNFaces()<<endl;
+
+	bench( "Face corners ", faceCornersCopy, faceCornersRange );
+	bench( "Vertex rings ", oneRingsCopy, oneRingsRange );
+	bench( "Edge faces   ", edgeFacesCopy, edgeFacesRange );
+
+	return 0;
+}
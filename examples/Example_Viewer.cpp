@@ -1,7 +1,11 @@
 #include <iostream>
+#include <string>
+#include <chrono>
+#include <thread>
 
 /* __________________________ SML library ________ */
 #include "../inc/mesh.h"
+#include "../inc/meshloader.h"
 
 /* ___________________ GLUT & OpenGL Librairies __ */
 #ifdef __APPLE__
@@ -29,24 +33,29 @@ int		__winY = 500;											/* Window height. */
 int		__displayMode = SMOOTH;									/* Displaying mode. Changed by user with the keyboard callback. */
 int		__vertexIndex = 0;
 
-Mesh	__mesh;													/* Mesh to visualize, is loaded in the main func. */
+Mesh		__mesh;												/* Mesh to visualize, empty until the loader is done. */
+MeshLoader	__loader;											/* Loads the mesh in the background, started in the main func. */
+char*		__cachePath = NULL;									/* Where the loaded mesh is saved in binary, NULL if it is not. */
+
+const char*	__title = "SML Example -Mesh Viewer using OpenGL and GLUT";
 
 
 /* ************************************************************************ */
 /* ***						FUNCTIONS PROTOTYPES                  		*** */
 /* ************************************************************************ */
-void	printMeshInfo	( Mesh _mesh );							/* Equals to the member method "printInfo". */
+void	printMeshInfo	( Mesh& _mesh );						/* Equals to the member method "printInfo". */
 void	printHelp		();										/* Prints help in the konsole. */
 void	displayGL		();										/* GLUT callback for rendering. */
 void	reshapeGL		( int _w, int _h );						/* GLUT callback for resizing the window. */
 void	initGL			();										/* GLUT OpenGL rendering initialization. */
 void	keyboardGL		( unsigned char _k, int _x, int _y );	/* GLUT callback for keyboard typing. */
+void	idleGL			();										/* GLUT callback while idle, follows the loading and swaps the mesh in. */
 int		main			( int _argc, char** _argv );			/* Main function, launches the glut loop. */
 
 /* ************************************************************************ */
 /* ***						  MAIN PROGRAM								*** */
 /* ************************************************************************ */
-void printMeshInfo ( Mesh _mesh )
+void printMeshInfo ( Mesh& _mesh )
 {
 	cout<<"Mesh Informations :"<<endl;
 	cout<<"___________________"<<endl;
@@ -132,7 +141,12 @@ void initGL()
 void keyboardGL(unsigned char _k, int _x, int _y)
 {
 	if ( _k == 27 || _k == 'q' || _k == 'Q' )
+	{
+		/* A running loading is stopped before leaving. */
+		__loader.cancel();
+		__loader.wait();
 		exit(0);
+	}
 	
 	if ( _k == 'v' || _k == 'V' )
 		__displayMode = VERTICES;
@@ -155,23 +169,77 @@ void keyboardGL(unsigned char _k, int _x, int _y)
 	glutPostRedisplay();
 }
 
+void idleGL ()
+{
+	int result = __loader.getResult();
+	
+	if ( result == 0 )
+	{
+		/* Still loading : the progress is shown in the title of the window. */
+		string title = string( __title ) + " - ";
+		
+		if ( __loader.getStage() == LOAD_BUILDING )
+			title += "building " + to_string( __loader.getFacesBuilt() ) + " / " + to_string( __loader.getFacesRead() ) + " faces";
+		else if ( __loader.getStage() == LOAD_PROCESSING )
+			title += "computing normals";
+		else if ( __loader.getBytesTotal() > 0 )
+			title += "reading " + to_string( 100 * __loader.getBytesRead() / __loader.getBytesTotal() ) + "% (" + to_string( __loader.getFacesRead() ) + " faces)";
+		else
+			title += "reading " + to_string( __loader.getBytesRead() >> 20 ) + " MB (" + to_string( __loader.getFacesRead() ) + " faces)";
+		
+		glutSetWindowTitle( title.c_str() );
+		this_thread::sleep_for( chrono::milliseconds( 50 ) );
+		return;
+	}
+	
+	/* The loading is over : nothing more to follow. */
+	__loader.wait();
+	glutIdleFunc( NULL );
+	
+	if ( result == -1 )
+	{
+		glutSetWindowTitle( ( string( __title ) + " - loading failed" ).c_str() );
+		return;
+	}
+	
+	/* The loaded mesh is taken from the loader, nothing is copied. */
+	__mesh = std::move( __loader.getMesh() );
+	glutSetWindowTitle( __title );
+	glutPostRedisplay();
+	
+	/* The ready to display mesh is saved : the next launches can load it directly. */
+	if ( __cachePath != NULL )
+		__mesh.saveBinary( __cachePath );
+}
+
 int main ( int _argc, char** _argv )
 {
 	int posX, posY;
 	
-	if ( _argc == 2 )
+	if ( _argc == 2 || _argc == 3 )
 	{
-		/* Arguments are correct. We load the mesh, compute its normals and normalize it in a unit-length box. */
-		__mesh.loadOBJ( _argv[1] );
-		__mesh.computeNormals();
-		__mesh.normalize();
+		string	path = _argv[1];
+		
+		/* Arguments are correct. The mesh is loaded in the background while the window opens :
+		   its normals are computed and it is normalized in a unit-length box, unless it is a binary mesh saved by this viewer (already done). */
+		if ( path.size() > 5 && path.compare( path.size() - 5, 5, ".smlb" ) == 0 )
+			__loader.start( _argv[1], 0, false, false );
+		
+		else
+		{
+			__loader.start( _argv[1], 0 );
+			
+			if ( _argc == 3 )
+				__cachePath = _argv[2];
+		}
 		
 		cout<<"Type \"h\" for help"<<endl;
 	}
 	
 	else
 	{
-		cout<<"Usage : "<<_argv[0]<<" mesh.obj"<<endl;
+		cout<<"Usage : "<<_argv[0]<<" mesh.obj [cache.smlb]"<<endl;
+		cout<<"        "<<_argv[0]<<" cache.smlb"<<endl;
 		return -1;
 	}
 	
@@ -187,10 +255,11 @@ int main ( int _argc, char** _argv )
 	glutInitWindowPosition(posX, posY);
 
 	glutInitDisplayMode(GLUT_RGBA | GLUT_DOUBLE | GLUT_DEPTH);	
-	glutCreateWindow("SML Example -Mesh Viewer using OpenGL and GLUT");
+	glutCreateWindow(__title);
 	glutDisplayFunc(displayGL);
 	glutReshapeFunc(reshapeGL);
 	glutKeyboardFunc(keyboardGL);
+	glutIdleFunc(idleGL);
 	initGL();
 	
 	glutMainLoop();
@@ -0,0 +1,435 @@
+#ifndef CIRCULATOR_H
+#define CIRCULATOR_H
+
+/**
+ * \file	circulator.h
+ * \brief	Declaration des circulateurs, parcours sans allocation du voisinage d'un sommet ou d'une face.
+ */
+
+/* ______________________________ My includes ____ */
+#include "define.h"
+
+using namespace std;
+
+/* Every circulator walks the arrays of the mesh in place : it is only a few integers, nothing is allocated.
+   It is used either as a loop :
+
+		for ( VertexVertexCirculator c( v ) ; c.isValid() ; ++c )
+			w = *c;
+
+   or in a range-based for loop :
+
+		for ( Vertex w : VertexVertexCirculator( v ) )
+			...
+
+   The order of the elements is the order of the getters (Vertex::getEdges, Edge::getFaces, Face::getEdges).
+   */
+
+class VertexEdgeCirculator
+{
+	/*!
+	 * \class VertexEdgeCirculator
+	 * \brief Classe représentant le parcours des demi-aretes qui partent d'un sommet, dans l'ordre de leur creation.
+	 *
+	 */
+
+	private :
+		Mesh*	mesh;			/*! <Mesh of the vertex.*/
+		int		edge;			/*! <Current half edge, -1 at the end.*/
+
+	public :
+		/*!
+		*  \brief Constructor of the VertexEdgeCirculator class.
+		*
+		*  Constructor of the VertexEdgeCirculator class : the circulator is on the first half edge starting from _v.
+		*
+		*  \param _v : vertex to turn around.
+		*/
+		VertexEdgeCirculator( Vertex _v );
+
+		/*!
+		*  \brief Getter of the VertexEdgeCirculator class.
+		*
+		*  \return (bool) returns false once every half edge has been walked.
+		*/
+		bool isValid () const;
+
+		/*!
+		*  \brief Getter of the VertexEdgeCirculator class.
+		*
+		*  \return (Edge) returns the current half edge.
+		*/
+		Edge operator* () const;
+
+		/*!
+		*  \brief Moves the circulator to the next half edge.
+		*
+		*  \return (VertexEdgeCirculator&) returns the circulator.
+		*/
+		VertexEdgeCirculator& operator++ ();
+
+		/*!
+		*  \brief Beginning of the range, for the range-based for loops.
+		*
+		*  \return (VertexEdgeCirculator) returns a copy of the circulator.
+		*/
+		VertexEdgeCirculator begin () const;
+
+		/*!
+		*  \brief End of the range, for the range-based for loops.
+		*
+		*  \return (VertexEdgeCirculator) returns the circulator at the end.
+		*/
+		VertexEdgeCirculator end () const;
+
+		/*!
+		*  \brief Comparison operator of the VertexEdgeCirculator class.
+		*
+		*  \return (bool) returns true if the circulators are not on the same half edge.
+		*/
+		bool operator!= ( const VertexEdgeCirculator& _c ) const;
+};
+
+class VertexVertexCirculator
+{
+	/*!
+	 * \class VertexVertexCirculator
+	 * \brief Classe représentant le parcours des voisins d'un sommet : les tetes des demi-aretes qui en partent.
+	 *
+	 */
+
+	private :
+		Mesh*	mesh;			/*! <Mesh of the vertex.*/
+		int		edge;			/*! <Half edge going to the current vertex, -1 at the end.*/
+
+	public :
+		/*!
+		*  \brief Constructor of the VertexVertexCirculator class.
+		*
+		*  Constructor of the VertexVertexCirculator class : the circulator is on the first neighbour of _v.
+		*
+		*  \param _v : vertex to turn around.
+		*/
+		VertexVertexCirculator( Vertex _v );
+
+		/*!
+		*  \brief Getter of the VertexVertexCirculator class.
+		*
+		*  \return (bool) returns false once every neighbour has been walked.
+		*/
+		bool isValid () const;
+
+		/*!
+		*  \brief Getter of the VertexVertexCirculator class.
+		*
+		*  \return (Vertex) returns the current neighbour.
+		*/
+		Vertex operator* () const;
+
+		/*!
+		*  \brief Moves the circulator to the next neighbour.
+		*
+		*  \return (VertexVertexCirculator&) returns the circulator.
+		*/
+		VertexVertexCirculator& operator++ ();
+
+		/*!
+		*  \brief Beginning of the range, for the range-based for loops.
+		*
+		*  \return (VertexVertexCirculator) returns a copy of the circulator.
+		*/
+		VertexVertexCirculator begin () const;
+
+		/*!
+		*  \brief End of the range, for the range-based for loops.
+		*
+		*  \return (VertexVertexCirculator) returns the circulator at the end.
+		*/
+		VertexVertexCirculator end () const;
+
+		/*!
+		*  \brief Comparison operator of the VertexVertexCirculator class.
+		*
+		*  \return (bool) returns true if the circulators are not on the same neighbour.
+		*/
+		bool operator!= ( const VertexVertexCirculator& _c ) const;
+};
+
+class VertexFaceCirculator
+{
+	/*!
+	 * \class VertexFaceCirculator
+	 * \brief Classe représentant le parcours des faces qui contiennent un sommet.
+	 *
+	 * Les faces sont celles des demi-aretes qui partent du sommet (toutes leurs faces pour une demi-arete non manifold) :
+	 * ce sont les faces moyennees par Mesh::computeNormals. Chaque face n'est vue qu'une fois dans un maillage manifold.
+	 *
+	 */
+
+	private :
+		Mesh*	mesh;			/*! <Mesh of the vertex.*/
+		int		edge;			/*! <Current half edge starting from the vertex, -1 at the end.*/
+		int		extra;			/*! <Current item of the extra list of the half edge, -1 for its first face.*/
+
+	public :
+		/*!
+		*  \brief Constructor of the VertexFaceCirculator class.
+		*
+		*  Constructor of the VertexFaceCirculator class : the circulator is on the first face containing _v.
+		*
+		*  \param _v : vertex to turn around.
+		*/
+		VertexFaceCirculator( Vertex _v );
+
+		/*!
+		*  \brief Getter of the VertexFaceCirculator class.
+		*
+		*  \return (bool) returns false once every face has been walked.
+		*/
+		bool isValid () const;
+
+		/*!
+		*  \brief Getter of the VertexFaceCirculator class.
+		*
+		*  \return (Face) returns the current face.
+		*/
+		Face operator* () const;
+
+		/*!
+		*  \brief Moves the circulator to the next face.
+		*
+		*  \return (VertexFaceCirculator&) returns the circulator.
+		*/
+		VertexFaceCirculator& operator++ ();
+
+		/*!
+		*  \brief Beginning of the range, for the range-based for loops.
+		*
+		*  \return (VertexFaceCirculator) returns a copy of the circulator.
+		*/
+		VertexFaceCirculator begin () const;
+
+		/*!
+		*  \brief End of the range, for the range-based for loops.
+		*
+		*  \return (VertexFaceCirculator) returns the circulator at the end.
+		*/
+		VertexFaceCirculator end () const;
+
+		/*!
+		*  \brief Comparison operator of the VertexFaceCirculator class.
+		*
+		*  \return (bool) returns true if the circulators are not on the same face.
+		*/
+		bool operator!= ( const VertexFaceCirculator& _c ) const;
+};
+
+class EdgeFaceCirculator
+{
+	/*!
+	 * \class EdgeFaceCirculator
+	 * \brief Classe représentant le parcours des faces d'une demi-arete : sa face, puis les autres si elle est non manifold.
+	 *
+	 */
+
+	private :
+		Mesh*	mesh;			/*! <Mesh of the half edge.*/
+		int		edge;			/*! <Half edge, -1 at the end.*/
+		int		extra;			/*! <Current item of the extra list of the half edge, -1 for its first face.*/
+
+	public :
+		/*!
+		*  \brief Constructor of the EdgeFaceCirculator class.
+		*
+		*  Constructor of the EdgeFaceCirculator class : the circulator is on the first face of _e (at the end for a half edge of the border).
+		*
+		*  \param _e : half edge whose faces are walked.
+		*/
+		EdgeFaceCirculator( Edge _e );
+
+		/*!
+		*  \brief Getter of the EdgeFaceCirculator class.
+		*
+		*  \return (bool) returns false once every face has been walked.
+		*/
+		bool isValid () const;
+
+		/*!
+		*  \brief Getter of the EdgeFaceCirculator class.
+		*
+		*  \return (Face) returns the current face.
+		*/
+		Face operator* () const;
+
+		/*!
+		*  \brief Moves the circulator to the next face.
+		*
+		*  \return (EdgeFaceCirculator&) returns the circulator.
+		*/
+		EdgeFaceCirculator& operator++ ();
+
+		/*!
+		*  \brief Beginning of the range, for the range-based for loops.
+		*
+		*  \return (EdgeFaceCirculator) returns a copy of the circulator.
+		*/
+		EdgeFaceCirculator begin () const;
+
+		/*!
+		*  \brief End of the range, for the range-based for loops.
+		*
+		*  \return (EdgeFaceCirculator) returns the circulator at the end.
+		*/
+		EdgeFaceCirculator end () const;
+
+		/*!
+		*  \brief Comparison operator of the EdgeFaceCirculator class.
+		*
+		*  \return (bool) returns true if the circulators are not on the same face.
+		*/
+		bool operator!= ( const EdgeFaceCirculator& _c ) const;
+};
+
+class FaceEdgeCirculator
+{
+	/*!
+	 * \class FaceEdgeCirculator
+	 * \brief Classe représentant le parcours du contour d'une face : [v0, v1], [v1, v2], ..., [vn-1, v0].
+	 *
+	 */
+
+	private :
+		Mesh*	mesh;			/*! <Mesh of the face.*/
+		int		corner;			/*! <Index of the current half edge in the loops of the mesh.*/
+		int		stop;			/*! <Index after the last half edge of the loop.*/
+
+	public :
+		/*!
+		*  \brief Constructor of the FaceEdgeCirculator class.
+		*
+		*  Constructor of the FaceEdgeCirculator class : the circulator is on the first half edge of the loop of _f.
+		*
+		*  \param _f : face to turn around.
+		*/
+		FaceEdgeCirculator( Face _f );
+
+		/*!
+		*  \brief Getter of the FaceEdgeCirculator class.
+		*
+		*  \return (bool) returns false once every half edge has been walked.
+		*/
+		bool isValid () const;
+
+		/*!
+		*  \brief Getter of the FaceEdgeCirculator class.
+		*
+		*  \return (Edge) returns the current half edge.
+		*/
+		Edge operator* () const;
+
+		/*!
+		*  \brief Moves the circulator to the next half edge of the loop.
+		*
+		*  \return (FaceEdgeCirculator&) returns the circulator.
+		*/
+		FaceEdgeCirculator& operator++ ();
+
+		/*!
+		*  \brief Beginning of the range, for the range-based for loops.
+		*
+		*  \return (FaceEdgeCirculator) returns a copy of the circulator.
+		*/
+		FaceEdgeCirculator begin () const;
+
+		/*!
+		*  \brief End of the range, for the range-based for loops.
+		*
+		*  \return (FaceEdgeCirculator) returns the circulator at the end.
+		*/
+		FaceEdgeCirculator end () const;
+
+		/*!
+		*  \brief Comparison operator of the FaceEdgeCirculator class.
+		*
+		*  \return (bool) returns true if the circulators are not on the same half edge.
+		*/
+		bool operator!= ( const FaceEdgeCirculator& _c ) const;
+};
+
+class FaceFaceCirculator
+{
+	/*!
+	 * \class FaceFaceCirculator
+	 * \brief Classe représentant le parcours des faces voisines d'une face : les faces des jumelles des demi-aretes de son contour.
+	 *
+	 * Les aretes du bord n'ont pas de voisine, une arete non manifold en a plusieurs.
+	 *
+	 */
+
+	private :
+		Mesh*	mesh;			/*! <Mesh of the face.*/
+		int		corner;			/*! <Index of the current half edge in the loops of the mesh.*/
+		int		stop;			/*! <Index after the last half edge of the loop.*/
+		int		extra;			/*! <Current item of the extra list of the twin, -1 for its first face.*/
+
+		/*!
+		*  \brief Moves the circulator to the first half edge, from the current one, whose twin has a face.
+		*
+		*  \return (void)
+		*/
+		void skipBorder ();
+
+	public :
+		/*!
+		*  \brief Constructor of the FaceFaceCirculator class.
+		*
+		*  Constructor of the FaceFaceCirculator class : the circulator is on the first neighbour of _f.
+		*
+		*  \param _f : face to turn around.
+		*/
+		FaceFaceCirculator( Face _f );
+
+		/*!
+		*  \brief Getter of the FaceFaceCirculator class.
+		*
+		*  \return (bool) returns false once every neighbour has been walked.
+		*/
+		bool isValid () const;
+
+		/*!
+		*  \brief Getter of the FaceFaceCirculator class.
+		*
+		*  \return (Face) returns the current neighbour.
+		*/
+		Face operator* () const;
+
+		/*!
+		*  \brief Moves the circulator to the next neighbour.
+		*
+		*  \return (FaceFaceCirculator&) returns the circulator.
+		*/
+		FaceFaceCirculator& operator++ ();
+
+		/*!
+		*  \brief Beginning of the range, for the range-based for loops.
+		*
+		*  \return (FaceFaceCirculator) returns a copy of the circulator.
+		*/
+		FaceFaceCirculator begin () const;
+
+		/*!
+		*  \brief End of the range, for the range-based for loops.
+		*
+		*  \return (FaceFaceCirculator) returns the circulator at the end.
+		*/
+		FaceFaceCirculator end () const;
+
+		/*!
+		*  \brief Comparison operator of the FaceFaceCirculator class.
+		*
+		*  \return (bool) returns true if the circulators are not on the same neighbour.
+		*/
+		bool operator!= ( const FaceFaceCirculator& _c ) const;
+};
+
+#endif
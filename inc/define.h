@@ -3,7 +3,7 @@
 
 /**
  * \file	define.h
- * \brief	Declaration des classes Vertex, Edge et Face
+ * \brief	Declaration des classes Vertex, Edge et Face, poignees sur les elements d'un maillage.
  */
 
 /* ______________________________ My includes ____ */
@@ -28,15 +28,35 @@
         #endif
 #endif
 
+/*! \def GL_REAL
+  OpenGL type of the values stored in the meshes (see Real) : for glVertexPointer, glNormalPointer, ...
+  glVertex3rv, glNormal3rv and glColor3rv are the OpenGL functions that read three of these values.
+ */
+#ifdef SML_FLOAT
+	#define GL_REAL		GL_FLOAT
+	#define glVertex3rv	glVertex3fv
+	#define glNormal3rv	glNormal3fv
+	#define glColor3rv	glColor3fv
+#else
+	#define GL_REAL		GL_DOUBLE
+	#define glVertex3rv	glVertex3dv
+	#define glNormal3rv	glNormal3dv
+	#define glColor3rv	glColor3dv
+#endif
+
 using namespace std;
 
 /* Prototypes of all the class that will be declared in this file :
    While classes needs one another to be declared, several inclusions issues would occur if we dicided
    to create a single class per header file. That is also why we had to write the class prototypes here.
    */
+class	Mesh;
 class	Vertex;
 class	Edge;
 class	Face;
+class	VertexEdgeCirculator;
+class	EdgeFaceCirculator;
+class	FaceEdgeCirculator;
 
 class Vertex
 {
@@ -46,60 +66,67 @@ class Vertex
 	 * 
 	 * Un vertex est represente par ses elements les plus courant, a savoir : sa position dans l'espace, un numero d'identification, un vecteur normal, et une couleur.
 	 * Les informations de voisinnage s'obtiennent a l'aide d'une liste d'arretes (demi-aretes) qui partent de ce vertex.
+	 * Les voisins d'un vertex se parcourent sans allocation avec VertexEdgeCirculator, VertexVertexCirculator et VertexFaceCirculator (voir circulator.h).
+	 *
+	 * Un Vertex n'est qu'une poignee : le maillage auquel il appartient et son numero. Ses donnees sont rangees dans les tableaux du maillage
+	 * (voir Mesh), un Vertex se copie donc librement et reste valide tant que le maillage existe et n'est pas vide.
 	 *
 	 */
 		
 	private :
-		int				id;				/*! <ID of the vertex.*/
-		Vector3D		pos;			/*! <Location in space of the vertex.*/
-		Vector3D		color;			/*! <Color of the vertex.*/
-		Vector3D		normal;			/*! <Normal vector  at the vertex.*/
-		vector<Edge*>	edges;			/*! <List of the edges starting from this vertex.*/
+		Mesh*			mesh;			/*! <Mesh the vertex belongs to, NULL for an invalid vertex.*/
+		int				id;				/*! <ID of the vertex, its index in the arrays of the mesh.*/
 		
 	public :
 		/*!
 		*  \brief Default constructor of the Vertex class.
 		*
-		*  Default constructor of the Vertex class : Every attributes are initialized to 0 (int,float,double,...) NULL (pointers) or are cleared (lists, stacks, ...).
+		*  Default constructor of the Vertex class : an invalid vertex, which belongs to no mesh.
 		*/
 		Vertex();
-	
+		
 		/*!
-		*  \brief Copy constructor of the Vertex class.
+		*  \brief Ovrloaded constructor of the Vertex class.
 		*
-		*  Copy constructor of the Vertex class.
+		*  Overloaded constructor of the Vertex class : the vertex _ID of the mesh _mesh.
 		*/
-		Vertex ( const Vertex &  _v );
+		Vertex( Mesh* _mesh, int _ID );
 		
 		/*!
-		*  \brief Ovrloaded constructor of the Vertex class.
+		*  \brief Getter of the Vertex class.
 		*
-		*  Overloaded constructor of the Vertex class : fill the id of the vertex and its location in space.
+		*  Getter of the Vertex class.
+		*
+		*  \return (bool) returns true if the vertex belongs to a mesh, false for an invalid vertex.
 		*/
-		Vertex( int _ID, Vector3D _pos );
-	
+		bool		isValid ();
+		
 		/*!
-		*  \brief Destructor of the Vertex class.
+		*  \brief Getter of the Vertex class.
 		*
-		*  Destructor of the Vertex class.
+		*  Getter of the Vertex class.
+		*
+		*  \return (int) returns the ID of the vertex.
 		*/
-		~Vertex();
+		int			getID ();
 		
 		/*!
-		*  \brief Affectation operator of the Vertex class.
+		*  \brief Getter of the Vertex class.
+		*
+		*  Getter of the Vertex class.
 		*
-		*  Affectation operator of the Vertex class.
+		*  \return (Mesh*) returns the mesh the vertex belongs to.
 		*/
-		Vertex& operator= ( const Vertex& _v );
+		Mesh*		getMesh ();
 		
 		/*!
 		*  \brief Getter of the Vertex class.
 		*
 		*  Getter of the Vertex class.
 		*
-		*  \return (int) returns the ID of the vertex.
+		*  \return (Edge) returns the first edge which tail is the vertex, an invalid edge for an isolated vertex.
 		*/
-		int			getID ();
+		Edge		getEdge ();
 		
 		/*!
 		*  \brief Getter of the Vertex class.
@@ -115,9 +142,10 @@ class Vertex
 		*
 		*  Getter of the Vertex class.
 		*
-		*  \return (double*) returns the location of the vertex in space as an array of three frames.
+		*  \return (Real*) returns the location of the vertex in space as an array of three frames, in the position array of the mesh
+		*  (a vertex moved through this array is not marked as moved, see Mesh::markMoved).
 		*/
-		double*		getPosArray ();
+		Real*		getPosArray ();
 		
 		/*!
 		*  \brief Getter of the Vertex class.
@@ -133,9 +161,9 @@ class Vertex
 		*
 		*  Getter of the Vertex class.
 		*
-		*  \return (double*) returns the color of the vertex in space as an array of three frames.
+		*  \return (Real*) returns the color of the vertex in space as an array of three frames, in the color array of the mesh.
 		*/
-		double*		getColorArray ();
+		Real*		getColorArray ();
 		
 		/*!
 		*  \brief Getter of the Vertex class.
@@ -151,27 +179,36 @@ class Vertex
 		*
 		*  Getter of the Vertex class.
 		*
-		*  \return (double*) returns the normal of the vertex in spaceas an array of three frames.
+		*  \return (Real*) returns the normal of the vertex in space as an array of three frames, in the normal array of the mesh.
 		*/
-		double*		getNormalArray ();
+		Real*		getNormalArray ();
 		
 		/*!
 		*  \brief Getter of the Vertex class.
 		*
 		*  Getter of the Vertex class.
 		*
-		*  \return (vector<Edge*>) returns a vector containing all the edges which tail is the vertex.
+		*  \return (vector<Edge>) returns a vector containing all the edges which tail is the vertex, in the order they were created.
 		*/
-		vector<Edge*>	getEdges();
+		vector<Edge>	getEdges();
 		
 		/*!
 		*  \brief Getter of the Vertex class.
 		*
-		*  Getter of the Vertex class.
+		*  Getter of the Vertex class, nothing is copied : to be prefered to getEdges in the loops.
 		*
-		*  \return (Edge*) returns a pointer on the ith edge of the edge vector.
+		*  \return (VertexEdgeCirculator) returns the range of the edges which tail is the vertex (see circulator.h).
 		*/
-		Edge* getIEdge ( int _i );
+		VertexEdgeCirculator	getEdgeRange ();
+		
+		/*!
+		*  \brief Getter of the Vertex class.
+		*
+		*  Getter of the Vertex class : the list of the edges is walked up to the ith one.
+		*
+		*  \return (Edge) returns the ith edge of the edge list of the vertex.
+		*/
+		Edge getIEdge ( int _i );
 		
 		/*!
 		*  \brief Prints the ID of the vertex in the terminal.
@@ -221,18 +258,7 @@ class Vertex
 		/*!
 		*  \brief Setter of the Vertex class.
 		*
-		*  Setter of the Vertex class.
-		*
-		*  \param _ID : value to affect to the id attribute of the vertex.
-		*
-		*  \return (void)
-		*/
-		void setID ( int _ID );
-		
-		/*!
-		*  \brief Setter of the Vertex class.
-		*
-		*  Setter of the Vertex class.
+		*  Setter of the Vertex class : the vertex is marked as moved (see Mesh::refreshNormals).
 		*
 		*  \param _pos : position to affect to the vertex.
 		*
@@ -244,6 +270,7 @@ class Vertex
 		*  \brief Setter of the Vertex class.
 		*
 		*  Setter of the Vertex class, this one is written to have a double array in parameter and not a Vector3D.
+		*  The vertex is marked as moved (see Mesh::refreshNormals).
 		*
 		*  \param _pos : position to affect to the vertex.
 		*
@@ -295,17 +322,6 @@ class Vertex
 		*/
 		void setColor ( double* _color );
 		
-		/*!
-		*  \brief Setter of the Vertex class.
-		*
-		*  Setter of the Vertex class.
-		*
-		*  \param _edges : vector of edges to affect to the vertex.
-		*
-		*  \return (void)
-		*/
-		void setEdges ( vector<Edge*> _edges );
-		
 		/*!
 		*  \brief Check for the existing of an edge in the edge vector of a vertex.
 		*
@@ -319,15 +335,18 @@ class Vertex
 		int containsEdge ( int _iTail, int _iHead );
 		
 		/*!
-		*  \brief Adds an edge to the edge vector of the vertex.
-		*
-		*  Adds an edge to the edge vector of the vertex.
+		*  \brief Comparison operator of the Vertex class.
 		*
-		*  \param _e : pointer on the edge we want to add.
+		*  \return (bool) returns true if both vertices are the same vertex of the same mesh.
+		*/
+		bool operator== ( const Vertex& _v ) const;
+		
+		/*!
+		*  \brief Comparison operator of the Vertex class.
 		*
-		*  \return (void)
+		*  \return (bool) returns true if the vertices are different.
 		*/
-		void addEdge ( Edge* _e );
+		bool operator!= ( const Vertex& _v ) const;
 };
 
 class Edge
@@ -337,49 +356,42 @@ class Edge
 	 * \brief Classe représentant une arete (demi-arete), soit, deux sommets relies entre eux dans un ordre precis.
 	 *
 	 * Une arete (demi-arete) est representee par ses elements les plus courant, a savoir : deux sommets, l'un en tete et l'autre en queue - ce qui permet de connaitre le sens de l'arete -
-	 * un identifiant qui devrait etre unique pour chaque arete (demi-arete) d'un meme maillage et un pointeur vers sa (demi-arete) jumelle. Sa jumelle etant l'arete dont la tete correspond
+	 * un identifiant qui devrait etre unique pour chaque arete (demi-arete) d'un meme maillage et sa (demi-arete) jumelle. Sa jumelle etant l'arete dont la tete correspond
 	 * a la queue de celle-ci et vice versa.
-	 * Les informations de voisinnage s'obtiennent par le biais d'un tableau de faces contenant toutes les faces qui contiennent cette arete.
+	 * Les informations de voisinnage s'obtiennent par le biais de la liste des faces qui contiennent cette arete : la premiere est sa face (getFace),
+	 * getNext et getPrev donnent les aretes suivante et precedente dans le contour de cette face. Les suivantes n'existent que pour une arete non manifold.
+	 *
+	 * Une Edge n'est qu'une poignee : le maillage auquel elle appartient et son numero (voir Vertex).
 	 *
 	 */
 	
 	private :
-		int				id;				/*! <ID of the egde. */
-		Vertex*			tail;			/*! <Pointer to the tail vertex of the edge. */
-		Vertex*			head;			/*! <Pointer to the head vertex of tyhe edge. */ 
-		Edge*			twin;			/*! <Pointer to the twin edge (the "opposote" edge). */
-		vector<Face*>	faces;			/*! <List of the faces which are bordered by this edge. */
+		Mesh*			mesh;			/*! <Mesh the edge belongs to, NULL for an invalid edge. */
+		int				id;				/*! <ID of the egde, its index in the arrays of the mesh. */
 		
 	public :
 		/*!
 		*  \brief Default constructor of the Edge class.
 		*
-		*  Default constructor of the Edge class : Every attributes are initialized to 0 (int,float,double,...) NULL (pointers) or are cleared (lists, stacks, ...).
+		*  Default constructor of the Edge class : an invalid edge, which belongs to no mesh.
 		*/
 		Edge();
 	
 		/*!
-		*  \brief Default constructor of the Edge class.
+		*  \brief Overloaded constructor of the Edge class.
 		*
-		*  Default constructor of the Edge class : Every attributes are initialized to 0 (int,float,double,...) NULL (pointers) or are cleared (lists, stacks, ...).
+		*  Overloaded constructor of the Edge class : the half edge _ID of the mesh _mesh.
 		*/
-		Edge ( int _ID, Vertex* _tail, Vertex* _head );
-	
-		/*!
-		*  \brief Copy constructor of the Edge class.
-		*
-		*  Copy constructor of the Edge class.
-		*/
-		Edge ( const Edge& _e );
+		Edge ( Mesh* _mesh, int _ID );
 		
 		/*!
-		*  \brief Destructor of the Edge class.
+		*  \brief Getter of the Edge class.
 		*
-		*  Destructor of the Edge class.
+		*  Getter of the Edge class.
+		*
+		*  \return (bool) returns true if the edge belongs to a mesh, false for an invalid edge.
 		*/
-		~Edge ();
-		
-		Edge& operator= ( const Edge& _e );
+		bool	isValid ();
 	
 		/*!
 		*  \brief Getter of the Edge class.
@@ -395,122 +407,115 @@ class Edge
 		*
 		*  Getter of the Edge class.
 		*
-		*  \return (Vertex*) returns a pointer to the vertex which is the tail of the edge.
+		*  \return (Mesh*) returns the mesh the edge belongs to.
 		*/
-		Vertex*	getTail ();
+		Mesh*	getMesh ();
 		
 		/*!
 		*  \brief Getter of the Edge class.
 		*
 		*  Getter of the Edge class.
 		*
-		*  \return (Vertex*) returns a pointer to the vertex which is the head of the edge.
+		*  \return (Vertex) returns the vertex which is the tail of the edge.
 		*/
-		Vertex*	getHead ();
+		Vertex	getTail ();
 		
 		/*!
 		*  \brief Getter of the Edge class.
 		*
 		*  Getter of the Edge class.
 		*
-		*  \return (Edge) returns a pointer to the twin edge of the edge.
+		*  \return (Vertex) returns the vertex which is the head of the edge.
 		*/
-		Edge*	getTwin ();
+		Vertex	getHead ();
 		
 		/*!
 		*  \brief Getter of the Edge class.
 		*
 		*  Getter of the Edge class.
 		*
-		*  \return (vector<Face*>) returns a vector containing the faces that contain the edge.
+		*  \return (Edge) returns the twin edge of the edge.
 		*/
-		vector<Face*>	getFaces ();
+		Edge	getTwin ();
 		
 		/*!
 		*  \brief Getter of the Edge class.
 		*
 		*  Getter of the Edge class.
 		*
-		*  \param _i : index of the face to return;
-		*
-		*  \return (Face*) returns a pointer to the ith face in the face array of the edge;
+		*  \return (Edge) returns the edge following this one in the loop of its face, an invalid edge if the edge has no face.
 		*/
-		Face*	getIFace ( int _i );
+		Edge	getNext ();
 		
 		/*!
-		*  \brief Convert an edge to a 3 dimension vector.
+		*  \brief Getter of the Edge class.
 		*
-		*  Convert an edge to the 3 dimension vector defined as (head - tail).
+		*  Getter of the Edge class.
 		*
-		*  \return (Vector3D) returns a vector computed as (head - tail).
+		*  \return (Edge) returns the edge preceding this one in the loop of its face, an invalid edge if the edge has no face.
 		*/
-		Vector3D toVector ();
+		Edge	getPrev ();
 		
 		/*!
-		*  \brief Setter of the Edge class.
-		*
-		*  Setter of the Edge class.
+		*  \brief Getter of the Edge class.
 		*
-		*  \param _ID : ID to affect to the edge.
+		*  Getter of the Edge class.
 		*
-		*  \return (void)
+		*  \return (Face) returns the first face that contains the edge, an invalid face if the edge is on the border.
 		*/
-		void setID ( int _ID );
+		Face	getFace ();
 		
 		/*!
-		*  \brief Setter of the Edge class.
-		*
-		*  Setter of the Edge class.
+		*  \brief Getter of the Edge class.
 		*
-		*  \param _tail : pointer to the vertex to affect to the tail of the edge.
+		*  Getter of the Edge class.
 		*
-		*  \return (void)
+		*  \return (vector<Face>) returns a vector containing the faces that contain the edge.
 		*/
-		void setTail ( Vertex* _tail );
+		vector<Face>	getFaces ();
 		
 		/*!
-		*  \brief Setter of the Edge class.
-		*
-		*  Setter of the Edge class.
+		*  \brief Getter of the Edge class.
 		*
-		*  \param _head : pointer to the vertex to affect to the head of the edge.
+		*  Getter of the Edge class, nothing is copied : to be prefered to getFaces in the loops.
 		*
-		*  \return (void)
+		*  \return (EdgeFaceCirculator) returns the range of the faces that contain the edge (see circulator.h).
 		*/
-		void setHead ( Vertex* _head );
+		EdgeFaceCirculator	getFaceRange ();
 		
 		/*!
-		*  \brief Setter of the Edge class.
+		*  \brief Getter of the Edge class.
 		*
-		*  Setter of the Edge class.
+		*  Getter of the Edge class.
 		*
-		*  \param _twin : pointer to the edge affect to the twin of the edge.
+		*  \param _i : index of the face to return;
 		*
-		*  \return (void)
+		*  \return (Face) returns the ith face in the face list of the edge;
 		*/
-		void setTwin ( Edge* _twin );
+		Face	getIFace ( int _i );
 		
 		/*!
-		*  \brief Setter of the Edge class.
-		*
-		*  Setter of the Edge class.
+		*  \brief Convert an edge to a 3 dimension vector.
 		*
-		*  \param _faces : vector containing faces to affect to the faces attribut of the edge.
+		*  Convert an edge to the 3 dimension vector defined as (head - tail).
 		*
-		*  \return (void)
+		*  \return (Vector3D) returns a vector computed as (head - tail).
 		*/
-		void setFaces ( vector<Face*> _faces );
+		Vector3D toVector ();
 		
 		/*!
-		*  \brief Adds a face to the edge.
+		*  \brief Comparison operator of the Edge class.
 		*
-		*  Adds a given face to the edge.
-		*
-		*  \param _f : face to add to the edge.
+		*  \return (bool) returns true if both edges are the same half edge of the same mesh.
+		*/
+		bool operator== ( const Edge& _e ) const;
+		
+		/*!
+		*  \brief Comparison operator of the Edge class.
 		*
-		*  \return (void)
+		*  \return (bool) returns true if the edges are different.
 		*/
-		void addFace ( Face* _f );
+		bool operator!= ( const Edge& _e ) const;
 };
 
 class Face
@@ -524,64 +529,55 @@ class Face
 	 * {[0,1] [1,2] [2,0]} avec [0,1] representant l'arete qui part du point 0 pour aller vers le point 1.
 	 * Les informations de voisinnage s'obtiennent aussi en parcourant ce tableau (et eventuellement les tableaux de ces aretes).
 	 *
+	 * Une Face n'est qu'une poignee : le maillage auquel elle appartient et son numero (voir Vertex).
+	 *
 	 */
 	
 	private :
-		int				id;				/*! <ID of the face. */
-		Vector3D		normal;			/*! <Normal vector to the face. */
-		vector<Edge*>	edges;			/*! <List of edges that makes the face : they describe a line loop. */
+		Mesh*			mesh;			/*! <Mesh the face belongs to, NULL for an invalid face. */
+		int				id;				/*! <ID of the face, its index in the arrays of the mesh. */
 		
 	public :
 		/*!
 		*  \brief Default constructor of the Face class.
 		*
-		*  Default constructor of the Face class : Every attributes are initialized to 0 (int,float,double,...) NULL (pointers) or are cleared (lists, stacks, ...).
+		*  Default constructor of the Face class : an invalid face, which belongs to no mesh.
 		*/
 		Face();
-	
-		/*!
-		*  \brief Copy constructor of the Face class.
-		*
-		*  Copy constructor of the Face class : Every attributes are initialized to 0 (int,float,double,...) NULL (pointers) or are cleared (lists, stacks, ...).
-		*/
-		Face( const Face& _face );
 		
 		/*!
 		*  \brief Overloaded constructor of the Face class.
 		*
-		*  Overloaded constructor of the Face class : fill the id and of the edge. The rest is initialized to 0, NULL or cleared.
+		*  Overloaded constructor of the Face class : the face _ID of the mesh _mesh.
 		*/
-		Face( int _ID );
+		Face( Mesh* _mesh, int _ID );
 		
 		/*!
-		*  \brief Overloaded constructor of the Face class.
+		*  \brief Getter of the Face class.
 		*
-		*  Overloaded constructor of the Face class : fill the id and the edges vector of the face. The normal will be set to 0;
-		*/
-		Face( int _ID, vector<Edge*> _edges );
-		
-		/*!
-		*  \brief Destructor of the Face class.
+		*  Getter of the Face class.
 		*
-		*  Destructor of the Face class : Every attributes are initialized to 0 (int,float,double,...) NULL (pointers) or are cleared (lists, stacks, ...).
+		*  \return (bool) returns true if the face belongs to a mesh, false for an invalid face.
 		*/
-		~Face();
+		bool isValid ();
 		
 		/*!
-		*  \brief Affectation operator of the Face class.
+		*  \brief Getter of the Face class.
+		*
+		*  Getter of the Face class.
 		*
-		*  Affectation operator of the Face class : Every attributes are initialized to 0 (int,float,double,...) NULL (pointers) or are cleared (lists, stacks, ...).
+		*  \return (int) returns the ID of the face.
 		*/
-		Face& operator= ( const Face& _face );
+		int getID ();
 		
 		/*!
 		*  \brief Getter of the Face class.
 		*
 		*  Getter of the Face class.
 		*
-		*  \return (int) returns the ID of the face.
+		*  \return (Mesh*) returns the mesh the face belongs to.
 		*/
-		int getID ();
+		Mesh* getMesh ();
 		
 		/*!
 		*  \brief Getter of the Face class.
@@ -597,62 +593,67 @@ class Face
 		*
 		*  Getter of the Face class, returns a doule array instead of a Vector3D.
 		*
-		*  \return (double*) returns the norma to the face.
+		*  \return (Real*) returns the normal to the face, in the face normal array of the mesh.
 		*/
-		double* getNormalArray ();
+		Real* getNormalArray ();
 		
 		/*!
 		*  \brief Getter of the Face class.
 		*
 		*  Getter of the Face class.
 		*
-		*  \return (vector<Edge*>) returns a vector of the edges composing the face.
+		*  \return (int) returns the number of edges of the face.
 		*/
-		vector<Edge*> getEdges ();
+		int getNEdges ();
 		
 		/*!
-		*  \brief Setter of the Face class.
+		*  \brief Computes the area of the face.
 		*
-		*  Setter of the Face class.
-		*
-		*  \param _ID : ID we want to affect to the face.
+		*  Computes the area of the face, split in triangles from its first vertex (exact for a planar face, even if it is not convex).
 		*
-		*  \return (void)
+		*  \return (double) returns the area of the face.
 		*/
-		void setID ( int _ID );
+		double getArea ();
 		
 		/*!
-		*  \brief Setter of the Face class.
+		*  \brief Getter of the Face class.
 		*
-		*  Setter of the Face class.
+		*  Getter of the Face class.
 		*
-		*  \param _normal : the normal we want to affect to the face.
+		*  \return (vector<Edge>) returns a vector of the edges composing the face.
+		*/
+		vector<Edge> getEdges ();
+		
+		/*!
+		*  \brief Getter of the Face class.
 		*
-		*  \return (void)
+		*  Getter of the Face class, nothing is copied : to be prefered to getEdges in the loops.
+		*
+		*  \return (FaceEdgeCirculator) returns the range of the edges composing the face (see circulator.h).
 		*/
-		void setNormal ( Vector3D _normal );
+		FaceEdgeCirculator getEdgeRange ();
 		
 		/*!
-		*  \brief Setter of the Face class.
+		*  \brief Getter of the Face class.
 		*
-		*  Setter of the Face class.
+		*  Getter of the Face class.
 		*
-		*  \param _edges : vector of the edges we want to affect to the edges attribute of the face.
+		*  \param _i : index of the edge in the loop of the face.
 		*
-		*  \return (void)
+		*  \return (Edge) returns the ith edge of the loop of the face.
 		*/
-		void setEdges ( vector<Edge*> _edges );
+		Edge getIEdge ( int _i );
 		
 		/*!
-		*  \brief Adds an edge to the face.
+		*  \brief Setter of the Face class.
 		*
-		*  Adds a given edge to the face.
+		*  Setter of the Face class.
 		*
-		*  \param _e : the edge to add to the face.
+		*  \param _normal : the normal we want to affect to the face.
 		*
 		*  \return (void)
 		*/
-		void addEdge ( Edge* _e );
+		void setNormal ( Vector3D _normal );
 		
 		/*!
 		*  \brief Display the face.
@@ -675,6 +676,20 @@ class Face
 		*  \return (void)
 		*/
 		void display ();
+		
+		/*!
+		*  \brief Comparison operator of the Face class.
+		*
+		*  \return (bool) returns true if both faces are the same face of the same mesh.
+		*/
+		bool operator== ( const Face& _f ) const;
+		
+		/*!
+		*  \brief Comparison operator of the Face class.
+		*
+		*  \return (bool) returns true if the faces are different.
+		*/
+		bool operator!= ( const Face& _f ) const;
 };
 
 #endif
@@ -0,0 +1,166 @@
+#ifndef EDGEINDEX_H
+#define EDGEINDEX_H
+
+/**
+ * \file	edgeindex.h
+ * \brief	Declaration de la classe EdgeIndex, une table de hachage des demi-aretes d'un maillage indexees par leurs sommets.
+ */
+
+/* ____________________________ STD Librairies ___ */
+#include <vector>
+
+using namespace std;
+
+class EdgeIndex
+{
+	/*!
+	 * \class EdgeIndex
+	 * \brief Classe représentant un index des demi-aretes d'un maillage.
+	 *
+	 * Chaque demi-arete est identifiee par le couple (queue, tete) des ID de ses deux sommets.
+	 * L'index est une table de hachage a adressage ouvert : la recherche d'une demi-arete se fait donc en temps constant (en moyenne),
+	 * quel que soit le nombre d'aretes du maillage ou la valence de ses sommets.
+	 * Les premieres cases sondees sont voisines de celles des sommets d'ID proches (localite des acces lors d'un chargement),
+	 * les suivantes sont dispersees dans toute la table (double hachage).
+	 * La table est agrandie automatiquement pour que son taux de remplissage ne depasse jamais 1/2.
+	 *
+	 */
+
+	private :
+		/*!
+		 * \struct Slot
+		 * \brief Case de la table : la cle (queue, tete) et l'indice de la demi-arete sont ranges cote a cote pour qu'une recherche ne coute qu'un acces memoire.
+		 */
+		struct Slot
+		{
+			int		tail;				/*! <ID of the tail vertex of the half edge.*/
+			int		head;				/*! <ID of the head vertex of the half edge.*/
+			int		index;				/*! <Index of the half edge in the mesh, -1 for a free slot.*/
+		};
+
+		vector<Slot>	slots;			/*! <Slots of the table, their number is always a power of two.*/
+		int				count;			/*! <Number of half edges stored in the table.*/
+
+		/*!
+		*  \brief Finds the slot of a half edge.
+		*
+		*  Finds the slot where the half edge [_iTail, _iHead] is stored, or the free slot where it should be inserted.
+		*
+		*  \param _iTail : index of the tail vertex of the half edge.
+		*  \param _iHead : index of the head vertex of the half edge.
+		*
+		*  \return (size_t) returns the index of the slot.
+		*/
+		size_t slot ( int _iTail, int _iHead ) const;
+
+		/*!
+		*  \brief Resizes the table.
+		*
+		*  Reallocates the table with _capacity slots (a power of two) and inserts back every stored half edge.
+		*
+		*  \param _capacity : new number of slots of the table.
+		*
+		*  \return (void)
+		*/
+		void rehash ( size_t _capacity );
+
+	public :
+		/*!
+		*  \brief Default constructor of the EdgeIndex class.
+		*
+		*  Default constructor of the EdgeIndex class : the index is empty.
+		*/
+		EdgeIndex();
+
+		/*!
+		*  \brief Copy constructor of the EdgeIndex class.
+		*
+		*  Copy constructor of the EdgeIndex class.
+		*/
+		EdgeIndex( const EdgeIndex& _i );
+
+		/*!
+		*  \brief Move constructor of the EdgeIndex class.
+		*
+		*  Move constructor of the EdgeIndex class : the table of _i is taken, _i is left empty.
+		*/
+		EdgeIndex( EdgeIndex&& _i );
+
+		/*!
+		*  \brief Destructor of the EdgeIndex class.
+		*
+		*  Destructor of the EdgeIndex class.
+		*/
+		~EdgeIndex();
+
+		/*!
+		*  \brief Affectation operator of the EdgeIndex class.
+		*
+		*  Affectation operator of the EdgeIndex class.
+		*/
+		EdgeIndex& operator= ( const EdgeIndex& _i );
+
+		/*!
+		*  \brief Move affectation operator of the EdgeIndex class.
+		*
+		*  Move affectation operator of the EdgeIndex class : the table of _i is taken, _i is left empty.
+		*/
+		EdgeIndex& operator= ( EdgeIndex&& _i );
+
+		/*!
+		*  \brief Getter of the EdgeIndex class.
+		*
+		*  Getter of the EdgeIndex class.
+		*
+		*  \return (int) returns the number of half edges stored in the index.
+		*/
+		int getSize () const;
+
+		/*!
+		*  \brief Clears the index.
+		*
+		*  Removes every half edge from the index and releases its memory.
+		*
+		*  \return (void)
+		*/
+		void clear ();
+
+		/*!
+		*  \brief Reserves room in the index.
+		*
+		*  Grows the table so that _n half edges can be inserted without any further reallocation.
+		*
+		*  \param _n : number of half edges the index should be able to hold.
+		*
+		*  \return (void)
+		*/
+		void reserve ( int _n );
+
+		/*!
+		*  \brief Search a half edge in the index.
+		*
+		*  Search the half edge going from the _iTail vertex to the _iHead vertex.
+		*
+		*  \param _iTail : index of the tail vertex of the half edge.
+		*  \param _iHead : index of the head vertex of the half edge.
+		*
+		*  \return (int) Returns the index of the half edge if it is found, -1 else.
+		*/
+		int find ( int _iTail, int _iHead ) const;
+
+		/*!
+		*  \brief Adds a half edge to the index.
+		*
+		*  Adds the half edge going from the _iTail vertex to the _iHead vertex.
+		*  If such a half edge is already stored, the index is left untouched so that the first half edge inserted is the one found.
+		*
+		*  \param _iTail : index of the tail vertex of the half edge.
+		*  \param _iHead : index of the head vertex of the half edge.
+		*  \param _index : index of the half edge in the mesh.
+		*
+		*  \return (void)
+		*/
+		void insert ( int _iTail, int _iHead, int _index );
+};
+
+#endif
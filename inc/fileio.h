@@ -0,0 +1,369 @@
+#ifndef FILEIO_H
+#define FILEIO_H
+
+/**
+ * \file	fileio.h
+ * \brief	Declaration des classes d'acces aux fichiers utilisees par les chargeurs de la librairie.
+ */
+
+/* ____________________________ STD Librairies ___ */
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+using namespace std;
+
+class MappedFile
+{
+	/*!
+	 * \class MappedFile
+	 * \brief Classe représentant un fichier projete en memoire (mmap) et accessible en lecture seule.
+	 *
+	 * Le contenu du fichier est vu comme un simple tableau d'octets : les chargeurs le parcourent directement,
+	 * sans copie intermediaire ni flux. Sur les systemes qui n'offrent pas mmap, le fichier est lu en une seule fois dans un tampon.
+	 * Un MappedFile ne peut pas etre copie : il possede la projection et la libere a sa destruction.
+	 *
+	 */
+
+	private :
+		char*	data;			/*! <First byte of the file in memory, NULL if no file is opened or if the file is empty.*/
+		size_t	size;			/*! <Size of the file in bytes.*/
+		bool	mapped;			/*! <True if data is a projection of the file, false if it is a buffer allocated with malloc.*/
+
+		/*!
+		*  \brief Copy constructor of the MappedFile class.
+		*
+		*  A mapped file can not be copied : not implemented.
+		*/
+		MappedFile( const MappedFile& _f );
+
+		/*!
+		*  \brief Affectation operator of the MappedFile class.
+		*
+		*  A mapped file can not be copied : not implemented.
+		*/
+		MappedFile& operator= ( const MappedFile& _f );
+
+	public :
+		/*!
+		*  \brief Default constructor of the MappedFile class.
+		*
+		*  Default constructor of the MappedFile class : no file is opened.
+		*/
+		MappedFile();
+
+		/*!
+		*  \brief Destructor of the MappedFile class.
+		*
+		*  Destructor of the MappedFile class : the file is closed.
+		*/
+		~MappedFile();
+
+		/*!
+		*  \brief Opens a file.
+		*
+		*  Maps the whole file _path in memory. The previously opened file, if any, is closed.
+		*
+		*  \param _path : path of the file to open.
+		*
+		*  \return (int) Returns 1 if the operation succeded, -1 else.
+		*/
+		int open ( const char* _path );
+
+		/*!
+		*  \brief Closes the file.
+		*
+		*  Releases the projection of the file.
+		*
+		*  \return (void)
+		*/
+		void close ();
+
+		/*!
+		*  \brief Getter of the MappedFile class.
+		*
+		*  Getter of the MappedFile class.
+		*
+		*  \return (const char*) returns the first byte of the file.
+		*/
+		const char* getData () const;
+
+		/*!
+		*  \brief Getter of the MappedFile class.
+		*
+		*  Getter of the MappedFile class.
+		*
+		*  \return (size_t) returns the size of the file in bytes.
+		*/
+		size_t getSize () const;
+
+		/*!
+		*  \brief Checks the compression of the file.
+		*
+		*  \return (bool) returns true if the file begins with the magic number of the gzip format.
+		*/
+		bool isGzip () const;
+};
+
+class InputStream
+{
+	/*!
+	 * \class InputStream
+	 * \brief Classe représentant un fichier lu sequentiellement, decompresse a la volee s'il est au format gzip.
+	 *
+	 * Le format est detecte a l'ouverture (nombre magique gzip). Un fichier non compresse est lu directement.
+	 * Un fichier compresse est projete en memoire et decompresse (zlib) par un second thread dans une file de blocs bornee :
+	 * la decompression du bloc suivant se fait pendant que le lecteur traite le bloc courant, et la memoire utilisee ne depend pas de la taille du fichier.
+	 * Un InputStream ne peut pas etre copie.
+	 *
+	 */
+
+	private :
+		FILE*					file;		/*! <File read when it is not compressed, NULL else.*/
+		MappedFile				compressed;	/*! <Compressed file, read by the decompression thread.*/
+		bool					gzip;		/*! <True if the file is compressed.*/
+		thread					inflater;	/*! <Decompression thread.*/
+		mutex					lock;		/*! <Protects the queue and the flags shared with the decompression thread.*/
+		condition_variable		changed;	/*! <Signals a new block in the queue, a free place in the queue or the end of the reading.*/
+		deque< vector<char> >	ready;		/*! <Decompressed blocks not read yet.*/
+		vector<char>			current;	/*! <Block being read.*/
+		size_t					pos;		/*! <Position of the next byte to read in the current block.*/
+		bool					finished;	/*! <True once the decompression thread has produced its last block.*/
+		bool					stopping;	/*! <True if the reader asks the decompression thread to stop.*/
+		bool					failed;		/*! <True if a read error occured (or the compressed data is corrupted).*/
+
+		/*!
+		*  \brief Copy constructor of the InputStream class.
+		*
+		*  An input stream can not be copied : not implemented.
+		*/
+		InputStream( const InputStream& _s );
+
+		/*!
+		*  \brief Affectation operator of the InputStream class.
+		*
+		*  An input stream can not be copied : not implemented.
+		*/
+		InputStream& operator= ( const InputStream& _s );
+
+		/*!
+		*  \brief Body of the decompression thread.
+		*
+		*  Decompresses the whole file (every gzip member of it) into blocks pushed in the queue, waiting while the queue is full.
+		*
+		*  \return (void)
+		*/
+		void inflateAll ();
+
+	public :
+		/*!
+		*  \brief Default constructor of the InputStream class.
+		*
+		*  Default constructor of the InputStream class : no file is opened.
+		*/
+		InputStream();
+
+		/*!
+		*  \brief Destructor of the InputStream class.
+		*
+		*  Destructor of the InputStream class : the file is closed.
+		*/
+		~InputStream();
+
+		/*!
+		*  \brief Opens a file.
+		*
+		*  Opens the file _path and starts its decompression if it is compressed. The previously opened file, if any, is closed.
+		*
+		*  \param _path : path of the file to open.
+		*
+		*  \return (int) Returns 1 if the operation succeded, -1 else.
+		*/
+		int open ( const char* _path );
+
+		/*!
+		*  \brief Closes the file.
+		*
+		*  Stops the decompression (if any) and closes the file.
+		*
+		*  \return (void)
+		*/
+		void close ();
+
+		/*!
+		*  \brief Reads bytes.
+		*
+		*  Reads at most _size bytes of the (decompressed) content of the file.
+		*
+		*  \param _dst : where to write the bytes read.
+		*  \param _size : maximal number of bytes to read.
+		*
+		*  \return (size_t) returns the number of bytes read, 0 at the end of the file (or after an error, see hasFailed).
+		*/
+		size_t read ( char* _dst, size_t _size );
+
+		/*!
+		*  \brief Getter of the InputStream class.
+		*
+		*  Getter of the InputStream class.
+		*
+		*  \return (bool) returns true if the file is compressed.
+		*/
+		bool isCompressed () const;
+
+		/*!
+		*  \brief Getter of the InputStream class.
+		*
+		*  Getter of the InputStream class.
+		*
+		*  \return (bool) returns true if a read error occured or if the compressed data is corrupted.
+		*/
+		bool hasFailed ();
+};
+
+class FileWriter
+{
+	/*!
+	 * \class FileWriter
+	 * \brief Classe représentant un fichier ouvert en ecriture a travers un grand tampon.
+	 *
+	 * Les ecritures remplissent un tampon (1 Mo) qui n'est envoye au systeme que lorsqu'il est plein : un fichier est ecrit en quelques gros appels.
+	 * Les nombres sont formates directement dans le tampon, sans flux : les reels avec l'ecriture la plus courte qui les relit a l'identique (std::to_chars).
+	 * Un FileWriter ne peut pas etre copie.
+	 *
+	 */
+
+	private :
+		FILE*			file;			/*! <File written, NULL if no file is opened.*/
+		vector<char>	buffer;			/*! <Bytes waiting to be written.*/
+		size_t			used;			/*! <Number of bytes of the buffer waiting to be written.*/
+		bool			failed;			/*! <True if a write failed since the file was opened.*/
+
+		/*!
+		*  \brief Copy constructor of the FileWriter class.
+		*
+		*  A file writer can not be copied : not implemented.
+		*/
+		FileWriter( const FileWriter& _w );
+
+		/*!
+		*  \brief Affectation operator of the FileWriter class.
+		*
+		*  A file writer can not be copied : not implemented.
+		*/
+		FileWriter& operator= ( const FileWriter& _w );
+
+		/*!
+		*  \brief Makes room in the buffer.
+		*
+		*  Writes the buffer in the file if less than _n bytes are free.
+		*
+		*  \param _n : number of bytes needed.
+		*
+		*  \return (void)
+		*/
+		void reserve ( size_t _n );
+
+	public :
+		/*!
+		*  \brief Default constructor of the FileWriter class.
+		*
+		*  Default constructor of the FileWriter class : no file is opened.
+		*/
+		FileWriter();
+
+		/*!
+		*  \brief Destructor of the FileWriter class.
+		*
+		*  Destructor of the FileWriter class : the file is closed.
+		*/
+		~FileWriter();
+
+		/*!
+		*  \brief Opens a file.
+		*
+		*  Creates (or truncates) the file _path. The previously opened file, if any, is closed.
+		*
+		*  \param _path : path of the file to open.
+		*
+		*  \return (int) Returns 1 if the operation succeded, -1 else.
+		*/
+		int open ( const char* _path );
+
+		/*!
+		*  \brief Closes the file.
+		*
+		*  Writes what remains in the buffer and closes the file.
+		*
+		*  \return (int) Returns 1 if every write since the file was opened succeded, -1 else.
+		*/
+		int close ();
+
+		/*!
+		*  \brief Writes bytes.
+		*
+		*  \param _data : bytes to write.
+		*  \param _size : number of bytes to write.
+		*
+		*  \return (void)
+		*/
+		void write ( const void* _data, size_t _size );
+
+		/*!
+		*  \brief Writes a string.
+		*
+		*  \param _text : null terminated string to write.
+		*
+		*  \return (void)
+		*/
+		void writeText ( const char* _text );
+
+		/*!
+		*  \brief Writes a character.
+		*
+		*  \param _c : character to write.
+		*
+		*  \return (void)
+		*/
+		void writeChar ( char _c );
+
+		/*!
+		*  \brief Writes an integer in decimal.
+		*
+		*  \param _i : integer to write.
+		*
+		*  \return (void)
+		*/
+		void writeInt ( long long _i );
+
+		/*!
+		*  \brief Writes a real number in decimal.
+		*
+		*  Writes _x with the fewest digits that read back to the same value.
+		*  A value that is exactly a float (the loaders of the library round the coordinates to floats) is written with the fewest digits of the float :
+		*  0.1f is written "0.1" and not "0.10000000149011612".
+		*
+		*  \param _x : real number to write.
+		*
+		*  \return (void)
+		*/
+		void writeReal ( double _x );
+
+		/*!
+		*  \brief Writes a double in decimal.
+		*
+		*  Writes _x with the fewest digits that read back to the same double, without the shortcut of writeReal for the values that are floats :
+		*  for the files whose values are read back as doubles.
+		*
+		*  \param _x : double to write.
+		*
+		*  \return (void)
+		*/
+		void writeDouble ( double _x );
+};
+
+#endif
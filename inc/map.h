@@ -6,7 +6,13 @@
  * \brief	Declaration de la classe Map representant une carte de feature (double) attachee a un maillage.
  */
 
+/* ______________________________ My includes ____ */
+#include "fileio.h"
+#include "range.h"
+
+/* ____________________________ STD Librairies ___ */
 #include <vector>
+#include <memory>
 
 using namespace std;
 
@@ -17,13 +23,29 @@ class Map
 	 * \brief Classe représentant une carte de feature (double) attachee a un maillage.
 	 * 
 	 * Elle sera caracterisee par ses valeurs extreme et un tableau de donnees.
+	 * Une carte chargee depuis un fichier binaire (voir loadBinary) lit ses valeurs directement dans le fichier projete en memoire,
+	 * partage entre ses copies : elles ne sont recopiees dans le tableau de donnees qu'a la premiere modification.
 	 *
 	 */
 	
 	private :
 		double			min;					/*! <Value of the lowest feature of the map.*/
 		double			max;					/*! <Value of the highest feature if the map.*/
-		vector<double>	data;					/*! <Value of the feature for each vertex of the mesh t represents.*/
+		vector<double>	data;					/*! <Value of the feature for each vertex of the mesh t represents (empty while the map is mapped).*/
+		
+		shared_ptr<MappedFile>	mapping;		/*! <Binary file whose values are used in place, NULL if the values are in the data array.*/
+		const double*			mapped;			/*! <First value in the mapped file.*/
+		size_t					nMapped;		/*! <Number of values in the mapped file.*/
+		
+		/*!
+		*  \brief Releases the mapped file.
+		*
+		*  Copies the values of the mapped file in the data array and releases the file (if the map is mapped) :
+		*  called before any change of the values.
+		*
+		*  \return (void)
+		*/
+		void unmap ();
 		
 	public:
 		/*!
@@ -61,7 +83,7 @@ class Map
 		*
 		*  \return (double) returns the minimum value of the map.
 		*/
-		double getMin ();
+		double getMin () const;
 		
 		/*!
 		*  \brief Getter of the Map class.
@@ -70,7 +92,7 @@ class Map
 		*
 		*  \return (double) returns the maximum value of the map.
 		*/
-		double getMax ();
+		double getMax () const;
 		
 		/*!
 		*  \brief Getter of the Map class.
@@ -81,6 +103,16 @@ class Map
 		*/
 		vector<double> getData ();
 		
+		/*!
+		*  \brief Getter of the Map class.
+		*
+		*  Getter of the Map class, nothing is copied (the values may be in the mapped file) : to be prefered to getData.
+		*  The view is valid until the map is changed or destroyed.
+		*
+		*  \return (ArrayView<double>) returns a view on the features of the map.
+		*/
+		ArrayView<double> getDataView () const;
+		
 		/*!
 		*  \brief Getter of the Map class.
 		*
@@ -88,7 +120,7 @@ class Map
 		*
 		*  \return (double) returns the value of the ith feature in the map.
 		*/
-		double getIData ( int _i );
+		double getIData ( int _i ) const;
 		
 		/*!
 		*  \brief Getter of the Map class.
@@ -97,7 +129,7 @@ class Map
 		*
 		*  \return (int) returns the number of values in the data array.
 		*/
-		int getSize ();
+		int getSize () const;
 		
 		/*!
 		*  \brief Setter of the Map class.
@@ -174,6 +206,7 @@ class Map
 		*  So, usually there is one value per line in the file but the end-line-caracter can be suppressed 
 		*  and the values all printed in a single line.
 		*  The map files should not content any comments.
+		*  A gzip compressed file (".map.gz") is detected and decompressed on the fly by a second thread, while the part already decompressed is read.
 		*
 		* \param _path : path to the file where the map is stored.
 		*
@@ -181,10 +214,37 @@ class Map
 		*/
 		int load ( char* _path );
 		
+		/*!
+		*  \brief Loads a binary map.
+		*
+		*  Loads a map saved by saveBinary. The file is mapped in memory and its values are used in place :
+		*  loading costs the same whatever the size of the map, the values being read from the disk when they are used.
+		*  Unlike load, the map is not expanded : it is exactly the map which was saved, min and max included.
+		*  The file must have been saved by a computer with the same byte order.
+		*
+		* \param _path : path to the file where the map is stored.
+		*
+		*  \return (int) Returns 1 if the operation succeded, -1 else.
+		*/
+		int loadBinary ( char* _path );
+		
+		/*!
+		*  \brief Saves a map into a binary file.
+		*
+		*  Saves a map into a binary ".smlm" file : a 48 bytes header (magic "SMLM", version, byte order, size, min and max)
+		*  followed by the values as a contiguous array of doubles, in the byte order of the computer. See loadBinary.
+		*
+		* \param _path : path to the file where the map is going to be saved.
+		*
+		*  \return (int) Returns 1 if the operation succeded, -1 else.
+		*/
+		int saveBinary ( char* _path );
+		
 		/*!
 		*  \brief Saves a map into a file.
 		*
-		*  Saves a map into a given file.
+		*  Saves a map into a given file, one value per line.
+		*  The file is written through a large buffer and the values with the fewest digits that read back to the same double (see FileWriter::writeDouble) : loading the file gives back the same map.
 		*
 		* \param _path : path to the file where the map is going to be saved.
 		*
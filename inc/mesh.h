@@ -8,11 +8,18 @@
 
 /* ______________________________ My includes ____ */
 #include "define.h"
+#include "circulator.h"
+#include "range.h"
+#include "property.h"
 #include "tools.h"
 #include "map.h"
+#include "edgeindex.h"
+#include "progress.h"
 
 /* ____________________________ STD Librairies ___ */
 #include <vector>
+#include <memory>
+#include <atomic>
 
 /* ___________________ GLUT & OpenGL Librairies __ */
 #ifdef __APPLE__
@@ -52,10 +59,74 @@
  */
 #define SMOOTH 3
 
+/*! \def REORDER_MORTON
+  reorder policy : the vertices and the faces are sorted by the Morton code (Z-order) of their position (of their center for the faces).
+ */
+#define REORDER_MORTON 0
+
+/*! \def REORDER_HILBERT
+  reorder policy : the vertices and the faces are sorted by the Hilbert code of their position (of their center for the faces).
+ */
+#define REORDER_HILBERT 1
+
+/*! \def REORDER_RCM
+  reorder policy : the vertices are numbered by a breadth first search of the mesh (reverse Cuthill-McKee order), the faces follow their first vertex.
+ */
+#define REORDER_RCM 2
+
+/*! \def NORMALS_UNIFORM
+  normals weighting : the normal of a vertex is the mean of the normals of its faces.
+ */
+#define NORMALS_UNIFORM 0
+
+/*! \def NORMALS_AREA
+  normals weighting : the normals of the faces of a vertex are weighted by the area of the faces (the big faces count more than the small ones).
+ */
+#define NORMALS_AREA 1
+
+/*! \def NORMALS_ANGLE
+  normals weighting : the normals of the faces of a vertex are weighted by the angle of the faces at the vertex (the result does not depend on the way the faces are split).
+ */
+#define NORMALS_ANGLE 2
+
 /* ************************************************************************************ */
 /* ************************************************************************************ */
 
 
+/*!
+ * \struct MeshTopology
+ * \brief Connectivite d'un maillage : les tableaux d'entiers de sa structure de demi-aretes.
+ *
+ * Ces tableaux ne changent que quand des elements sont ajoutes (ou quand le maillage est charge, vide, ...) :
+ * les copies d'un maillage les partagent, et seule celle qui les change en fait sa propre copie (copie sur ecriture).
+ */
+struct MeshTopology
+{
+	vector<int>		vertEdge;		/*! <First half edge starting from each vertex, -1 for an isolated vertex.*/
+	vector<int>		vertLastEdge;	/*! <Last half edge starting from each vertex, where the next one is linked.*/
+	
+	vector<int>		heHead;			/*! <Head vertex of each half edge (its tail is the head of its twin).*/
+	vector<int>		heTwin;			/*! <Twin of each half edge.*/
+	vector<int>		heNext;			/*! <Half edge following each half edge in the loop of its face, -1 for a half edge without face.*/
+	vector<int>		hePrev;			/*! <Half edge preceding each half edge in the loop of its face, -1 for a half edge without face.*/
+	vector<int>		heFace;			/*! <First face of each half edge, -1 for a half edge of the border.*/
+	vector<int>		heNextOut;		/*! <Next half edge starting from the same vertex, -1 for the last one.*/
+	vector<int>		heExtra;		/*! <First of the other faces of each half edge in the extra lists, -1 if it has only one face.*/
+	vector<int>		extraFace;		/*! <Faces of the extra lists.*/
+	vector<int>		extraNext;		/*! <Next item of each extra list, -1 for the last one.*/
+	
+	vector<int>		faceStart;		/*! <Index in faceEdges of the first half edge of each face, plus the total number of half edges of the loops (nFaces+1 values).*/
+	vector<int>		faceEdges;		/*! <Half edges of the loops of the faces, [v0, v1], [v1, v2], ..., [vn-1, v0] for each face.*/
+	int				nNonTriangles;	/*! <Number of faces which are not triangles : if there is none, the loop of the face i is faceEdges[3*i] to faceEdges[3*i+2].*/
+	
+	/*!
+	*  \brief Default constructor of the MeshTopology structure.
+	*
+	*  Default constructor of the MeshTopology structure : no element.
+	*/
+	MeshTopology() : faceStart( 1, 0 ), nNonTriangles( 0 ) {}
+};
+
 class Mesh
 {
 	/*!
@@ -63,28 +134,258 @@ class Mesh
 	 * \brief Classe représentant un maillage grace a une structure de demi aretes.
 	 * 
 	 * Un maillage est represente par ses principales caracteristiques : son nombre de sommets, d'aretes et de faces.
-	 * Ainsi que trois vectors (pour des raisons de simplicite nous avons choisi d'utiliser des vectors et non des tableaux alloues dynamiquement)
-	 * donnant la liste exhaustive de tous ces sommets, demi-aretes et faces du maillage.
+	 * Ses donnees sont rangees dans des tableaux contigus (structure de tableaux) indexes par les identifiants des elements :
+	 * positions, normales et couleurs des sommets (trois Real par sommet : double, ou float avec SML_FLOAT), normales des faces, et la connectivite sous forme
+	 * de tableaux d'entiers : tete, jumelle, suivante et face de chaque demi-arete, contour de chaque face (tableau compresse),
+	 * liste chainee des demi-aretes partant de chaque sommet. Les classes Vertex, Edge et Face ne sont que des poignees sur ces tableaux.
+	 * Les deux demi-aretes d'une arete sont toujours creees ensemble. Une demi-arete partagee par plus d'une face (maillage non manifold)
+	 * garde ses autres faces dans une liste a part.
+	 * La connectivite (MeshTopology) est partagee entre les copies d'un maillage tant qu'aucune ne la change : copier un maillage
+	 * ne copie que ses positions, normales, couleurs et proprietes, qui peuvent etre changees a travers des pointeurs. clone() copie tout.
+	 * Des proprietes typees et nommees (Property) peuvent etre ajoutees aux sommets, aux demi-aretes et aux faces : ce sont d'autres tableaux
+	 * indexes par les identifiants, agrandis avec ceux du maillage.
 	 * On attribue aussi a chaque maillage un identifiant qu'il sera preferable de garder unique pour chaque objet.
 	 *
+	 * La boite englobante des sommets est gardee en cache : elle n'est calculee a nouveau qu'apres un deplacement ou un ajout de sommet.
+	 *
 	 * \todo Des ameliorations peuvent etre apportes a cette classe, notamment des methodes-outils qui n'existent pas encore,
-	 *  l'ajout d'un attribut de type boumding box ainsi que les methodes qui vont avec (accesseurs/modificateurs, boite a outils, ...)
 	 *	le passage des accesseurs/modificateurs en inline...
 	 *
 	 */
 	
+	friend class Vertex;
+	friend class Edge;
+	friend class Face;
+	friend class VertexEdgeCirculator;
+	friend class VertexVertexCirculator;
+	friend class VertexFaceCirculator;
+	friend class EdgeFaceCirculator;
+	friend class FaceEdgeCirculator;
+	friend class FaceFaceCirculator;
+	
 	private :
 	/* Les 3 entiers nVerts, nEdges et nFaces pourraient etre supprimes et remplaces par de appels a la methode size() de la classe vector */
-			
-		int				id;			/*! <ID of the mesh.*/
+		int				id;				/*! <ID of the mesh.*/
 	
-		int				nVerts;		/*! <Number of vertex composing the mesh.*/
-		int				nEdges;		/*! <Number of half edges composing the mesh.*/
-		int				nFaces;		/*! <Number of faces composing the mesh.*/
+		int				nVerts;			/*! <Number of vertex composing the mesh.*/
+		int				nEdges;			/*! <Number of half edges composing the mesh.*/
+		int				nFaces;			/*! <Number of faces composing the mesh.*/
+		
+		vector<Real>	positions;		/*! <Location of the vertices, three values per vertex.*/
+		vector<Real>	normals;		/*! <Normals of the vertices, three values per vertex.*/
+		vector<Real>	colors;			/*! <Colors of the vertices, three values per vertex.*/
+		vector<Real>	faceNormals;	/*! <Normals of the faces, three values per face.*/
+		
+		shared_ptr<MeshTopology>	topo;	/*! <Connectivity of the mesh, shared with its copies until one of them changes it (never NULL).*/
+		
+		EdgeIndex		edgeIndex;		/*! <Hash index of the half edges keyed on their (tail, head) vertex IDs, gives containsEdge in constant time.*/
+		bool			edgeIndexValid;	/*! <False if the edge index has to be rebuilt before being used (after a parallel load).*/
+		
+		PropertySet		vertProps;		/*! <Properties of the vertices.*/
+		PropertySet		edgeProps;		/*! <Properties of the half edges.*/
+		PropertySet		faceProps;		/*! <Properties of the faces.*/
+		
+		bool			normalsValid;		/*! <True if the normals were computed and only the vertices of movedFlags were moved since, false if they all have to be computed again.*/
+		int				normalsWeighting;	/*! <Weighting given to the last computeNormals, used by refreshNormals.*/
+		vector<char>	movedFlags;			/*! <1 for the vertices moved since the normals were computed, 0 for the other ones (one value per vertex while normalsValid).*/
+		
+		Vector3D		boxBot;			/*! <Bottom corner of the bounding box of the vertices, if boxValid.*/
+		Vector3D		boxTop;			/*! <Top corner of the bounding box of the vertices, if boxValid.*/
+		atomic<bool>	boxValid;		/*! <False if the bounding box has to be computed again before being used (a vertex was moved or added), atomic as several threads can move vertices.*/
+		
+		/*!
+		*  \brief Getter of the Mesh class.
+		*
+		*  \param _element : type of the elements (VERTICES, EDGES or FACES).
+		*
+		*  \return (PropertySet*) returns the properties of the elements, NULL if _element is not a type of elements.
+		*/
+		PropertySet* getPropertySet ( int _element );
+		
+		/*!
+		*  \brief Resizes the properties.
+		*
+		*  Resizes the properties of the vertices, half edges and faces to the number of elements of the mesh (after it was built or loaded).
+		*
+		*  \return (void)
+		*/
+		void resizeProperties ();
+		
+		/*!
+		*  \brief Color each vertex of the mesh according to its value.
+		*
+		*  \param _values : one value per vertex.
+		*  \param _min : minimum of the values.
+		*  \param _max : maximum of the values.
+		*
+		*  \return (void)
+		*/
+		void colorFromValues ( ArrayView<double> _values, double _min, double _max );
+		
+		/*!
+		*  \brief Makes the connectivity of the mesh its own.
+		*
+		*  Copies the connectivity if it is shared with another mesh : to be called before changing it.
+		*
+		*  \return (void)
+		*/
+		void unshare ();
+		
+		/*!
+		*  \brief Rebuilds the edge index.
+		*
+		*  Rebuilds the edge index of the mesh from its half edge arrays.
+		*
+		*  \return (void)
+		*/
+		void indexEdges ();
+		
+		/*!
+		*  \brief Creates a pair of half edges.
+		*
+		*  Creates the half edge [_iTail, _iHead] and its twin (IDs nEdges and nEdges+1), adds them to the edge lists of their tail vertices
+		*  and to the edge index (if it is valid).
+		*
+		*  \param _iTail : index of the tail vertex of the half edge.
+		*  \param _iHead : index of the head vertex of the half edge.
+		*
+		*  \return (int) returns the ID of the half edge [_iTail, _iHead].
+		*/
+		int addEdgePair ( int _iTail, int _iHead );
+		
+		/*!
+		*  \brief Adds a face to a half edge.
+		*
+		*  Makes _f the face of the half edge _e if it has none, adds it to the extra list of _e else.
+		*
+		*  \param _e : ID of the half edge.
+		*  \param _f : ID of the face.
+		*
+		*  \return (void)
+		*/
+		void addEdgeFace ( int _e, int _f );
+		
+		/*!
+		*  \brief Links the loop of a face.
+		*
+		*  Sets the next and previous half edges of the half edges whose first face is _f, from the loop of _f.
+		*
+		*  \param _f : ID of the face.
+		*
+		*  \return (void)
+		*/
+		void linkFace ( int _f );
+		
+		/*!
+		*  \brief Counts the faces which are not triangles.
+		*
+		*  Sets the number of faces which are not triangles from the loops of the faces (after they were built or loaded).
+		*
+		*  \return (void)
+		*/
+		void countNonTriangles ();
+		
+		/*!
+		*  \brief Computes the cross product of a face.
+		*
+		*  Computes the cross product of the two first edges of the face if it is a triangle, the sum of Newell of its edges else :
+		*  its direction is the normal of the face and its length is twice the area of the face.
+		*
+		*  \param _f : ID of the face.
+		*  \param _n : array of three values where the cross product is written.
+		*
+		*  \return (void)
+		*/
+		void faceCross ( int _f, double* _n );
+		
+		/*!
+		*  \brief Computes an angle of a face.
+		*
+		*  \param _f : ID of the face.
+		*  \param _j : index of a half edge in the loop of the face.
+		*
+		*  \return (double) returns the angle of the face at the tail of its jth half edge, in radians.
+		*/
+		double cornerAngle ( int _f, int _j );
+		
+		/*!
+		*  \brief Computes the weight of a face in the normal of a vertex.
+		*
+		*  \param _weighting : NORMALS_AREA or NORMALS_ANGLE.
+		*  \param _e : ID of a half edge of the face, leaving the vertex.
+		*  \param _f : ID of the face.
+		*
+		*  \return (double) returns the area of the face, or its angle at the tail of _e, as computeNormals computes them.
+		*/
+		double faceWeight ( int _weighting, int _e, int _f );
+		
+		/*!
+		*  \brief Computes the normal of a vertex.
+		*
+		*  Computes the normal of a vertex from the normals of its faces, weighted as asked. The weights are read in the arrays if they are given,
+		*  computed from the positions else (as computeNormals computes them).
+		*
+		*  \param _v : ID of the vertex.
+		*  \param _weighting : NORMALS_UNIFORM, NORMALS_AREA or NORMALS_ANGLE.
+		*  \param _faceWeight : area of each face (NORMALS_AREA), or NULL.
+		*  \param _edgeWeight : angle of the first face of each half edge at its tail (NORMALS_ANGLE), or NULL.
+		*  \param _extraWeight : angle of the face of each item of the extra lists at the tail of its half edge (NORMALS_ANGLE), or NULL.
+		*
+		*  \return (void)
+		*/
+		void vertexNormal ( int _v, int _weighting, const double* _faceWeight, const double* _edgeWeight, const double* _extraWeight );
 		
-		vector<Vertex*>	verts;		/*! <Vector (array) of pointer to all the vertices componong the mesh.*/
-		vector<Edge*>	edges;		/*! <Vector (array) of pointer to all the half edges componong the mesh.*/
-		vector<Face*>	faces;		/*! <Vector (array) of pointer to all the faces componong the mesh.*/
+		/*!
+		*  \brief Renumbers the elements of the mesh.
+		*
+		*  Moves the vertices and the faces to their new IDs, with their attributes and properties, and renumbers the half edges in the order of the loops
+		*  of the faces (the two half edges of an edge keep following each other). Every reference to an element is updated.
+		*
+		*  \param _vertOrder : for each new ID of vertex, the old ID of the vertex.
+		*  \param _faceOrder : for each new ID of face, the old ID of the face.
+		*
+		*  \return (void)
+		*/
+		void permute ( const vector<int>& _vertOrder, const vector<int>& _faceOrder );
+		
+		/*!
+		*  \brief Builds the mesh from arrays.
+		*
+		*  Clears the mesh and builds its vertices, half edges and faces from flat arrays :
+		*  the face i is the polygon of the vertices _indices[_faceStarts[i]] to _indices[_faceStarts[i+1]-1].
+		*  The half edges are created in the order of the faces, exactly as a loader reading the faces one after another would do.
+		*
+		*  \param _nVerts : number of vertices.
+		*  \param _positions : location of the vertices, three values per vertex.
+		*  \param _nFaces : number of faces.
+		*  \param _faceStarts : index of the first vertex of each face in the _indices array, plus the total number of indices (_nFaces+1 values).
+		*  \param _indices : index (from 0) of the vertices of the faces.
+		*  \param _progress : if not NULL, the number of faces built is reported in it and the build stops if it is cancelled.
+		*
+		*  \return (int) returns -1 if a face refers to a vertex that does not exist or if the build is cancelled (the mesh is then left empty), 1 else.
+		*/
+		int build ( int _nVerts, const double* _positions, int _nFaces, const int* _faceStarts, const int* _indices, LoadProgress* _progress = NULL );
+		
+		/*!
+		*  \brief Builds the mesh from arrays with several threads.
+		*
+		*  Does exactly what the build method does (the mesh built is the same, IDs included) but with several threads :
+		*  the corners of the faces are dispatched in buckets according to their edge, each bucket finds the first corner of each of its edges
+		*  (the one which creates the half edges in a serial build), the half edges are numbered in the order of these first corners
+		*  and every array of the mesh is then filled in parallel.
+		*  The edge index is not filled : it is rebuilt the first time it is needed.
+		*
+		*  \param _nVerts : number of vertices.
+		*  \param _positions : location of the vertices, three values per vertex.
+		*  \param _nFaces : number of faces.
+		*  \param _faceStarts : index of the first vertex of each face in the _indices array, plus the total number of indices (_nFaces+1 values).
+		*  \param _indices : index (from 0) of the vertices of the faces.
+		*  \param _nThreads : number of threads to use.
+		*  \param _progress : if not NULL, the build stops if it is cancelled before the half edges are created.
+		*
+		*  \return (int) returns -1 if a face refers to a vertex that does not exist or if the build is cancelled (the mesh is then left empty), 1 else.
+		*/
+		int buildParallel ( int _nVerts, const double* _positions, int _nFaces, const int* _faceStarts, const int* _indices, int _nThreads, LoadProgress* _progress = NULL );
 		
 	public:
 		/*!
@@ -97,10 +398,17 @@ class Mesh
 		/*!
 		*  \brief Copy constructor of the Mesh class.
 		*
-		*  Copy constructor of the Mesh class.
+		*  Copy constructor of the Mesh class : the connectivity is shared with _m until one of them changes it, the rest is copied.
 		*/
 		Mesh( const Mesh& _m );
 		
+		/*!
+		*  \brief Move constructor of the Mesh class.
+		*
+		*  Move constructor of the Mesh class : the arrays of _m are taken without being copied, _m is left empty.
+		*/
+		Mesh( Mesh&& _m );
+		
 		/*!
 		*  \brief Destructor of the Mesh class.
 		*
@@ -111,10 +419,27 @@ class Mesh
 		/*!
 		*  \brief Affectation operator of the Mesh class.
 		*
-		*  Affectation operator of the Mesh class.
+		*  Affectation operator of the Mesh class : the connectivity is shared with _m until one of them changes it, the rest is copied.
 		*/
 		Mesh& operator= ( const Mesh& _m );
 		
+		/*!
+		*  \brief Move affectation operator of the Mesh class.
+		*
+		*  Move affectation operator of the Mesh class : the arrays of _m are taken without being copied, _m is left empty.
+		*/
+		Mesh& operator= ( Mesh&& _m );
+		
+		/*!
+		*  \brief Copies the mesh.
+		*
+		*  Copies the mesh, connectivity included : the copy shares nothing with the mesh (to be given to another thread, for example).
+		*  The arrays are copied as they are, the IDs of the elements are the same in the copy.
+		*
+		*  \return (Mesh) returns the copy of the mesh.
+		*/
+		Mesh clone ();
+		
 		/*!
 		*  \brief Getter of the Mesh class.
 		*
@@ -156,9 +481,18 @@ class Mesh
 		*
 		*  Getter of the Mesh class.
 		*
-		*  \return (vector<Vertex*>) returns an array containing a pointer to each vertex componing the mesh.
+		*  \return (vector<Vertex>) returns an array containing each vertex componing the mesh.
 		*/
-		vector<Vertex*> getVerts ();
+		vector<Vertex> getVerts ();
+		
+		/*!
+		*  \brief Getter of the Mesh class.
+		*
+		*  Getter of the Mesh class, nothing is copied : to be prefered to getVerts in the loops.
+		*
+		*  \return (IndexRange<Vertex>) returns the range of the vertices of the mesh.
+		*/
+		IndexRange<Vertex> getVertRange ();
 		
 		/*!
 		*  \brief Getter of the Mesh class.
@@ -167,18 +501,27 @@ class Mesh
 		*
 		*  \param _i : index of the vertex we want to be returned.
 		*
-		*  \return (Vertex*) returns a pointer to the ith vertex of the mesh.
+		*  \return (Vertex) returns the ith vertex of the mesh.
 		*/
-		Vertex*	getIVert ( int _i );
+		Vertex	getIVert ( int _i );
 		
 		/*!
 		*  \brief Getter of the Mesh class.
 		*
 		*  Getter of the Mesh class.
 		*
-		*  \return (vector<Edge*>) returns an array containing a pointer to each half edge componing the mesh.
+		*  \return (vector<Edge>) returns an array containing each half edge componing the mesh.
 		*/
-		vector<Edge*> getEdges ();
+		vector<Edge> getEdges ();
+		
+		/*!
+		*  \brief Getter of the Mesh class.
+		*
+		*  Getter of the Mesh class, nothing is copied : to be prefered to getEdges in the loops.
+		*
+		*  \return (IndexRange<Edge>) returns the range of the half edges of the mesh.
+		*/
+		IndexRange<Edge> getEdgeRange ();
 		
 		/*!
 		*  \brief Getter of the Mesh class.
@@ -187,109 +530,120 @@ class Mesh
 		*
 		*  \param _i : index of the edge we want to be returned.
 		*
-		*  \return (Edge*) returns the ith edge of the mesh;
+		*  \return (Edge) returns the ith edge of the mesh;
 		*/
-		Edge* getIEdge ( int _i );
+		Edge getIEdge ( int _i );
 		
 		/*!
 		*  \brief Getter of the Mesh class.
 		*
 		*  Getter of the Mesh class.
 		*
-		*  \return (vector<Face*>) returns an array containing a pointer to each face componing the mesh.
+		*  \return (vector<Face>) returns an array containing each face componing the mesh.
 		*/
-		vector<Face*> getFaces ();
-	
+		vector<Face> getFaces ();
+		
 		/*!
-		*  \brief Setter of the Mesh class.
-		*
-		*  Setter of the Mesh class.
+		*  \brief Getter of the Mesh class.
 		*
-		*  \param _ID : ID to affect to the mesh.
+		*  Getter of the Mesh class, nothing is copied : to be prefered to getFaces in the loops.
 		*
-		*  \return (void)
+		*  \return (IndexRange<Face>) returns the range of the faces of the mesh.
 		*/
-		void setID ( int _ID );
+		IndexRange<Face> getFaceRange ();
 		
 		/*!
-		*  \brief Setter of the Mesh class.
+		*  \brief Getter of the Mesh class.
 		*
-		*  Setter of the Mesh class.
+		*  Getter of the Mesh class.
 		*
-		*  \param _nVerts : number of vertices in the mesh.
+		*  \param _i : index of the face we want to be returned.
 		*
-		*  \return (void)
+		*  \return (Face) returns the ith face of the mesh;
 		*/
-		void setNVerts ( int _nVerts );
+		Face getIFace ( int _i );
 		
 		/*!
-		*  \brief Setter of the Mesh class.
-		*
-		*  Setter of the Mesh class.
+		*  \brief Getter of the Mesh class.
 		*
-		*  \param _nEdges : numer of edges in the mesh.
+		*  Getter of the Mesh class, nothing is copied : the values can be given as they are to OpenGL (glVertexPointer, ...) or to other libraries.
+		*  The view is valid until an element is added to the mesh or the mesh is cleared.
 		*
-		*  \return (void)
+		*  \return (ArrayView<Real>) returns the locations of the vertices, three values per vertex.
 		*/
-		void setNEdges ( int _nEdges );
+		ArrayView<Real> getPositions ();
 		
 		/*!
-		*  \brief Setter of the Mesh class.
-		*
-		*  Setter of the Mesh class.
+		*  \brief Getter of the Mesh class.
 		*
-		*  \param _nFaces : number of faces in the mesh.
+		*  Getter of the Mesh class, nothing is copied : the values can be given as they are to OpenGL (glVertexPointer, ...) or to other libraries.
+		*  The view is valid until an element is added to the mesh or the mesh is cleared.
 		*
-		*  \return (void)
+		*  \return (ArrayView<Real>) returns the normals of the vertices, three values per vertex.
 		*/
-		void setNFaces ( int _nFaces );
+		ArrayView<Real> getNormals ();
 		
 		/*!
-		*  \brief Setter of the Mesh class.
-		*
-		*  Setter of the Mesh class.
+		*  \brief Getter of the Mesh class.
 		*
-		*  \param _verts : array containing a pointer on each vertex of the mesh.
+		*  Getter of the Mesh class, nothing is copied : the values can be given as they are to OpenGL (glVertexPointer, ...) or to other libraries.
+		*  The view is valid until an element is added to the mesh or the mesh is cleared.
 		*
-		*  \return (void)
+		*  \return (ArrayView<Real>) returns the colors of the vertices, three values per vertex.
 		*/
-		void setVerts ( vector<Vertex*> _verts );
+		ArrayView<Real> getColors ();
 		
 		/*!
-		*  \brief Setter of the Mesh class.
-		*
-		*  Setter of the Mesh class.
+		*  \brief Getter of the Mesh class.
 		*
-		*  \param _edges : array containing a pointer on each half edge of the mesh.
+		*  Getter of the Mesh class, nothing is copied : the values can be given as they are to OpenGL (glVertexPointer, ...) or to other libraries.
+		*  The view is valid until an element is added to the mesh or the mesh is cleared.
 		*
-		*  \return (void)
+		*  \return (ArrayView<Real>) returns the normals of the faces, three values per face.
 		*/
-		void setEdges ( vector<Edge*> _edges );
-		
+		ArrayView<Real> getFaceNormals ();
+	
 		/*!
 		*  \brief Setter of the Mesh class.
 		*
 		*  Setter of the Mesh class.
 		*
-		*  \param _faces : array containing a pointer on each face of the mesh.
+		*  \param _ID : ID to affect to the mesh.
 		*
 		*  \return (void)
 		*/
-		void setFaces ( vector<Face*> _faces );
+		void setID ( int _ID );
 		
 		/*!
 		*  \brief Clears the mesh informations.
 		*
 		*  All attributes will be set to 0 (int, float, double, ...), NULL (pointers) or cleared (lists, vectors, stacks, ...).
+		*  The memory of the arrays is given back : clearing or reloading a mesh does not keep the memory of the previous one.
 		*
 		*  \return (void)
 		*/
 		void clear ();
 		
+		/*!
+		*  \brief Reserves the memory of the mesh.
+		*
+		*  Allocates the arrays of the mesh once for the given number of elements, so that adding them with addVertex and addFace
+		*  does not reallocate the arrays. The half edges are estimated from the face indices, as the loaders do.
+		*
+		*  \param _nVerts : number of vertices the mesh will have.
+		*  \param _nFaces : number of faces the mesh will have.
+		*  \param _nIndices : sum of the numbers of vertices of the faces.
+		*
+		*  \return (void)
+		*/
+		void reserve ( int _nVerts, int _nFaces, int _nIndices );
+		
 		/*!
 		*  \brief Search an edge in the edges vector of the mesh.
 		*
 		*  Search an edge defined by its two vertices in the edges vector of the mesh.
+		*  The search goes through the edge index of the mesh and is done in constant time
+		*  (after a parallel load, the first search rebuilds the index).
 		*
 		*  \param _iTail : index of the tail vertex of the half edge.
 		*  \param _iHead : index of the head vertex of the half edge.
@@ -301,96 +655,265 @@ class Mesh
 		/*!
 		*  \brief Adds a vertex to the mesh.
 		*
-		*  Adds a pointer on a vertex to the vertex vector of the mesh and updates the nVerts attribute;
+		*  Adds a vertex (with a null normal and a black color) to the mesh and updates the nVerts attribute;
 		*
-		*  \param _v : pointer on the vertex to add;
+		*  \param _pos : location of the vertex;
 		*
-		*  \return (void)
+		*  \return (Vertex) returns the new vertex.
 		*/
-		void addVertex ( Vertex* _v );
+		Vertex addVertex ( Vector3D _pos );
 		
 		/*!
-		*  \brief Adds an edge to the edge vector of a vertex.
+		*  \brief Adds a face to the mesh.
 		*
-		*  Adds an edge to the edge vector of the vertex ith.
+		*  Adds the polygon of the vertices _loop to the mesh and updates the nFaces attribute :
+		*  the half edges [v0, v1], [v1, v2], ..., [vn-1, v0] that do not exist yet are created with their twins.
 		*
-		*  \param _i : index of the vertex we want to add the edge.
-		*  \param _e : pointer on the edge we want to add.
+		*  \param _loop : indices of the vertices of the face.
 		*
-		*  \return (void)
+		*  \return (Face) returns the new face, an invalid face if _loop is empty or refers to a vertex that does not exist.
 		*/
-		void addEdgeToIVertex ( int _i, Edge* _e );
+		Face addFace ( const vector<int>& _loop );
 		
 		/*!
-		*  \brief Adds an edge to the mesh.
+		*  \brief Loads a wavefront ".obj" mesh.
 		*
-		*  Adds a pointer on a edge to the edge vector of the mesh and updates the nEdges attribute;
+		*  Loads a wavefront ".obj" mesh from the _path file.
+		*  The file is mapped in memory and parsed in place : no stream, no locale and no allocation per line.
+		*  Only the vertex ("v") and face ("f") lines are used, the other ones (comments, normals, textures, groups, ...) are skipped.
+		*  The faces can be polygons of any size, their vertices can be given with their texture/normal indices ("f 1/1/1 2/2/2 3/3/3")
+		*  and with relative (negative) indices.
+		*  For OBJ format spec., see http://en.wikipedia.org/wiki/Wavefront_.obj_file.
 		*
-		*  \param _e : pointer on the edge to add;
+		*  With several threads, the file is split into chunks at line boundaries, the chunks are parsed in parallel, merged
+		*  and the mesh is built in parallel (see buildParallel) : the mesh is the same as the one loaded with a single thread.
 		*
-		*  \return (void)
+		*  A gzip compressed file (".obj.gz") is detected and decompressed on the fly by a second thread, while the part already decompressed is parsed
+		*  (see InputStream) : it is parsed serially, the threads are then only used to build the mesh.
+		*
+		*  The load can be followed and cancelled from another thread through _progress (see MeshLoader) : the bytes and the faces read
+		*  are updated after each slice of the file, and the cancellation is checked as often, the mesh being then left empty.
+		*
+		*  \param _path : location on the disk of the mesh to load.
+		*  \param _nThreads : number of threads to use : 1 (default) for a serial load, 0 to use every core of the computer.
+		*  \param _progress : progress of the load, NULL (default) if it is not followed.
+		*
+		*  \return (int) returns -1 if an issue occured during the operation or if the load has been cancelled, 1 else;
 		*/
-		void addEdge ( Edge* _e );
+		int loadOBJ ( char* _path, int _nThreads = 1, LoadProgress* _progress = NULL );
 		
 		/*!
-		*  \brief Adds a face to the face vector of an edge.
+		*  \brief Saves the mesh in a wavefront ".obj" file.
 		*
-		*  Adds a face to the face vector of the ith edge.
+		*  Saves the vertices ("v") and the faces ("f") of the mesh in the _path file, and the normals of the vertices ("vn") if asked.
+		*  The file is written through a large buffer and the numbers are formatted without streams, with the fewest digits that read back
+		*  to the same value (see FileWriter::writeReal) : loading the file gives back the same mesh.
 		*
-		*  \param _i : index of the face we want to add the edge.
-		*  \param _f : pointer on the face we want to add.
+		*  \param _path : location on the disk of the file to write.
+		*  \param _normals : true to write the normals of the vertices (computed with computeNormals), false (default) else.
 		*
-		*  \return (void)
+		*  \return (int) returns -1 if an issue occured during the operation, 1 else;
 		*/
-		void addFaceToIEdge ( int _i, Face* _f );
+		int saveOBJ ( char* _path, bool _normals = false );
 		
 		/*!
-		*  \brief Adds a face to the mesh.
+		*  \brief Saves the mesh in the binary format of the library.
 		*
-		*  Adds a pointer on a face to the face vector of the mesh and updates the nFaces attribute;
+		*  Saves the whole mesh in the _path file, in the binary ".smlb" format of the library :
+		*  a header (magic "SMLB", version, byte order, counts) followed by flat arrays of the positions, normals and colors of the vertices,
+		*  the normals of the faces, the tail/head/twin indices of the half edges, the edge loops of the faces
+		*  and the face lists of the edges and the edge lists of the vertices (compressed rows).
+		*  The file is written in the byte order of the computer and can be loaded with loadBinary.
 		*
-		*  \param _f : pointer on the face to add;
+		*  \param _path : location on the disk of the file to write.
 		*
-		*  \return (void)
+		*  \return (int) returns -1 if an issue occured during the operation, 1 else;
 		*/
-		void addFace ( Face* _f );
+		int saveBinary ( char* _path );
 		
 		/*!
-		*  \brief Loads a wavefront ".obj" mesh.
+		*  \brief Loads a mesh saved in the binary format of the library.
 		*
-		*  Loads a wavefront ".obj" mesh from the _path file.
-		*  This is a basic version of a loader : does not support the comment lines, the texture lines or the normal lines.
-		*  This has to be report and fixed.
-		*  For OBJ format spec., see http://en.wikipedia.org/wiki/Wavefront_.obj_file.
+		*  Loads a mesh saved with saveBinary : the file is mapped in memory, checked and the objects of the mesh are created directly from its arrays,
+		*  without any parsing nor any search of the half edges. The mesh is exactly the one which was saved, normals and colors included :
+		*  there is no need to compute the normals again.
+		*  With several threads, the objects are created and linked in parallel.
+		*
+		*  \param _path : location on the disk of the file to load.
+		*  \param _nThreads : number of threads to use : 1 (default) for a serial load, 0 to use every core of the computer.
 		*
-		*  \todo The loader should be rewritten to support the comment lines and other types of format.
+		*  \return (int) returns -1 if the file can not be read, is not a ".smlb" file of a supported version or is corrupted, 1 else;
+		*/
+		int loadBinary ( char* _path, int _nThreads = 1 );
+		
+		/*!
+		*  \brief Loads a binary ".ply" mesh.
+		*
+		*  Loads a ".ply" mesh with a binary little endian body from the _path file : the file is mapped in memory and its body is read in place.
+		*  The vertices are given by the x, y and z properties of the "vertex" element, their red, green and blue properties (if any) fill their color
+		*  (integer components are scaled to [0, 1]), and the faces by the "vertex_indices" (or "vertex_index") list of the "face" element.
+		*  The other elements and properties are skipped, as the faces with less than three vertices.
+		*  For PLY format spec., see http://paulbourke.net/dataformats/ply/.
 		*
 		*  \param _path : location on the disk of the mesh to load.
+		*  \param _nThreads : number of threads used to build the mesh : 1 (default) for a serial build, 0 to use every core of the computer.
+		*
+		*  \return (int) returns -1 if an issue occured during the operation (ascii and big endian files are not supported), 1 else;
+		*/
+		int loadPLY ( char* _path, int _nThreads = 1 );
+		
+		/*!
+		*  \brief Saves the mesh in a binary ".ply" file.
+		*
+		*  Saves the mesh in the _path file, as a ".ply" file with a binary little endian body :
+		*  the location of the vertices (as doubles), their colors (as unsigned chars, only if at least one vertex is colored) and the faces.
+		*
+		*  \param _path : location on the disk of the file to write.
+		*
+		*  \return (int) returns -1 if an issue occured during the operation, 1 else;
+		*/
+		int savePLY ( char* _path );
+		
+		/*!
+		*  \brief Loads a binary ".stl" mesh.
+		*
+		*  Loads a binary ".stl" mesh from the _path file. A STL file is a triangle soup : each triangle repeats its three vertices.
+		*  The vertices are welded with a spatial hash (see SpatialHash) so that the triangles share their vertices and their edges ;
+		*  the triangles that become degenerate once welded are skipped. The normals of the file are not used.
+		*
+		*  \param _path : location on the disk of the mesh to load.
+		*  \param _tolerance : distance under which two vertices are welded, 0 (default) to weld only the equal vertices.
+		*
+		*  \return (int) returns -1 if an issue occured during the operation (ascii files are not supported), 1 else;
+		*/
+		int loadSTL ( char* _path, double _tolerance = 0 );
+		
+		/*!
+		*  \brief Saves the mesh in a binary ".stl" file.
+		*
+		*  Saves the mesh in the _path file, as a binary ".stl" file : the faces with more than three vertices are split in triangles (fan from their first vertex)
+		*  and the normal of each triangle is computed from its vertices.
+		*
+		*  \param _path : location on the disk of the file to write.
 		*
 		*  \return (int) returns -1 if an issue occured during the operation, 1 else;
 		*/
-		int loadOBJ ( char* _path );
+		int saveSTL ( char* _path );
 		
 		/*!
 		*  \brief Computes the normals of the mesh.
 		*
 		*  Computes the normals of every faces and every vertex of the mesh.
-		*  The computed normals are all normalized.
+		*  The normal of a triangle is the cross product of its edges, the normal of a face with more vertices is given by Newell's method (reliable even if the face
+		*  is not planar or not convex). The normal of a vertex is the mean of the normals of its faces, weighted as asked : the weights are computed by the pass
+		*  over the faces, which is the only one to read the positions.
+		*  The computed normals are all normalized. The result does not depend on the number of threads.
+		*
+		*  \param _weighting : weights of the normals of the faces in the normals of the vertices : NORMALS_UNIFORM (default), NORMALS_AREA or NORMALS_ANGLE.
+		*  \param _nThreads : number of threads to use : 1 (default) for a serial computation, 0 to use every core of the computer.
+		*
+		*  \return (int) returns -1 if _weighting is not a normals weighting, 1 else.
+		*/
+		int computeNormals ( int _weighting = NORMALS_UNIFORM, int _nThreads = 1 );
+		
+		/*!
+		*  \brief Updates the normals of the mesh after some vertices were moved.
+		*
+		*  Computes again the normals of the faces of the vertices moved since the normals were computed (Vertex::setPos, markMoved),
+		*  and the normals of the vertices of these faces, with the weighting given to the last computeNormals : apart from a pass over one byte per vertex to find
+		*  the moved ones, the cost depends on the number of vertices moved, not on the size of the mesh, and the normals are the same as computeNormals would give.
+		*  If the normals were never computed, or if the mesh was loaded, built or triangulated since, every normal is computed (see computeNormals).
+		*
+		*  \param _nThreads : number of threads to use : 1 (default) for a serial computation, 0 to use every core of the computer.
+		*
+		*  \return (int) returns 1.
+		*/
+		int refreshNormals ( int _nThreads = 1 );
+		
+		/*!
+		*  \brief Marks a vertex as moved.
+		*
+		*  Marks a vertex as moved, so that refreshNormals updates the normals around it and the bounding box is computed again : Vertex::setPos does it,
+		*  it has to be called for a vertex moved through its position array (Vertex::getPosArray).
+		*  Nothing is allocated, only the flag of the vertex is written : several threads can mark (or move with Vertex::setPos) different vertices at the same time.
+		*
+		*  \param _i : ID of the vertex.
 		*
 		*  \return (void)
 		*/
-		void computeNormals ();
+		void markMoved ( int _i );
+		
+		/*!
+		*  \brief Getter of the Mesh class.
+		*
+		*  Gives the axis-aligned bounding box of the vertices. The box is kept by the mesh : it is only computed again (in one pass over the positions)
+		*  after a vertex was moved or added, so it can be asked for as often as needed.
+		*
+		*  \param _bot : filled with the bottom corner of the box (lowest x, y and z).
+		*  \param _top : filled with the top corner of the box (highest x, y and z).
+		*  \param _nThreads : number of threads to use if the box has to be computed : 1 (default) for a serial computation, 0 to use every core of the computer.
+		*
+		*  \return (int) returns -1 if the mesh has no vertex (_bot and _top are not changed), 1 else.
+		*/
+		int getBoundingBox ( Vector3D& _bot, Vector3D& _top, int _nThreads = 1 );
 		
 		/*!
 		*  \brief Resize the mesh to a unit-length box.
 		*
 		*  Resize the mesh to a unit-length box :
 		*  The biggest direction of the mesh (Ox or Oy or Oz) will be set to 1 after scaling, 
-		*  the other directions will be proportionally scaled.
+		*  the other directions will be proportionally scaled. Nothing is done if the mesh is empty or flat in every direction.
+		*
+		*  \param _nThreads : number of threads to use if the bounding box has to be computed : 1 (default) for a serial computation, 0 to use every core of the computer.
 		*
 		*  \return (void)
 		*/
-		void normalize();
+		void normalize ( int _nThreads = 1 );
+		
+		/*!
+		*  \brief Reorders the elements of the mesh to improve the locality of its arrays.
+		*
+		*  Renumbers the vertices, the half edges and the faces so that the elements which are close in the mesh are close in its arrays :
+		*  the passes over the mesh (normals, smoothing, ...) then read memory that is already in the cache. The files often give their elements in an order
+		*  without any locality (the order of the exporter). The shape of the mesh is not changed, only the IDs of its elements (and the properties follow them).
+		*  The Handles (Vertex, Edge, Face) and pointers on the arrays got before the call are not valid anymore.
+		*
+		*  \param _policy : REORDER_HILBERT (default), REORDER_MORTON (spatial orders) or REORDER_RCM (topological order).
+		*
+		*  \return (int) returns -1 if _policy is not a reorder policy, 1 else.
+		*/
+		int reorder ( int _policy = REORDER_HILBERT );
+		
+		/*!
+		*  \brief Getter of the Mesh class.
+		*
+		*  Getter of the Mesh class : the passes over the faces (normals, area, display) have a kernel for the triangle meshes,
+		*  in which every face has three edges at known places (no loop to walk, no index to read).
+		*
+		*  \return (bool) returns true if every face of the mesh is a triangle, false else.
+		*/
+		bool isTriangleMesh ();
+		
+		/*!
+		*  \brief Splits the faces of the mesh in triangles.
+		*
+		*  Splits each face with more than three vertices in triangles (fan from its first vertex, as saveSTL does) and removes the faces with less than three vertices :
+		*  the mesh is then a triangle mesh (see isTriangleMesh). The vertices keep their IDs, attributes and properties. The triangles are numbered in the order
+		*  of their faces and take the normal and the properties of their face. The half edges are renumbered, the new ones (the diagonals) take the default value of
+		*  the properties. Nothing is done if the mesh already is a triangle mesh.
+		*
+		*  \param _nThreads : number of threads used to rebuild the mesh : 1 (default) for a serial build, 0 to use every core of the computer.
+		*
+		*  \return (int) returns 1.
+		*/
+		int triangulate ( int _nThreads = 1 );
+		
+		/*!
+		*  \brief Computes the area of the mesh.
+		*
+		*  \return (double) returns the sum of the areas of the faces of the mesh.
+		*/
+		double getArea ();
 		
 		/*!
 		*  \brief Print some informations about the mesh in the terminal.
@@ -409,9 +932,64 @@ class Mesh
 		*  Fills the color attribute of the vertex.
 		*  Its value is transformed in a color interpolated from red (max value of the map) and magenta (min value of the map).
 		*
+		*  \param _m : map of the values of the vertices, it is not copied.
+		*
 		*  \return (int) Returns 1 if the operation was done succesfully, -1 else.
 		*/
-		int colorFromMap ( Map _m );
+		int colorFromMap ( const Map& _m );
+		
+		/*!
+		*  \brief Color each vertex of the mesh according to one of its properties.
+		*
+		*  Color each vertex of the mesh as colorFromMap does, from the value of the vertex in the property _name (a Property<double>).
+		*
+		*  \param _name : name of the property of the vertices.
+		*
+		*  \return (int) Returns 1 if the operation was done succesfully, -1 else (no such property).
+		*/
+		int colorFromProperty ( const string& _name );
+		
+		/*!
+		*  \brief Adds a property to the elements of the mesh.
+		*
+		*  Adds a property to the vertices, to the half edges or to the faces of the mesh : one value of type T per element, stored in a contiguous array.
+		*  The property has one value per element of the mesh, elements added or loaded later included. It is kept when the mesh is cleared or loaded
+		*  (its values are then reset to _default), and it is copied with the mesh.
+		*  The pointer returned stays valid until the property is removed or the mesh is destroyed : in the loops, p[ v.getID() ] costs an array access.
+		*  When another mesh is assigned to this one, the property is kept (with the values of the other mesh) if the other mesh has a property with the same name
+		*  and type for the same elements, else it is deleted and the pointer is no longer valid.
+		*
+		*  \param _element : type of the elements (VERTICES, EDGES or FACES).
+		*  \param _name : name of the property, unique among the properties of these elements.
+		*  \param _default : value of the elements (and of the ones added later).
+		*
+		*  \return (Property<T>*) returns the property, NULL if _element is not a type of elements or if there already is a property with this name.
+		*/
+		template < class T >
+		Property<T>* addProperty ( int _element, const string& _name, const T& _default = T() );
+		
+		/*!
+		*  \brief Getter of the Mesh class.
+		*
+		*  Finds a property of the vertices, half edges or faces by its name : this should be done once, before the loops.
+		*
+		*  \param _element : type of the elements (VERTICES, EDGES or FACES).
+		*  \param _name : name of the property.
+		*
+		*  \return (Property<T>*) returns the property, NULL if there is none with this name and this type of values.
+		*/
+		template < class T >
+		Property<T>* getProperty ( int _element, const string& _name );
+		
+		/*!
+		*  \brief Removes a property from the elements of the mesh.
+		*
+		*  \param _element : type of the elements (VERTICES, EDGES or FACES).
+		*  \param _name : name of the property.
+		*
+		*  \return (int) Returns 1 if the property was removed, -1 else (no such property).
+		*/
+		int removeProperty ( int _element, const string& _name );
 		
 		/*!
 		*  \brief OpenGL routine to display one of the vertices of a mesh.
@@ -442,7 +1020,7 @@ class Mesh
 		/*!
 		*  \brief OpenGL routine to display the vertices of a mesh.
 		*
-		*  OpenGL routine to display the vertices of a mesh.
+		*  OpenGL routine to display the vertices of a mesh, drawn at once from the arrays of the mesh.
 		*
 		*  \param _r : red component of the color to display.
 		*  \param _g : green component of the color to display.
@@ -455,7 +1033,7 @@ class Mesh
 		/*!
 		*  \brief OpenGL routine to display the vertices of a mesh.
 		*
-		*  OpenGL routine to display the vertices of a mesh.
+		*  OpenGL routine to display the vertices of a mesh, drawn at once from the arrays of the mesh.
 		*  The color displayed will be the vertices attached colors.
 		*
 		*  \return (void)
@@ -638,4 +1216,34 @@ class Mesh
 		void display ( int _mode=FACES );
 };
 
+template < class T >
+Property<T>* Mesh::addProperty( int _element, const string& _name, const T& _default )
+{
+	PropertySet*	set = this->getPropertySet( _element );
+	Property<T>*	property;
+	
+	if ( set == NULL || set->find( _name ) != NULL )
+	{
+		cout<<"Error while adding the property \""<<_name<<"\" : "<<( ( set == NULL ) ? "not a type of elements" : "the name is already used" )<<endl;
+		cout<<"Method Mesh::addProperty is returning NULL, check it if you didn't"<<endl;
+		return NULL;
+	}
+	
+	property = new Property<T>( _name, _default );
+	set->add( property );
+	
+	return property;
+}
+
+template < class T >
+Property<T>* Mesh::getProperty( int _element, const string& _name )
+{
+	PropertySet* set = this->getPropertySet( _element );
+	
+	if ( set == NULL )
+		return NULL;
+	
+	return dynamic_cast< Property<T>* >( set->find( _name ) );
+}
+
 #endif
@@ -0,0 +1,182 @@
+#ifndef MESHBVH_H
+#define MESHBVH_H
+
+/**
+ * \file	meshbvh.h
+ * \brief	Declaration de la classe MeshBVH, une hierarchie de boites englobantes sur les faces d'un maillage pour le lancer de rayons.
+ */
+
+/* ______________________________ My includes ____ */
+#include "mesh.h"
+
+/* ____________________________ STD Librairies ___ */
+#include <vector>
+#include <limits>
+
+using namespace std;
+
+/*! \def BVH_BINS
+ * \brief Number of bins along an axis when a node of the hierarchy is split.
+ */
+#define BVH_BINS		16
+
+/*! \def BVH_MAX_LEAF
+ * \brief Number of triangles above which a node is always split.
+ */
+#define BVH_MAX_LEAF	8
+
+/*! \def BVH_MAX_DEPTH
+ * \brief Depth that no leaf of the hierarchy reaches : size of the stack of a traversal.
+ */
+#define BVH_MAX_DEPTH	128
+
+class MeshBVH
+{
+	/*!
+	 * \class MeshBVH
+	 * \brief Classe représentant une hierarchie de boites englobantes (BVH) sur les faces d'un maillage, pour trouver rapidement les faces touchees par un rayon.
+	 *
+	 * Les faces sont decoupees en triangles (en eventail depuis leur premier sommet), et les triangles sont repartis dans un arbre binaire de boites :
+	 * chaque noeud est coupe le long de l'axe et a la position qui minimisent le cout estime du lancer de rayons (heuristique des surfaces, SAH),
+	 * les positions essayees etant les bords de BVH_BINS intervalles (binned SAH). Les sous-arbres sont construits en parallele.
+	 * Les noeuds sont ranges dans un seul tableau, 32 octets chacun (boite en float, arrondie vers l'exterieur), les deux fils d'un noeud cote a cote :
+	 * un noeud ne donne que l'indice de son premier fils, et les deux boites testees a chaque etape sont lues d'un seul bloc de 64 octets.
+	 * Les sommets des triangles sont recopies dans l'ordre des feuilles : la hierarchie ne lit plus le maillage une fois construite,
+	 * elle doit etre construite a nouveau si ses sommets sont deplaces. Les requetes ne changent rien et peuvent etre faites par plusieurs threads a la fois.
+	 *
+	 */
+
+	private :
+		/*!
+		 * \struct Node
+		 * \brief Noeud de la hierarchie : sa boite, et ses fils ou ses triangles.
+		 */
+		struct Node
+		{
+			float	bot[3];				/*! <Bottom corner of the box of the node.*/
+			int		first;				/*! <Index of the first child of an inner node (the second one follows it), index of the first triangle of a leaf.*/
+			float	top[3];				/*! <Top corner of the box of the node.*/
+			int		count;				/*! <Number of triangles of a leaf, 0 for an inner node.*/
+		};
+
+		vector<Node>	nodes;			/*! <Nodes of the hierarchy, the root first.*/
+		vector<Real>	triangles;		/*! <Triangles in the order of the leaves, nine values per triangle : the first vertex and the two edges from it.*/
+		vector<int>		triFaces;		/*! <Face of each triangle.*/
+
+		/*!
+		*  \brief Builds a subtree.
+		*
+		*  Splits the triangles of a node and its children until they are small enough, the nodes are added to _out.
+		*  The subtrees with less than _taskSize triangles are not built but added to _tasks, to be built later.
+		*
+		*  \param _out : nodes of the subtree, the node _node is set.
+		*  \param _node : index of the node in _out.
+		*  \param _begin : first triangle of the node in _order.
+		*  \param _end : end of the triangles of the node in _order.
+		*  \param _order : triangles in the order of the leaves, reordered by the split.
+		*  \param _boxes : float box of each triangle (bottom then top corner), six values per triangle.
+		*  \param _taskSize : number of triangles under which a subtree is left to a task, 0 to build every subtree.
+		*  \param _tasks : tasks left, four values per task (node, begin, end and depth).
+		*  \param _depth : depth of the node in the whole hierarchy : past BVH_MAX_DEPTH - 32 the nodes are split in their middle, so that no leaf is deeper than BVH_MAX_DEPTH.
+		*  \param _nThreads : number of threads to bin the large nodes.
+		*
+		*  \return (void)
+		*/
+		static void buildNode ( vector<Node>& _out, int _node, int _begin, int _end, int* _order, const float* _boxes, int _taskSize, vector<int>* _tasks, int _depth, int _nThreads );
+
+		/*!
+		*  \brief Walks the hierarchy along a ray.
+		*
+		*  \param _origin : origin of the ray.
+		*  \param _dir : direction of the ray.
+		*  \param _tMax : hits are searched for 0 < t < _tMax.
+		*  \param _t : if not NULL, filled with the t of the hit.
+		*
+		*  \return (int) returns the index of the nearest triangle hit (of the first one found if ANY is true), -1 if the ray hits no triangle.
+		*/
+		template < bool ANY >
+		int traverse ( const double* _origin, const double* _dir, double _tMax, double* _t ) const;
+
+	public :
+		/*!
+		*  \brief Default constructor of the MeshBVH class.
+		*
+		*  Default constructor of the MeshBVH class : the hierarchy is empty, no ray hits it.
+		*/
+		MeshBVH();
+
+		/*!
+		*  \brief Constructor of the MeshBVH class.
+		*
+		*  Constructor of the MeshBVH class : builds the hierarchy of the faces of a mesh (see build).
+		*
+		*  \param _mesh : mesh whose faces are put in the hierarchy.
+		*  \param _nThreads : number of threads to use : 1 (default) for a serial build, 0 to use every core of the computer.
+		*/
+		MeshBVH( Mesh& _mesh, int _nThreads = 1 );
+
+		/*!
+		*  \brief Builds the hierarchy.
+		*
+		*  Builds the hierarchy of the faces of a mesh, the previous one is dropped.
+		*  The faces with a vertex which is not finite (NaN, infinite, or out of the range of the floats) are left out. The hierarchy does not depend on the number of threads.
+		*
+		*  \param _mesh : mesh whose faces are put in the hierarchy.
+		*  \param _nThreads : number of threads to use : 1 (default) for a serial build, 0 to use every core of the computer.
+		*
+		*  \return (int) returns -1 if no face could be put in the hierarchy (it is then empty), 1 else.
+		*/
+		int build ( Mesh& _mesh, int _nThreads = 1 );
+
+		/*!
+		*  \brief Empties the hierarchy and frees its memory.
+		*
+		*  \return (void)
+		*/
+		void clear ();
+
+		/*!
+		*  \brief Getter of the MeshBVH class.
+		*
+		*  \return (int) returns the number of nodes of the hierarchy.
+		*/
+		int getNNodes () const;
+
+		/*!
+		*  \brief Getter of the MeshBVH class.
+		*
+		*  \return (int) returns the number of triangles of the hierarchy.
+		*/
+		int getNTriangles () const;
+
+		/*!
+		*  \brief Finds the first face hit by a ray.
+		*
+		*  Finds the nearest face hit by the ray _origin + t * _dir, with 0 < t < _tMax : the faces are hit on both sides.
+		*  The nodes are visited nearest first, and a node further than the nearest hit found is skipped.
+		*
+		*  \param _origin : origin of the ray.
+		*  \param _dir : direction of the ray, t is in units of its length (it does not have to be normalized).
+		*  \param _tMax : hits are searched before it, no limit by default.
+		*  \param _t : if not NULL, filled with the t of the hit.
+		*
+		*  \return (int) returns the ID of the face hit, -1 if the ray hits no face.
+		*/
+		int firstHit ( Vector3D _origin, Vector3D _dir, double _tMax = numeric_limits<double>::infinity(), double* _t = NULL ) const;
+
+		/*!
+		*  \brief Tells if a ray hits a face.
+		*
+		*  Tells if the ray _origin + t * _dir, with 0 < t < _tMax, hits a face : the search stops at the first hit found, whichever it is
+		*  (occlusion and visibility queries, shadow rays).
+		*
+		*  \param _origin : origin of the ray.
+		*  \param _dir : direction of the ray, t is in units of its length (it does not have to be normalized).
+		*  \param _tMax : hits are searched before it, no limit by default (the distance to a light for a shadow ray).
+		*
+		*  \return (bool) returns true if the ray hits a face, false else.
+		*/
+		bool anyHit ( Vector3D _origin, Vector3D _dir, double _tMax = numeric_limits<double>::infinity() ) const;
+};
+
+#endif
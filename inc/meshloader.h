@@ -0,0 +1,180 @@
+#ifndef MESHLOADER_H
+#define MESHLOADER_H
+
+/**
+ * \file	meshloader.h
+ * \brief	Declaration de la classe MeshLoader, chargement d'un maillage en arriere plan.
+ */
+
+/* ______________________________ My includes ____ */
+#include "mesh.h"
+#include "progress.h"
+
+/* ____________________________ STD Librairies ___ */
+#include <string>
+#include <thread>
+#include <atomic>
+
+using namespace std;
+
+class MeshLoader
+{
+	/*!
+	 * \class MeshLoader
+	 * \brief Classe représentant le chargement d'un maillage par un thread en arriere plan.
+	 *
+	 * Le chargement (".obj", ".obj.gz", ".smlb", ".ply" ou ".stl" selon l'extension), puis la triangulation, le calcul des normales et la normalisation
+	 * si elles sont demandees, sont faits par un thread dedie : le thread appelant reste libre (par exemple pour la boucle d'affichage).
+	 * Son avancement (octets et faces lus, faces construites, etape) peut etre lu a tout moment et le chargement peut etre annule :
+	 * le chargeur s'arrete alors au prochain point de controle (voir Mesh::loadOBJ).
+	 * Le maillage n'est accessible qu'une fois le chargement termine. Un MeshLoader ne peut pas etre copie.
+	 *
+	 */
+
+	private :
+		Mesh			mesh;			/*! <Mesh being loaded, then loaded.*/
+		LoadProgress	progress;		/*! <Progress of the loading, shared with the loading thread.*/
+		thread			worker;			/*! <Loading thread.*/
+		atomic<int>		result;			/*! <Result of the loading : 0 while it is running, 1 if it succeeded, -1 if it failed or was cancelled (or never started).*/
+		string			path;			/*! <Location on the disk of the mesh to load.*/
+		int				nThreads;		/*! <Number of threads used by the loading (see Mesh::loadOBJ).*/
+		bool			normals;		/*! <True if the normals are computed once the mesh is loaded.*/
+		bool			normalized;		/*! <True if the mesh is normalized once it is loaded.*/
+		bool			triangulated;	/*! <True if the faces of the mesh are split in triangles once it is loaded.*/
+
+		/*!
+		*  \brief Copy constructor of the MeshLoader class.
+		*
+		*  A loader can not be copied : not implemented.
+		*/
+		MeshLoader( const MeshLoader& _l );
+
+		/*!
+		*  \brief Affectation operator of the MeshLoader class.
+		*
+		*  A loader can not be copied : not implemented.
+		*/
+		MeshLoader& operator= ( const MeshLoader& _l );
+
+		/*!
+		*  \brief Body of the loading thread.
+		*
+		*  Loads the mesh with the loader of its format, then triangulates it, normalizes it and computes its normals if asked.
+		*
+		*  \return (void)
+		*/
+		void run ();
+
+	public :
+		/*!
+		*  \brief Default constructor of the MeshLoader class.
+		*
+		*  Default constructor of the MeshLoader class : nothing is loaded.
+		*/
+		MeshLoader();
+
+		/*!
+		*  \brief Destructor of the MeshLoader class.
+		*
+		*  Destructor of the MeshLoader class : a running loading is cancelled and waited for.
+		*/
+		~MeshLoader();
+
+		/*!
+		*  \brief Starts a loading.
+		*
+		*  Starts loading the _path mesh in the background and returns immediately.
+		*  The format is given by the extension of the file : ".smlb" (Mesh::loadBinary), ".ply" (Mesh::loadPLY), ".stl" (Mesh::loadSTL),
+		*  wavefront ".obj" else (Mesh::loadOBJ, compressed or not). Only the ".obj" loading reports its progress before being finished.
+		*
+		*  \param _path : location on the disk of the mesh to load.
+		*  \param _nThreads : number of threads used by the loading and the processing : 1 (default) for a serial load, 0 to use every core of the computer.
+		*  \param _normals : true (default) to compute the normals of the mesh once it is loaded.
+		*  \param _normalize : true (default) to normalize the mesh once it is loaded.
+		*  \param _triangulate : true to split the faces of the mesh in triangles once it is loaded (see Mesh::triangulate), false (default) else.
+		*
+		*  \return (int) returns -1 if a loading is already running, 1 else.
+		*/
+		int start ( const char* _path, int _nThreads = 1, bool _normals = true, bool _normalize = true, bool _triangulate = false );
+
+		/*!
+		*  \brief Cancels the loading.
+		*
+		*  Asks the running loading to stop and returns immediately : the loading then ends as soon as possible, with a result of -1.
+		*
+		*  \return (void)
+		*/
+		void cancel ();
+
+		/*!
+		*  \brief Waits for the end of the loading.
+		*
+		*  \return (int) returns the result of the loading : 1 if the mesh is loaded, -1 else.
+		*/
+		int wait ();
+
+		/*!
+		*  \brief Getter of the MeshLoader class.
+		*
+		*  Getter of the MeshLoader class.
+		*
+		*  \return (int) returns 0 while the loading is running, 1 if the mesh is loaded, -1 if the loading failed, was cancelled or never started.
+		*/
+		int getResult () const;
+
+		/*!
+		*  \brief Getter of the MeshLoader class.
+		*
+		*  Getter of the MeshLoader class.
+		*
+		*  \return (int) returns the stage of the loading (LOAD_WAITING, LOAD_PARSING, LOAD_BUILDING, LOAD_PROCESSING or LOAD_DONE).
+		*/
+		int getStage () const;
+
+		/*!
+		*  \brief Getter of the MeshLoader class.
+		*
+		*  Getter of the MeshLoader class.
+		*
+		*  \return (long long) returns the number of bytes of the file read so far.
+		*/
+		long long getBytesRead () const;
+
+		/*!
+		*  \brief Getter of the MeshLoader class.
+		*
+		*  Getter of the MeshLoader class.
+		*
+		*  \return (long long) returns the size of the file in bytes, 0 if it is not known (compressed file).
+		*/
+		long long getBytesTotal () const;
+
+		/*!
+		*  \brief Getter of the MeshLoader class.
+		*
+		*  Getter of the MeshLoader class.
+		*
+		*  \return (long long) returns the number of faces read in the file so far.
+		*/
+		long long getFacesRead () const;
+
+		/*!
+		*  \brief Getter of the MeshLoader class.
+		*
+		*  Getter of the MeshLoader class.
+		*
+		*  \return (long long) returns the number of faces of the mesh built so far.
+		*/
+		long long getFacesBuilt () const;
+
+		/*!
+		*  \brief Getter of the MeshLoader class.
+		*
+		*  Getter of the MeshLoader class : the mesh must not be used before the end of the loading (see getResult and wait).
+		*
+		*  \return (Mesh&) returns the mesh loaded.
+		*/
+		Mesh& getMesh ();
+};
+
+#endif
@@ -0,0 +1,202 @@
+#ifndef OBJSTATS_H
+#define OBJSTATS_H
+
+/**
+ * \file	objstats.h
+ * \brief	Declaration de la classe ObjStats, statistiques d'un fichier ".obj" calculees a la lecture, sans construire de maillage.
+ */
+
+/* ______________________________ My includes ____ */
+#include "vector3d.h"
+
+/* ____________________________ STD Librairies ___ */
+#include <vector>
+
+using namespace std;
+
+class ObjStats
+{
+	/*!
+	 * \class ObjStats
+	 * \brief Classe représentant les statistiques d'un fichier ".obj" : consommateur de parser_parseOBJ et parser_streamOBJ.
+	 *
+	 * Les sommets et les faces sont comptes au fil de la lecture : boite englobante (avec la taille utilisee par Mesh::normalize),
+	 * histogramme du nombre de sommets des faces, aire des faces (avec la formule de Mesh::computeNormals).
+	 * Aucune structure de demi-aretes n'est construite. Pour calculer les aires, les positions des sommets sont gardees en float
+	 * (les chargeurs de la librairie les arrondissent de toute facon en float) : 12 octets par sommet.
+	 * Sans les aires, la memoire utilisee ne depend pas de la taille du fichier.
+	 *
+	 */
+
+	private :
+		bool				areas;			/*! <True if the areas of the faces are computed.*/
+		vector<float>		positions;		/*! <Location of the vertices, three values per vertex (only if the areas are computed).*/
+		vector<int>			face;			/*! <Vertices of the face being read (-1 for an invalid index).*/
+		long long			nVerts;			/*! <Number of vertices read.*/
+		long long			nFaces;			/*! <Number of faces read.*/
+		long long			nIndices;		/*! <Number of vertex indices of the faces.*/
+		long long			nBadIndices;	/*! <Number of indices refering to a vertex that does not exist (or is not read yet).*/
+		long long			nDegenerate;	/*! <Number of faces with less than three vertices or a null area.*/
+		vector<long long>	degrees;		/*! <Number of faces of each size : degrees[n] faces have n vertices.*/
+		Vector3D			bot;			/*! <Bottom corner of the bounding box.*/
+		Vector3D			top;			/*! <Top corner of the bounding box.*/
+		double				totalArea;		/*! <Sum of the areas of the faces.*/
+		long long			nAreas;			/*! <Number of faces whose area has been computed.*/
+		double				minArea;		/*! <Area of the smallest face.*/
+		double				maxArea;		/*! <Area of the biggest face.*/
+
+	public :
+		/*!
+		*  \brief Constructor of the ObjStats class.
+		*
+		*  Constructor of the ObjStats class : nothing is read yet.
+		*
+		*  \param _areas : true (default) to compute the areas of the faces, false to use a memory that does not depend on the size of the file.
+		*/
+		ObjStats( bool _areas = true );
+
+		/*!
+		*  \brief Resets the statistics.
+		*
+		*  \return (void)
+		*/
+		void clear ();
+
+		/*!
+		*  \brief Computes the statistics of a file.
+		*
+		*  Resets the statistics and streams the file _path (see parser_streamOBJ).
+		*
+		*  \param _path : location on the disk of the ".obj" file.
+		*
+		*  \return (int) returns -1 if the file can not be read, 1 else.
+		*/
+		int read ( const char* _path );
+
+		/*!
+		*  \brief Consumer method : adds a vertex.
+		*
+		*  \return (void)
+		*/
+		void vertex ( double _x, double _y, double _z );
+
+		/*!
+		*  \brief Consumer method : begins a face.
+		*
+		*  \return (void)
+		*/
+		void beginFace ();
+
+		/*!
+		*  \brief Consumer method : adds a vertex index (as written in the file) to the current face.
+		*
+		*  \return (void)
+		*/
+		void faceIndex ( int _i );
+
+		/*!
+		*  \brief Consumer method : ends the current face.
+		*
+		*  \return (void)
+		*/
+		void endFace ();
+
+		/*!
+		*  \brief Getter of the ObjStats class.
+		*
+		*  Getter of the ObjStats class.
+		*
+		*  \return (long long) returns the number of vertices read.
+		*/
+		long long getNVerts () const;
+
+		/*!
+		*  \brief Getter of the ObjStats class.
+		*
+		*  Getter of the ObjStats class.
+		*
+		*  \return (long long) returns the number of faces read.
+		*/
+		long long getNFaces () const;
+
+		/*!
+		*  \brief Getter of the ObjStats class.
+		*
+		*  Getter of the ObjStats class.
+		*
+		*  \return (long long) returns the number of indices refering to a vertex that does not exist.
+		*/
+		long long getNBadIndices () const;
+
+		/*!
+		*  \brief Getter of the ObjStats class.
+		*
+		*  Getter of the ObjStats class.
+		*
+		*  \return (long long) returns the number of faces with less than three vertices or a null area.
+		*/
+		long long getNDegenerate () const;
+
+		/*!
+		*  \brief Getter of the ObjStats class.
+		*
+		*  Getter of the ObjStats class.
+		*
+		*  \return (const vector<long long>&) returns the number of faces of each size (index n for the faces with n vertices).
+		*/
+		const vector<long long>& getDegrees () const;
+
+		/*!
+		*  \brief Getter of the ObjStats class.
+		*
+		*  Getter of the ObjStats class.
+		*
+		*  \return (Vector3D) returns the bottom corner of the bounding box.
+		*/
+		Vector3D getBot () const;
+
+		/*!
+		*  \brief Getter of the ObjStats class.
+		*
+		*  Getter of the ObjStats class.
+		*
+		*  \return (Vector3D) returns the top corner of the bounding box.
+		*/
+		Vector3D getTop () const;
+
+		/*!
+		*  \brief Getter of the ObjStats class.
+		*
+		*  Getter of the ObjStats class.
+		*
+		*  \return (double) returns the sum of the areas of the faces (0 if the areas are not computed).
+		*/
+		double getTotalArea () const;
+
+		/*!
+		*  \brief Getter of the ObjStats class.
+		*
+		*  Getter of the ObjStats class.
+		*
+		*  \return (double) returns the area of the smallest face.
+		*/
+		double getMinArea () const;
+
+		/*!
+		*  \brief Getter of the ObjStats class.
+		*
+		*  Getter of the ObjStats class.
+		*
+		*  \return (double) returns the area of the biggest face.
+		*/
+		double getMaxArea () const;
+
+		/*!
+		*  \brief Print the statistics in the terminal.
+		*
+		*  \return (void)
+		*/
+		void print ();
+};
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+/**
+ * \file	parallel.h
+ * \brief	Definition des outils de parallelisation (boucles paralleles sur des threads).
+ *
+ *  Ce fichier ne contient que des fonctions non membres. Elles sont template (le corps de boucle est une fonction ou un lambda)
+ *  et sont donc entierement definies ici.
+ *
+ */
+
+/* ____________________________ STD Librairies ___ */
+#include <vector>
+#include <thread>
+
+using namespace std;
+
+/*!
+*  \brief NON MEMBER FUNCTION : Number of threads to use by default.
+*
+*  Number of threads the hardware can run simultaneously.
+*
+*  \return (int) Returns the number of hardware threads, 1 if it is unknown.
+*/
+inline int tools_nThreads ()
+{
+	unsigned int n = thread::hardware_concurrency();
+
+	return ( n == 0 ) ? 1 : (int)n;
+}
+
+/*!
+*  \brief NON MEMBER FUNCTION : Parallel loop.
+*
+*  Splits the range [0, _n) into _nThreads contiguous ranges of (almost) the same size
+*  and calls _f ( begin, end, t ) for each of them, the range t being processed by the thread t.
+*  The range 0 is processed by the calling thread, the function returns once every range has been processed.
+*  The ranges are given in order : the range t is before the range t+1.
+*
+*  \param _n : size of the range to process.
+*  \param _nThreads : number of threads to use, tools_nThreads() if it is lower than 1.
+*  \param _f : function to call on each range, as _f ( int _begin, int _end, int _t ).
+*
+*  \return (void)
+*/
+template < class Func >
+void tools_parallelFor ( int _n, int _nThreads, Func _f )
+{
+	vector<thread>	threads;
+
+	if ( _nThreads < 1 )
+		_nThreads = tools_nThreads();
+
+	for ( int t = 1 ; t < _nThreads ; t++ )
+		threads.push_back( thread( _f, (int)( (long long)_n * t / _nThreads ), (int)( (long long)_n * ( t+1 ) / _nThreads ), t ) );
+
+	_f( 0, (int)( (long long)_n / _nThreads ), 0 );
+
+	for ( int t = 0 ; t < (int)threads.size() ; t++ )
+		threads[t].join();
+}
+
+#endif
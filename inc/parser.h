@@ -0,0 +1,570 @@
+#ifndef PARSER_H
+#define PARSER_H
+
+/**
+ * \file	parser.h
+ * \brief	Definition des outils de lecture des fichiers texte (nombres, lignes, format wavefront ".obj").
+ *
+ *  Ces fonctions travaillent directement sur des octets en memoire (typiquement un MappedFile) : elles n'utilisent pas de flux
+ *  et n'allouent rien. Elles sont definies inline (ou template) car elles sont au coeur des boucles de chargement.
+ *
+ */
+
+/* ______________________________ My includes ____ */
+#include "fileio.h"
+
+/* ____________________________ STD Librairies ___ */
+#include <vector>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+#include <cstdio>
+#include <climits>
+#include <string>
+#include <algorithm>
+
+using namespace std;
+
+/*!
+*  \brief NON MEMBER FUNCTION : Skips the blank characters.
+*
+*  Skips the spaces, tabulations and carriage returns (but not the end of line characters).
+*
+*  \param _p : current position in the text, moved to the first non blank character.
+*  \param _end : end of the text.
+*
+*  \return (void)
+*/
+inline void parser_skipBlanks ( const char*& _p, const char* _end )
+{
+	while ( _p < _end && ( *_p == ' ' || *_p == '\t' || *_p == '\r' ) )
+		_p++;
+}
+
+/*!
+*  \brief NON MEMBER FUNCTION : Goes to the next line.
+*
+*  Moves the position just after the next end of line character, or to the end of the text if there is none.
+*
+*  \param _p : current position in the text.
+*  \param _end : end of the text.
+*
+*  \return (void)
+*/
+inline void parser_nextLine ( const char*& _p, const char* _end )
+{
+	const char* eol = (const char*) memchr( _p, '\n', _end - _p );
+	_p = ( eol == NULL ) ? _end : eol + 1;
+}
+
+/*!
+*  \brief NON MEMBER FUNCTION : Reads an integer.
+*
+*  Reads a signed decimal integer at the current position.
+*
+*  \param _p : current position in the text, moved after the integer if it is read.
+*  \param _end : end of the text.
+*  \param _value : will contain the integer read.
+*
+*  \return (bool) Returns true if an integer has been read, false else, or if it does not fit in an int (the position is left untouched).
+*/
+inline bool parser_readInt ( const char*& _p, const char* _end, int& _value )
+{
+	const char*	p = _p;
+	bool		neg = false;
+	long long	value = 0;
+
+	if ( p < _end && ( *p == '-' || *p == '+' ) )
+	{
+		neg = ( *p == '-' );
+		p++;
+	}
+
+	if ( p == _end || (unsigned)( *p - '0' ) > 9 )
+		return false;
+
+	/* Past INT_MAX + 1 the integer can not be stored : the digits are still read, value stops growing so that it does not overflow too. */
+	while ( p < _end && (unsigned)( *p - '0' ) <= 9 )
+	{
+		if ( value <= (long long)INT_MAX + 1 )
+			value = value * 10 + ( *p - '0' );
+		p++;
+	}
+
+	if ( value > (long long)INT_MAX + neg )
+		return false;
+
+	_value = (int)( neg ? -value : value );
+	_p = p;
+
+	return true;
+}
+
+/*!
+*  \brief NON MEMBER FUNCTION : Reads a real number.
+*
+*  Reads a real number written as in C : [sign] digits [. digits] [e|E [sign] digits].
+*  The significant digits are accumulated in an integer which is then scaled by an exact power of ten :
+*  the result is correctly rounded for the numbers written with at most 15 significant digits and a small exponent,
+*  which covers almost every file. The other numbers are handed to strtod.
+*
+*  \param _p : current position in the text, moved after the number if it is read.
+*  \param _end : end of the text.
+*  \param _value : will contain the number read.
+*
+*  \return (bool) Returns true if a number has been read, false else (the position is left untouched).
+*/
+inline bool parser_readDouble ( const char*& _p, const char* _end, double& _value )
+{
+	static const double pow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+									1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+	const char*			p = _p;
+	bool				neg = false;
+	bool				any = false;
+	unsigned long long	mantissa = 0;
+	int					digits = 0;
+	int					exponent = 0;
+
+	if ( p < _end && ( *p == '-' || *p == '+' ) )
+	{
+		neg = ( *p == '-' );
+		p++;
+	}
+
+	/* Integer part : the digits after the 19th are not stored but still count in the exponent. */
+	for ( ; p < _end && (unsigned)( *p - '0' ) <= 9 ; p++ )
+	{
+		any = true;
+
+		if ( digits < 19 )
+		{
+			mantissa = mantissa * 10 + ( *p - '0' );
+			digits += ( mantissa != 0 );
+		}
+		else
+			exponent++;
+	}
+
+	/* Fractional part. */
+	if ( p < _end && *p == '.' )
+	{
+		for ( p++ ; p < _end && (unsigned)( *p - '0' ) <= 9 ; p++ )
+		{
+			any = true;
+
+			if ( digits < 19 )
+			{
+				mantissa = mantissa * 10 + ( *p - '0' );
+				digits += ( mantissa != 0 );
+				exponent--;
+			}
+		}
+	}
+
+	if ( ! any )
+		return false;
+
+	/* Exponent part : saturated, any exponent past 100000 gives an infinity or a zero anyway. */
+	if ( p < _end && ( *p == 'e' || *p == 'E' ) )
+	{
+		const char*	q = p + 1;
+		bool		eNeg = false;
+		int			e = 0;
+
+		if ( q < _end && ( *q == '-' || *q == '+' ) )
+		{
+			eNeg = ( *q == '-' );
+			q++;
+		}
+
+		if ( q < _end && (unsigned)( *q - '0' ) <= 9 )
+		{
+			for ( ; q < _end && (unsigned)( *q - '0' ) <= 9 ; q++ )
+				if ( e < 100000 )
+					e = e * 10 + ( *q - '0' );
+
+			exponent += eNeg ? -e : e;
+			p = q;
+		}
+	}
+
+	double value;
+
+	if ( digits <= 15 && exponent >= -22 && exponent <= 22 )
+	{
+		/* The mantissa and the power of ten are both exact doubles : a single rounding, the result is exact. */
+		value = (double)mantissa;
+		value = ( exponent < 0 ) ? value / pow10[-exponent] : value * pow10[exponent];
+	}
+
+	/* The mantissa is lower than 1e19 : out of these exponents the number is out of the range of the doubles. */
+	else if ( mantissa == 0 || exponent < -400 )
+		value = 0;
+
+	else if ( exponent > 400 )
+		value = HUGE_VAL;
+
+	else
+	{
+		/* Rare case (more than 15 digits or huge exponent) : strtod gives the correctly rounded value.
+		   The text is not null terminated, the number is copied, on the heap if it does not fit in the buffer (every digit counts for the rounding). */
+		char	buffer[64];
+		size_t	length = p - _p;
+
+		if ( length < sizeof( buffer ) )
+		{
+			memcpy( buffer, _p, length );
+			buffer[length] = '\0';
+			value = fabs( strtod( buffer, NULL ) );
+		}
+		else
+			value = fabs( strtod( string( _p, p ).c_str(), NULL ) );
+	}
+
+	_value = neg ? -value : value;
+	_p = p;
+
+	return true;
+}
+
+/*!
+*  \brief NON MEMBER FUNCTION : Parses a wavefront ".obj" text.
+*
+*  Parses the vertex ("v x y z") and face ("f i j k ...") lines of a wavefront ".obj" text and gives them to a consumer.
+*  The consumer is any object with the following methods :
+*  \li \c vertex ( double _x, double _y, double _z ) : called for each vertex line.
+*  \li \c beginFace () : called at the beginning of each face line.
+*  \li \c faceIndex ( int _i ) : called for each vertex index of the face, as written in the file (from 1, negative if relative).
+*  \li \c endFace () : called at the end of each face line.
+*
+*  The texture and normal indices of the faces ("f 1/1/1 ...") are skipped, as every other type of line (comments, "vn", "vt", "g", ...).
+*  The text does not have to end with an end of line character and the lines can have any length.
+*  The parsing can start and stop on any line boundaries : it is used on chunks of a file as well as on a whole file.
+*
+*  \param _begin : first character of the text.
+*  \param _end : end of the text.
+*  \param _c : consumer of the vertices and faces.
+*
+*  \return (const char*) Returns NULL if the text has been successfully parsed, the beginning of the faulty line else.
+*/
+template < class Consumer >
+const char* parser_parseOBJ ( const char* _begin, const char* _end, Consumer& _c )
+{
+	const char* p = _begin;
+
+	while ( p < _end )
+	{
+		const char* line = p;
+
+		parser_skipBlanks( p, _end );
+
+		if ( _end - p > 1 && ( p[1] == ' ' || p[1] == '\t' ) )
+		{
+			if ( p[0] == 'v' )
+			{
+				double x, y, z;
+
+				p += 2;
+				parser_skipBlanks( p, _end );
+				if ( ! parser_readDouble( p, _end, x ) )
+					return line;
+				parser_skipBlanks( p, _end );
+				if ( ! parser_readDouble( p, _end, y ) )
+					return line;
+				parser_skipBlanks( p, _end );
+				if ( ! parser_readDouble( p, _end, z ) )
+					return line;
+
+				_c.vertex( x, y, z );
+			}
+
+			else if ( p[0] == 'f' )
+			{
+				p += 2;
+				_c.beginFace();
+
+				for ( ; ; )
+				{
+					int i;
+
+					parser_skipBlanks( p, _end );
+					if ( p == _end || *p == '\n' || *p == '#' )
+						break;
+
+					if ( ! parser_readInt( p, _end, i ) )
+						return line;
+					_c.faceIndex( i );
+
+					/* Skipping the texture and normal indices of the vertex. */
+					while ( p < _end && *p == '/' )
+					{
+						p++;
+						parser_readInt( p, _end, i );
+					}
+				}
+
+				_c.endFace();
+			}
+		}
+
+		parser_nextLine( p, _end );
+	}
+
+	return NULL;
+}
+
+/*!
+*  \brief NON MEMBER FUNCTION : Streams the lines of a file.
+*
+*  Reads the stream _in block after block and calls _f ( begin, end ) on the complete lines of each block :
+*  the memory used does not depend on the size of the file (one block, grown only for a line longer than a block).
+*
+*  \param _in : opened stream to read (compressed or not).
+*  \param _f : function to call on the lines, as const char* _f ( const char* _begin, const char* _end ) : returns NULL, or the position of an error.
+*  \param _errorLine : will contain the number (from 1) of the line where _f has found an error, 0 if the error is a read error.
+*  \param _blockSize : size in bytes of the blocks read.
+*
+*  \return (int) Returns 1 if the whole stream has been read, -1 if it can not be read or _f has found an error.
+*/
+template < class Func >
+int parser_streamLines ( InputStream& _in, Func _f, int& _errorLine, size_t _blockSize = 1 << 20 )
+{
+	vector<char>	block( max( _blockSize, (size_t)64 ) );
+	size_t			kept = 0;
+	int				line = 1;
+
+	_errorLine = 0;
+
+	while ( true )
+	{
+		/* A line longer than the block : the block grows. */
+		if ( kept == block.size() )
+			block.resize( 2 * block.size() );
+
+		size_t		n = _in.read( block.data() + kept, block.size() - kept );
+		bool		last = ( n == 0 );
+		const char*	begin = block.data();
+		const char*	end = begin + kept + n;
+		const char*	stop = end;
+
+		if ( last && _in.hasFailed() )
+			return -1;
+
+		/* Only the complete lines are given, the beginning of the last one is kept for the next block. */
+		if ( !last )
+		{
+			while ( stop > begin && stop[-1] != '\n' )
+				stop--;
+
+			if ( stop == begin )
+			{
+				kept = end - begin;
+				continue;
+			}
+		}
+
+		const char* error = _f( begin, stop );
+
+		if ( error != NULL )
+		{
+			_errorLine = line + (int)count( begin, error, '\n' );
+			return -1;
+		}
+
+		if ( last )
+			break;
+
+		line += (int)count( begin, stop, '\n' );
+		kept = end - stop;
+		memmove( block.data(), stop, kept );
+	}
+
+	return 1;
+}
+
+/*!
+*  \brief NON MEMBER FUNCTION : Streams a wavefront ".obj" file.
+*
+*  Reads the file _path block after block and gives its content to the consumer _c, as parser_parseOBJ does (same callbacks, in the same order) :
+*  the file is read in a single pass and the memory used does not depend on its size (see parser_streamLines).
+*  A gzip compressed file is decompressed on the fly, by a second thread (see InputStream).
+*  The consumer decides what it keeps.
+*
+*  \param _path : location on the disk of the file to read.
+*  \param _c : consumer of the vertices and faces (see parser_parseOBJ).
+*  \param _errorLine : will contain the number (from 1) of the line that can not be read, 0 if the error is not a syntax error.
+*  \param _blockSize : size in bytes of the blocks read.
+*
+*  \return (int) Returns 1 if the whole file has been read, -1 if it can not be read or contains a syntax error.
+*/
+template < class Consumer >
+int parser_streamOBJ ( const char* _path, Consumer& _c, int& _errorLine, size_t _blockSize = 1 << 20 )
+{
+	InputStream in;
+
+	_errorLine = 0;
+
+	if ( in.open( _path ) == -1 )
+		return -1;
+
+	return parser_streamLines( in, [&_c] ( const char* _begin, const char* _end ) { return parser_parseOBJ( _begin, _end, _c ); }, _errorLine, _blockSize );
+}
+
+class ObjBuffer
+{
+	/*!
+	 * \class ObjBuffer
+	 * \brief Classe représentant le contenu d'un fichier ".obj" sous forme de tableaux : consommateur de parser_parseOBJ.
+	 *
+	 * Les positions des sommets sont rangees a la suite (x, y, z) et les faces sont stockees comme un tableau d'indices (a partir de 0)
+	 * decoupe par un tableau de debuts : la face i est formee des indices [faceStarts[i], faceStarts[i+1]).
+	 * Ces tableaux grandissent par doublement : la lecture d'une ligne n'alloue rien.
+	 *
+	 */
+
+	public :
+		vector<double>	positions;		/*! <Location of the vertices, three values per vertex.*/
+		vector<int>		faceStarts;		/*! <Index in the indices array of the first vertex of each face, plus the total number of indices.*/
+		vector<int>		indices;		/*! <Index (from 0) of the vertices of the faces, -1 for an invalid index.*/
+
+		/*!
+		*  \brief Default constructor of the ObjBuffer class.
+		*
+		*  Default constructor of the ObjBuffer class : the buffer is empty.
+		*/
+		ObjBuffer()
+		{
+			faceStarts.assign( 1, 0 );
+		}
+
+		/*!
+		*  \brief Getter of the ObjBuffer class.
+		*
+		*  Getter of the ObjBuffer class.
+		*
+		*  \return (int) returns the number of vertices read.
+		*/
+		int getNVerts () const
+		{
+			return (int)( positions.size() / 3 );
+		}
+
+		/*!
+		*  \brief Getter of the ObjBuffer class.
+		*
+		*  Getter of the ObjBuffer class.
+		*
+		*  \return (int) returns the number of faces read.
+		*/
+		int getNFaces () const
+		{
+			return (int)faceStarts.size() - 1;
+		}
+
+		/*!
+		*  \brief Consumer method : adds a vertex.
+		*
+		*  The coordinates are stored as float numbers, just like the first loader of the library did : the meshes loaded do not depend on the loader used.
+		*
+		*  \return (void)
+		*/
+		void vertex ( double _x, double _y, double _z )
+		{
+			positions.push_back( (float)_x );
+			positions.push_back( (float)_y );
+			positions.push_back( (float)_z );
+		}
+
+		/*!
+		*  \brief Consumer method : begins a face.
+		*
+		*  \return (void)
+		*/
+		void beginFace ()
+		{
+		}
+
+		/*!
+		*  \brief Consumer method : adds a vertex index to the current face.
+		*
+		*  The relative indices (negative) are resolved with the number of vertices read so far.
+		*
+		*  \return (void)
+		*/
+		void faceIndex ( int _i )
+		{
+			if ( _i > 0 )
+				indices.push_back( _i - 1 );
+			else if ( _i < 0 )
+				indices.push_back( this->getNVerts() + _i );
+			else
+				indices.push_back( -1 );
+		}
+
+		/*!
+		*  \brief Consumer method : ends the current face.
+		*
+		*  The faces with less than three vertices are dropped.
+		*
+		*  \return (void)
+		*/
+		void endFace ()
+		{
+			if ( (int)indices.size() - faceStarts.back() < 3 )
+				indices.resize( faceStarts.back() );
+			else
+				faceStarts.push_back( (int)indices.size() );
+		}
+};
+
+class ObjChunk : public ObjBuffer
+{
+	/*!
+	 * \class ObjChunk
+	 * \brief Classe représentant le contenu d'un morceau de fichier ".obj" : consommateur de parser_parseOBJ pour le chargement parallele.
+	 *
+	 * Un morceau ne connait pas le nombre de sommets lus dans les morceaux qui le precedent : les indices relatifs (negatifs)
+	 * ne peuvent pas etre resolus pendant la lecture. Ils sont ranges relativement au premier sommet du morceau
+	 * et leurs positions sont notees pour etre corrigees lors de la fusion des morceaux.
+	 *
+	 */
+
+	public :
+		vector<int>		relative;		/*! <Position in the indices array of the indices that are relative to the first vertex of the chunk.*/
+
+		/*!
+		*  \brief Consumer method : adds a vertex index to the current face.
+		*
+		*  The absolute indices are stored from 0, the relative ones from the first vertex of the chunk.
+		*
+		*  \return (void)
+		*/
+		void faceIndex ( int _i )
+		{
+			if ( _i < 0 )
+			{
+				relative.push_back( (int)indices.size() );
+				indices.push_back( this->getNVerts() + _i );
+			}
+			else
+				ObjBuffer::faceIndex( _i );
+		}
+
+		/*!
+		*  \brief Consumer method : ends the current face.
+		*
+		*  The faces with less than three vertices are dropped, with their relative indices.
+		*
+		*  \return (void)
+		*/
+		void endFace ()
+		{
+			ObjBuffer::endFace();
+
+			while ( ! relative.empty() && relative.back() >= (int)indices.size() )
+				relative.pop_back();
+		}
+};
+
+#endif
@@ -0,0 +1,243 @@
+#ifndef PLY_H
+#define PLY_H
+
+/**
+ * \file	ply.h
+ * \brief	Declaration de la classe PlyHeader (en-tete d'un fichier ".ply") et des outils de lecture/ecriture des valeurs binaires.
+ */
+
+/* ____________________________ STD Librairies ___ */
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstddef>
+
+using namespace std;
+
+/*! \def PLY_ASCII
+  format of a ".ply" file : text body.
+ */
+#define PLY_ASCII 0
+
+/*! \def PLY_BINARY_LE
+  format of a ".ply" file : little endian binary body.
+ */
+#define PLY_BINARY_LE 1
+
+/*! \def PLY_BINARY_BE
+  format of a ".ply" file : big endian binary body.
+ */
+#define PLY_BINARY_BE 2
+
+/* Scalar types of the ".ply" properties. */
+#define PLY_CHAR	0
+#define PLY_UCHAR	1
+#define PLY_SHORT	2
+#define PLY_USHORT	3
+#define PLY_INT		4
+#define PLY_UINT	5
+#define PLY_FLOAT	6
+#define PLY_DOUBLE	7
+
+/*!
+*  \brief NON MEMBER FUNCTION : Size of a ".ply" scalar type.
+*
+*  \param _type : one of the PLY_CHAR, ..., PLY_DOUBLE types.
+*
+*  \return (int) Returns the size in bytes of a value of the type.
+*/
+inline int ply_typeSize ( int _type )
+{
+	static const int sizes[] = { 1, 1, 2, 2, 4, 4, 4, 8 };
+
+	return sizes[_type];
+}
+
+/*!
+*  \brief NON MEMBER FUNCTION : Byte order of the computer.
+*
+*  \return (bool) Returns true if the computer stores the numbers in little endian order.
+*/
+inline bool ply_littleEndianHost ()
+{
+	unsigned int one = 1;
+
+	return *(unsigned char*)&one == 1;
+}
+
+/*!
+*  \brief NON MEMBER FUNCTION : Copies a little endian value.
+*
+*  Copies the _size bytes of a little endian value to the native order (or the opposite, the operation being symmetric).
+*  The source does not have to be aligned.
+*
+*  \param _dst : destination of the value.
+*  \param _src : source of the value.
+*  \param _size : size of the value in bytes.
+*
+*  \return (void)
+*/
+inline void ply_copyLE ( void* _dst, const void* _src, int _size )
+{
+	if ( ply_littleEndianHost() )
+		memcpy( _dst, _src, _size );
+	else
+		for ( int i = 0 ; i < _size ; i++ )
+			( (unsigned char*)_dst )[i] = ( (const unsigned char*)_src )[ _size-1-i ];
+}
+
+/*!
+*  \brief NON MEMBER FUNCTION : Reads a little endian binary value.
+*
+*  \param _p : position of the value, it does not have to be aligned.
+*  \param _type : type of the value (PLY_CHAR, ..., PLY_DOUBLE).
+*
+*  \return (double) Returns the value read.
+*/
+inline double ply_readValue ( const char* _p, int _type )
+{
+	switch ( _type )
+	{
+		case PLY_CHAR :		return (double)*(const signed char*)_p;
+		case PLY_UCHAR :	return (double)*(const unsigned char*)_p;
+		case PLY_SHORT :	{ short v;			ply_copyLE( &v, _p, 2 );	return v; }
+		case PLY_USHORT :	{ unsigned short v;	ply_copyLE( &v, _p, 2 );	return v; }
+		case PLY_INT :		{ int v;			ply_copyLE( &v, _p, 4 );	return v; }
+		case PLY_UINT :		{ unsigned int v;	ply_copyLE( &v, _p, 4 );	return v; }
+		case PLY_FLOAT :	{ float v;			ply_copyLE( &v, _p, 4 );	return v; }
+		default :			{ double v;			ply_copyLE( &v, _p, 8 );	return v; }
+	}
+}
+
+/*!
+ * \struct PlyProperty
+ * \brief Propriete d'un element ".ply" : une valeur scalaire ou une liste de valeurs precedee de sa taille.
+ */
+struct PlyProperty
+{
+	string	name;				/*! <Name of the property.*/
+	int		type;				/*! <Type of the value, or of the items of the list.*/
+	int		countType;			/*! <Type of the size of the list, -1 for a scalar property.*/
+
+	/*!
+	*  \brief Skips a binary value of the property.
+	*
+	*  \param _p : beginning of the value.
+	*  \param _end : end of the file.
+	*
+	*  \return (const char*) Returns the position after the value, NULL if the value goes beyond the end of the file.
+	*/
+	const char* skip ( const char* _p, const char* _end ) const;
+};
+
+/*!
+ * \struct PlyElement
+ * \brief Element ".ply" (par exemple "vertex" ou "face") : un nombre de lignes ayant toutes les memes proprietes.
+ */
+struct PlyElement
+{
+	string				name;		/*! <Name of the element.*/
+	int					count;		/*! <Number of rows of the element.*/
+	vector<PlyProperty>	properties;	/*! <Properties of a row, in the order of the file.*/
+
+	/*!
+	*  \brief Finds a property of the element.
+	*
+	*  \param _name : name of the property.
+	*
+	*  \return (int) Returns the index of the property, -1 if the element does not have it.
+	*/
+	int findProperty ( const char* _name ) const;
+
+	/*!
+	*  \brief Size of a binary row.
+	*
+	*  \return (int) Returns the size in bytes of a row of the element, -1 if it has a list property (its rows have different sizes).
+	*/
+	int getRowSize () const;
+
+	/*!
+	*  \brief Skips a binary row.
+	*
+	*  \param _p : beginning of the row.
+	*  \param _end : end of the file.
+	*
+	*  \return (const char*) Returns the beginning of the next row, NULL if the row goes beyond the end of the file.
+	*/
+	const char* skipRow ( const char* _p, const char* _end ) const;
+};
+
+class PlyHeader
+{
+	/*!
+	 * \class PlyHeader
+	 * \brief Classe représentant l'en-tete d'un fichier ".ply" : son format et la description de ses elements.
+	 *
+	 * L'en-tete est lu directement dans le fichier projete en memoire ; le corps du fichier commence juste apres (getSize octets).
+	 * Pour les specifications du format, voir http://paulbourke.net/dataformats/ply/.
+	 *
+	 */
+
+	private :
+		int					format;		/*! <Format of the body : PLY_ASCII, PLY_BINARY_LE or PLY_BINARY_BE.*/
+		vector<PlyElement>	elements;	/*! <Elements of the file, in the order of the file.*/
+		size_t				size;		/*! <Size of the header in bytes : the body begins at this offset.*/
+
+	public :
+		/*!
+		*  \brief Default constructor of the PlyHeader class.
+		*
+		*  Default constructor of the PlyHeader class : no element.
+		*/
+		PlyHeader();
+
+		/*!
+		*  \brief Reads a header.
+		*
+		*  Reads the header at the beginning of the _data array, up to the "end_header" line.
+		*
+		*  \param _data : content of the file.
+		*  \param _size : size of the file in bytes.
+		*
+		*  \return (int) Returns 1 if the header is correct, -1 else.
+		*/
+		int read ( const char* _data, size_t _size );
+
+		/*!
+		*  \brief Getter of the PlyHeader class.
+		*
+		*  Getter of the PlyHeader class.
+		*
+		*  \return (int) returns the format of the body (PLY_ASCII, PLY_BINARY_LE or PLY_BINARY_BE).
+		*/
+		int getFormat () const;
+
+		/*!
+		*  \brief Getter of the PlyHeader class.
+		*
+		*  Getter of the PlyHeader class.
+		*
+		*  \return (size_t) returns the size of the header in bytes.
+		*/
+		size_t getSize () const;
+
+		/*!
+		*  \brief Getter of the PlyHeader class.
+		*
+		*  Getter of the PlyHeader class.
+		*
+		*  \return (const vector<PlyElement>&) returns the elements of the file.
+		*/
+		const vector<PlyElement>& getElements () const;
+
+		/*!
+		*  \brief Finds an element.
+		*
+		*  \param _name : name of the element.
+		*
+		*  \return (int) Returns the index of the element, -1 if the file does not have it.
+		*/
+		int findElement ( const char* _name ) const;
+};
+
+#endif
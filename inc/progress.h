@@ -0,0 +1,77 @@
+#ifndef PROGRESS_H
+#define PROGRESS_H
+
+/**
+ * \file	progress.h
+ * \brief	Definition de la structure LoadProgress, avancement d'un chargement partage entre le thread qui charge et celui qui l'observe.
+ */
+
+/* ____________________________ STD Librairies ___ */
+#include <atomic>
+
+using namespace std;
+
+/*! \def LOAD_WAITING
+  stage of a loading : not started yet.
+ */
+#define LOAD_WAITING 0
+
+/*! \def LOAD_PARSING
+  stage of a loading : the file is being read.
+ */
+#define LOAD_PARSING 1
+
+/*! \def LOAD_BUILDING
+  stage of a loading : the half edge structure is being built.
+ */
+#define LOAD_BUILDING 2
+
+/*! \def LOAD_PROCESSING
+  stage of a loading : the mesh is built, its normals are being computed (or it is being normalized).
+ */
+#define LOAD_PROCESSING 3
+
+/*! \def LOAD_DONE
+  stage of a loading : finished (successfully or not).
+ */
+#define LOAD_DONE 4
+
+/*!
+ * \struct LoadProgress
+ * \brief Avancement d'un chargement : mis a jour par le thread qui charge, lu (et annule) par n'importe quel autre thread.
+ */
+struct LoadProgress
+{
+	atomic<int>			stage;			/*! <Stage of the loading (LOAD_WAITING, LOAD_PARSING, ...).*/
+	atomic<long long>	bytesRead;		/*! <Number of bytes of the file read so far.*/
+	atomic<long long>	bytesTotal;		/*! <Size of the file in bytes, 0 if it is not known (compressed file).*/
+	atomic<long long>	facesRead;		/*! <Number of faces read in the file so far.*/
+	atomic<long long>	facesBuilt;		/*! <Number of faces of the half edge structure built so far.*/
+	atomic<bool>		cancelled;		/*! <Set to true to ask the loading to stop as soon as possible.*/
+
+	/*!
+	*  \brief Default constructor of the LoadProgress structure.
+	*
+	*  Default constructor of the LoadProgress structure : nothing is read yet.
+	*/
+	LoadProgress() : stage( LOAD_WAITING ), bytesRead( 0 ), bytesTotal( 0 ), facesRead( 0 ), facesBuilt( 0 ), cancelled( false ) {}
+
+	/*!
+	*  \brief Resets the progress.
+	*
+	*  Resets the progress before a new loading : nothing is read yet and the loading is not cancelled.
+	*
+	*  \return (void)
+	*/
+	void reset ()
+	{
+		stage = LOAD_WAITING;
+		bytesRead = 0;
+		bytesTotal = 0;
+		facesRead = 0;
+		facesBuilt = 0;
+		cancelled = false;
+	}
+};
+
+#endif
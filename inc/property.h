@@ -0,0 +1,385 @@
+#ifndef PROPERTY_H
+#define PROPERTY_H
+
+/**
+ * \file	property.h
+ * \brief	Declaration des proprietes des elements d'un maillage : BaseProperty, Property (un tableau type et nomme) et PropertySet (les proprietes d'un type d'element).
+ */
+
+/* ______________________________ My includes ____ */
+#include "range.h"
+
+/* ____________________________ STD Librairies ___ */
+#include <string>
+#include <vector>
+#include <type_traits>
+#include <algorithm>
+
+using namespace std;
+
+class BaseProperty
+{
+	/*!
+	 * \class BaseProperty
+	 * \brief Classe représentant une propriete des elements d'un maillage, quel que soit le type de ses valeurs.
+	 *
+	 * C'est l'interface dont le maillage a besoin pour garder ses proprietes a la taille de ses tableaux d'elements, et pour les copier.
+	 *
+	 */
+
+	private :
+		string	name;			/*! <Name of the property, unique among the properties of the same elements.*/
+
+	public :
+		/*!
+		*  \brief Constructor of the BaseProperty class.
+		*
+		*  \param _name : name of the property.
+		*/
+		BaseProperty( const string& _name ) : name( _name ) {}
+
+		/*!
+		*  \brief Destructor of the BaseProperty class.
+		*/
+		virtual ~BaseProperty() {}
+
+		/*!
+		*  \brief Getter of the BaseProperty class.
+		*
+		*  \return (const string&) returns the name of the property.
+		*/
+		const string& getName () const { return name; }
+
+		/*!
+		*  \brief Resizes the property.
+		*
+		*  Resizes the property : the new values are set to the default value of the property.
+		*
+		*  \param _size : number of elements.
+		*
+		*  \return (void)
+		*/
+		virtual void resize ( int _size ) = 0;
+
+		/*!
+		*  \brief Reserves the memory of the property.
+		*
+		*  \param _size : number of elements to reserve the memory for.
+		*
+		*  \return (void)
+		*/
+		virtual void reserve ( int _size ) = 0;
+
+		/*!
+		*  \brief Empties the property and frees its memory.
+		*
+		*  \return (void)
+		*/
+		virtual void clear () = 0;
+
+		/*!
+		*  \brief Reorders the values of the property.
+		*
+		*  Reorders the values of the property, which then has one value per item of _order.
+		*
+		*  \param _order : for each new ID, the old ID of the element whose value it takes (-1 for the default value of the property).
+		*
+		*  \return (void)
+		*/
+		virtual void permute ( const vector<int>& _order ) = 0;
+
+		/*!
+		*  \brief Copies the property.
+		*
+		*  \return (BaseProperty*) returns a new property with the same name and values, to be deleted by the caller.
+		*/
+		virtual BaseProperty* clone () const = 0;
+
+		/*!
+		*  \brief Copies the values of another property.
+		*
+		*  \param _p : property to copy, its name is not checked.
+		*
+		*  \return (int) returns 1 if the values (and the default value) of _p were copied, -1 if its values do not have the same type (nothing is changed).
+		*/
+		virtual int assign ( const BaseProperty* _p ) = 0;
+
+		/*!
+		*  \brief Takes the values of another property.
+		*
+		*  \param _p : property whose values are taken without being copied, it is left with the old values of this one.
+		*
+		*  \return (int) returns 1 if the values (and the default value) of _p were taken, -1 if its values do not have the same type (nothing is changed).
+		*/
+		virtual int take ( BaseProperty* _p ) = 0;
+};
+
+template < class T >
+class Property : public BaseProperty
+{
+	/*!
+	 * \class Property
+	 * \brief Classe représentant une propriete typee des elements d'un maillage : une valeur de type T par element, rangees dans un tableau contigu.
+	 *
+	 * Les valeurs sont indexees par l'ID des elements : p[ v.getID() ]. Le maillage redimensionne la propriete quand des elements sont ajoutes.
+	 * Pour des booleens, prendre des char : le vector<bool> de la STL ne range pas ses valeurs dans un tableau, Property<bool> ne compile pas.
+	 *
+	 */
+
+	static_assert( !is_same<T, bool>::value, "Property<bool> is not supported (vector<bool> has no array of values) : use Property<char> or Property<unsigned char>" );
+
+	private :
+		vector<T>	values;			/*! <Values of the elements.*/
+		T			defaultValue;	/*! <Value of the new elements.*/
+
+	public :
+		/*!
+		*  \brief Constructor of the Property class.
+		*
+		*  \param _name : name of the property.
+		*  \param _default : value of the new elements.
+		*/
+		Property( const string& _name, const T& _default = T() ) : BaseProperty( _name ), defaultValue( _default ) {}
+
+		/*!
+		*  \brief Access operator of the Property class.
+		*
+		*  \param _i : ID of the element.
+		*
+		*  \return (T&) returns the value of the element.
+		*/
+		T& operator[] ( int _i ) { return values[_i]; }
+
+		/*!
+		*  \brief Access operator of the Property class.
+		*
+		*  \param _i : ID of the element.
+		*
+		*  \return (const T&) returns the value of the element.
+		*/
+		const T& operator[] ( int _i ) const { return values[_i]; }
+
+		/*!
+		*  \brief Getter of the Property class.
+		*
+		*  \return (int) returns the number of elements.
+		*/
+		int getSize () const { return (int)values.size(); }
+
+		/*!
+		*  \brief Getter of the Property class.
+		*
+		*  \return (T*) returns the value of the first element, the other ones follow.
+		*/
+		T* getData () { return values.data(); }
+
+		/*!
+		*  \brief Getter of the Property class.
+		*
+		*  \return (ArrayView<T>) returns a view on the values, nothing is copied.
+		*/
+		ArrayView<T> getView () const { return ArrayView<T>( values.data(), values.size() ); }
+
+		/*!
+		*  \brief Setter of the Property class.
+		*
+		*  Sets every element of the property to the same value.
+		*
+		*  \param _value : value to affect to every element.
+		*
+		*  \return (void)
+		*/
+		void fill ( const T& _value ) { values.assign( values.size(), _value ); }
+
+		void resize ( int _size ) { values.resize( _size, defaultValue ); }
+
+		void reserve ( int _size ) { values.reserve( _size ); }
+
+		void clear () { vector<T>().swap( values ); }
+
+		void permute ( const vector<int>& _order )
+		{
+			vector<T> tmp( _order.size() );
+			for ( int i = 0 ; i < (int)_order.size() ; i++ )
+				tmp[i] = ( _order[i] == -1 ) ? defaultValue : values[ _order[i] ];
+			values.swap( tmp );
+		}
+
+		BaseProperty* clone () const { return new Property<T>( *this ); }
+
+		int assign ( const BaseProperty* _p )
+		{
+			const Property<T>* p = dynamic_cast< const Property<T>* >( _p );
+			if ( p == NULL )
+				return -1;
+			values = p->values;
+			defaultValue = p->defaultValue;
+			return 1;
+		}
+
+		int take ( BaseProperty* _p )
+		{
+			Property<T>* p = dynamic_cast< Property<T>* >( _p );
+			if ( p == NULL )
+				return -1;
+			values.swap( p->values );
+			defaultValue = p->defaultValue;
+			return 1;
+		}
+};
+
+class PropertySet
+{
+	/*!
+	 * \class PropertySet
+	 * \brief Classe représentant les proprietes d'un type d'elements d'un maillage (sommets, demi-aretes ou faces).
+	 *
+	 * Toutes les proprietes ont le nombre d'elements de l'ensemble. Elles sont detruites avec lui, et copiees avec lui.
+	 * Le nom n'est utilise que pour trouver une propriete : on garde ensuite son pointeur, qui reste valide tant qu'elle n'est pas supprimee.
+	 * Une affectation garde les proprietes qui ont le meme nom et le meme type dans les deux ensembles (seules leurs valeurs changent) : leurs pointeurs restent valides.
+	 *
+	 */
+
+	private :
+		vector<BaseProperty*>	properties;		/*! <Properties of the elements, owned by the set.*/
+		int						size;			/*! <Number of elements.*/
+
+		/*!
+		*  \brief Replaces the properties of the set.
+		*
+		*  \param _kept : new properties of the set, the old ones which are not among them are deleted.
+		*
+		*  \return (void)
+		*/
+		void replace ( vector<BaseProperty*>& _kept );
+
+	public :
+		/*!
+		*  \brief Default constructor of the PropertySet class.
+		*
+		*  Default constructor of the PropertySet class : the set has no property and no element.
+		*/
+		PropertySet();
+
+		/*!
+		*  \brief Copy constructor of the PropertySet class.
+		*
+		*  Copy constructor of the PropertySet class : every property is copied.
+		*/
+		PropertySet( const PropertySet& _s );
+
+		/*!
+		*  \brief Move constructor of the PropertySet class.
+		*
+		*  Move constructor of the PropertySet class : the properties of _s are taken, _s is left without any property.
+		*/
+		PropertySet( PropertySet&& _s );
+
+		/*!
+		*  \brief Destructor of the PropertySet class.
+		*
+		*  Destructor of the PropertySet class : every property is deleted.
+		*/
+		~PropertySet();
+
+		/*!
+		*  \brief Affectation operator of the PropertySet class.
+		*
+		*  Affectation operator of the PropertySet class : every property is copied.
+		*  A property with the same name and type in both sets is kept and takes the values of _s, the other properties of the set are deleted.
+		*/
+		PropertySet& operator= ( const PropertySet& _s );
+
+		/*!
+		*  \brief Move affectation operator of the PropertySet class.
+		*
+		*  Move affectation operator of the PropertySet class : the properties of _s are taken, _s is left without any property.
+		*  A property with the same name and type in both sets is kept and takes the values of _s, the other properties of the set are deleted.
+		*/
+		PropertySet& operator= ( PropertySet&& _s );
+
+		/*!
+		*  \brief Getter of the PropertySet class.
+		*
+		*  \return (int) returns the number of properties.
+		*/
+		int getNProperties () const;
+
+		/*!
+		*  \brief Getter of the PropertySet class.
+		*
+		*  \param _i : index of the property.
+		*
+		*  \return (BaseProperty*) returns the ith property.
+		*/
+		BaseProperty* getIProperty ( int _i ) const;
+
+		/*!
+		*  \brief Finds a property.
+		*
+		*  \param _name : name of the property.
+		*
+		*  \return (BaseProperty*) returns the property, NULL if there is none with this name.
+		*/
+		BaseProperty* find ( const string& _name ) const;
+
+		/*!
+		*  \brief Adds a property.
+		*
+		*  Adds a property to the set, which takes it (it will delete it) and resizes it to the number of elements.
+		*
+		*  \param _p : property to add, allocated with new.
+		*
+		*  \return (int) Returns 1 if the property was added, -1 if there already is a property with the same name (_p is not taken).
+		*/
+		int add ( BaseProperty* _p );
+
+		/*!
+		*  \brief Removes a property.
+		*
+		*  \param _name : name of the property.
+		*
+		*  \return (int) Returns 1 if the property was removed (and deleted), -1 if there is none with this name.
+		*/
+		int remove ( const string& _name );
+
+		/*!
+		*  \brief Resizes every property.
+		*
+		*  \param _size : number of elements.
+		*
+		*  \return (void)
+		*/
+		void resize ( int _size );
+
+		/*!
+		*  \brief Reserves the memory of every property.
+		*
+		*  \param _size : number of elements to reserve the memory for.
+		*
+		*  \return (void)
+		*/
+		void reserve ( int _size );
+
+		/*!
+		*  \brief Empties every property.
+		*
+		*  Empties every property and frees its memory : the properties are kept, without any element.
+		*
+		*  \return (void)
+		*/
+		void clear ();
+
+		/*!
+		*  \brief Reorders the values of every property.
+		*
+		*  Reorders the values of every property, the set then has one element per item of _order.
+		*
+		*  \param _order : for each new ID, the old ID of the element whose values it takes (-1 for the default values of the properties).
+		*
+		*  \return (void)
+		*/
+		void permute ( const vector<int>& _order );
+};
+
+#endif
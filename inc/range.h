@@ -0,0 +1,144 @@
+#ifndef RANGE_H
+#define RANGE_H
+
+/**
+ * \file	range.h
+ * \brief	Declaration des vues sans copie : ArrayView (tableau contigu en lecture) et IndexRange (suite d'elements d'un maillage).
+ */
+
+/* ____________________________ STD Librairies ___ */
+#include <cstddef>
+
+using namespace std;
+
+class Mesh;
+
+template < class T >
+class ArrayView
+{
+	/*!
+	 * \class ArrayView
+	 * \brief Classe représentant une vue en lecture sur un tableau contigu : un pointeur et une taille, rien n'est copie.
+	 *
+	 * La vue reste valide tant que le tableau qu'elle regarde n'est ni modifie ni detruit.
+	 * Elle s'utilise comme un tableau (operator[], getSize) ou dans une boucle for sur un intervalle.
+	 *
+	 */
+
+	private :
+		const T*	data;			/*! <First value of the array.*/
+		size_t		size;			/*! <Number of values of the array.*/
+
+	public :
+		/*!
+		*  \brief Constructor of the ArrayView class.
+		*
+		*  \param _data : first value of the array.
+		*  \param _size : number of values of the array.
+		*/
+		ArrayView( const T* _data, size_t _size ) : data( _data ), size( _size ) {}
+
+		/*!
+		*  \brief Getter of the ArrayView class.
+		*
+		*  \return (size_t) returns the number of values.
+		*/
+		size_t getSize () const { return size; }
+
+		/*!
+		*  \brief Getter of the ArrayView class.
+		*
+		*  \return (const T*) returns the first value.
+		*/
+		const T* getData () const { return data; }
+
+		/*!
+		*  \brief Access operator of the ArrayView class.
+		*
+		*  \return (const T&) returns the ith value.
+		*/
+		const T& operator[] ( size_t _i ) const { return data[_i]; }
+
+		/*!
+		*  \brief Beginning of the range, for the range-based for loops.
+		*/
+		const T* begin () const { return data; }
+
+		/*!
+		*  \brief End of the range, for the range-based for loops.
+		*/
+		const T* end () const { return data + size; }
+};
+
+template < class H >
+class IndexRange
+{
+	/*!
+	 * \class IndexRange
+	 * \brief Classe représentant les elements d'un maillage d'identifiants consecutifs, parcourus comme des poignees (Vertex, Edge ou Face).
+	 *
+	 * Seuls le maillage et les deux bornes sont gardes : les poignees sont construites au fil du parcours.
+	 *
+	 */
+
+	private :
+		Mesh*	mesh;			/*! <Mesh of the elements.*/
+		int		first;			/*! <ID of the first element.*/
+		int		last;			/*! <ID after the last element.*/
+
+	public :
+		/*!
+		 * \class Iterator
+		 * \brief Position dans un IndexRange.
+		 */
+		class Iterator
+		{
+			private :
+				Mesh*	mesh;	/*! <Mesh of the elements.*/
+				int		id;		/*! <ID of the current element.*/
+
+			public :
+				Iterator( Mesh* _mesh, int _id ) : mesh( _mesh ), id( _id ) {}
+
+				H operator* () const { return H( mesh, id ); }
+
+				Iterator& operator++ () { id++; return *this; }
+
+				bool operator!= ( const Iterator& _i ) const { return id != _i.id; }
+		};
+
+		/*!
+		*  \brief Constructor of the IndexRange class.
+		*
+		*  \param _mesh : mesh of the elements.
+		*  \param _first : ID of the first element.
+		*  \param _last : ID after the last element.
+		*/
+		IndexRange( Mesh* _mesh, int _first, int _last ) : mesh( _mesh ), first( _first ), last( _last ) {}
+
+		/*!
+		*  \brief Getter of the IndexRange class.
+		*
+		*  \return (int) returns the number of elements.
+		*/
+		int getSize () const { return last - first; }
+
+		/*!
+		*  \brief Access operator of the IndexRange class.
+		*
+		*  \return (H) returns the ith element of the range.
+		*/
+		H operator[] ( int _i ) const { return H( mesh, first + _i ); }
+
+		/*!
+		*  \brief Beginning of the range, for the range-based for loops.
+		*/
+		Iterator begin () const { return Iterator( mesh, first ); }
+
+		/*!
+		*  \brief End of the range, for the range-based for loops.
+		*/
+		Iterator end () const { return Iterator( mesh, last ); }
+};
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef SPATIALHASH_H
+#define SPATIALHASH_H
+
+/**
+ * \file	spatialhash.h
+ * \brief	Declaration de la classe SpatialHash, une table de hachage spatiale utilisee pour souder les sommets confondus.
+ */
+
+/* ____________________________ STD Librairies ___ */
+#include <vector>
+#include <unordered_map>
+
+using namespace std;
+
+class SpatialHash
+{
+	/*!
+	 * \class SpatialHash
+	 * \brief Classe représentant un ensemble de points de l'espace dans lequel on recherche les points confondus.
+	 *
+	 * Les points sont ranges dans les cellules d'une grille reguliere dont le cote est la tolerance de soudure ;
+	 * seules les cellules sont stockees (table de hachage), les points d'une cellule formant une liste chainee.
+	 * Un point insere a moins de la tolerance d'un point deja present n'est pas ajoute : on recupere l'indice du point existant.
+	 * Avec une tolerance nulle, seuls les points exactement egaux sont soudes (cas des fichiers STL, ou les sommets partages sont repetes a l'identique).
+	 *
+	 */
+
+	private :
+		double							tolerance;	/*! <Distance under which two points are merged, 0 to merge only the equal points.*/
+		vector<double>					points;		/*! <Location of the points, three values per point.*/
+		vector<int>						next;		/*! <Next point of the same cell, -1 at the end of the list.*/
+		unordered_map<long long, int>	cells;		/*! <First point of each non empty cell.*/
+
+		/*!
+		*  \brief Key of a cell.
+		*
+		*  \param _x : first coordinate of the cell.
+		*  \param _y : second coordinate of the cell.
+		*  \param _z : third coordinate of the cell.
+		*
+		*  \return (long long) returns the key of the cell in the table.
+		*/
+		static long long key ( long long _x, long long _y, long long _z );
+
+		/*!
+		*  \brief Searches a cell.
+		*
+		*  Searches a point of the cell _key that is close enough to (_x, _y, _z).
+		*
+		*  \return (int) returns the index of the point, -1 if there is none.
+		*/
+		int search ( long long _key, double _x, double _y, double _z ) const;
+
+	public :
+		/*!
+		*  \brief Constructor of the SpatialHash class.
+		*
+		*  Constructor of the SpatialHash class : the set is empty.
+		*
+		*  \param _tolerance : distance under which two points are merged, 0 (default) to merge only the equal points.
+		*/
+		SpatialHash( double _tolerance = 0 );
+
+		/*!
+		*  \brief Reserves the memory for a number of points.
+		*
+		*  \param _n : number of points that will be inserted.
+		*
+		*  \return (void)
+		*/
+		void reserve ( int _n );
+
+		/*!
+		*  \brief Inserts a point.
+		*
+		*  Adds the point (_x, _y, _z) to the set, unless a point of the set is close enough to it.
+		*
+		*  \param _x : first coordinate of the point.
+		*  \param _y : second coordinate of the point.
+		*  \param _z : third coordinate of the point.
+		*
+		*  \return (int) returns the index of the point merged with (_x, _y, _z), the index of the new point if there is none.
+		*/
+		int insert ( double _x, double _y, double _z );
+
+		/*!
+		*  \brief Getter of the SpatialHash class.
+		*
+		*  Getter of the SpatialHash class.
+		*
+		*  \return (int) returns the number of points of the set.
+		*/
+		int getSize () const;
+
+		/*!
+		*  \brief Getter of the SpatialHash class.
+		*
+		*  Getter of the SpatialHash class.
+		*
+		*  \return (const vector<double>&) returns the location of the points, three values per point.
+		*/
+		const vector<double>& getPoints () const;
+};
+
+#endif
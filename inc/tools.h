@@ -36,6 +36,73 @@ using namespace std;
 */
 Vector3D tools_crossProduct ( Vector3D _u, Vector3D _v );
 
+/*!
+*  \brief NON MEMBER FUNCTION : Computes the (not normalized) normal of a face corner.
+*
+*  Computes the cross product of the edges [_p0, _p1] and [_p1, _p2] : this is the normal of a face given by its first three vertices
+*  (see Mesh::computeNormals) and its length is twice the area of the triangle (_p0, _p1, _p2).
+*
+*  \param _p0 : first vertex.
+*  \param _p1 : second vertex.
+*  \param _p2 : third vertex.
+*
+*  \return (Vector3D) Returns the cross product of the two edges.
+*/
+Vector3D tools_faceCross ( Vector3D _p0, Vector3D _p1, Vector3D _p2 );
+
+/*!
+*  \brief NON MEMBER FUNCTION : Extends a bounding box.
+*
+*  Extends the box [_bot, _top] so that it contains the point _p.
+*
+*  \param _bot : bottom corner of the box (lowest coordinates).
+*  \param _top : top corner of the box (highest coordinates).
+*  \param _p : point to add to the box.
+*
+*  \return (void)
+*/
+void tools_extendBox ( Vector3D& _bot, Vector3D& _top, Vector3D _p );
+
+/*!
+*  \brief NON MEMBER FUNCTION : Size of a bounding box.
+*
+*  Size of the biggest direction (Ox, Oy or Oz) of the box [_bot, _top] : this is the scale applied by Mesh::normalize.
+*
+*  \param _bot : bottom corner of the box (lowest coordinates).
+*  \param _top : top corner of the box (highest coordinates).
+*
+*  \return (double) Returns the biggest side of the box.
+*/
+double tools_boxSize ( Vector3D _bot, Vector3D _top );
+
+/*!
+*  \brief NON MEMBER FUNCTION : Morton code of a point of a grid.
+*
+*  Computes the Morton code (Z-order) of the cell (_x, _y, _z) of a grid of 2^21 cells per side : the bits of the three coordinates are interleaved,
+*  from the highest to the lowest (x first). Sorting points by their code gathers those that are close in space.
+*
+*  \param _x : X coordinate of the cell, lower than 2^21.
+*  \param _y : Y coordinate of the cell, lower than 2^21.
+*  \param _z : Z coordinate of the cell, lower than 2^21.
+*
+*  \return (unsigned long long) Returns the Morton code of the cell (63 bits).
+*/
+unsigned long long tools_mortonCode ( unsigned _x, unsigned _y, unsigned _z );
+
+/*!
+*  \brief NON MEMBER FUNCTION : Hilbert code of a point of a grid.
+*
+*  Computes the index of the cell (_x, _y, _z) along the Hilbert curve that covers a grid of 2^21 cells per side (J. Skilling's algorithm).
+*  Unlike the Morton order, two consecutive cells along the curve always are neighbours : the locality of the order is better.
+*
+*  \param _x : X coordinate of the cell, lower than 2^21.
+*  \param _y : Y coordinate of the cell, lower than 2^21.
+*  \param _z : Z coordinate of the cell, lower than 2^21.
+*
+*  \return (unsigned long long) Returns the Hilbert code of the cell (63 bits).
+*/
+unsigned long long tools_hilbertCode ( unsigned _x, unsigned _y, unsigned _z );
+
 /*!
 *  \brief NON MEMBER FUNCTION : Part of a pipeline of functions to convert a TLS color to a RGB one.
 *
@@ -3,250 +3,252 @@
 
 /**
  * \file	vector3d.h
- * \brief	Declaration de la classe Vector3D. Cette classe representera des points dans l'espace aussi bien que des vecteurs (deplacements, normales, ...).
+ * \brief	Declaration de la classe Vector3 (et des types Vector3D, Vector3F et Real). Cette classe representera des points dans l'espace aussi bien que des vecteurs (deplacements, normales, ...).
  */
 
-class Vector3D
+template < class T >
+class Vector3
 {
 	/*!
-	 * \class Vector3D
+	 * \class Vector3
 	 * \brief Classe représentant un Vecteur en 3 dimensions.
 	 * 
-	 * Un vecteur en trois dimension est represente par un triplet de double.
+	 * Un vecteur en trois dimension est represente par un triplet de T (double ou float).
 	 * Une telle classe peut representer un point de l'espace, un vecteur mathematique de 3 dimensions, une couleur sous forme rgb ou tls...
 	 *
+	 *  Les composantes sont rangees dans un tableau : getArray donne un pointeur dessus, sans copie.
+	 *
 	 *  \todo Rajouter un operateur[] pour acceder a x,y et z facilement : comme si le vector etait un tableau. Ca laisserait plus de flexibilite au code.
 	 *
 	 */
 	
 private :
-	double x;			/*! <X component of the vector.*/
-	double y;			/*! <Y component of the vector.*/
-	double z;			/*! <Z component of the vector.*/
+	T	coords[3];		/*! <X, Y and Z components of the vector.*/
 
 public:
 	/*!
-	*  \brief Default constructor of the Vector3D class.
+	*  \brief Default constructor of the Vector3 class.
 	*
-	*  Default constructor of the Vector3D class : Every attributes are initialized to 0 (int,float,double,...) NULL (pointers) or are cleared (lists, stacks, ...).
+	*  Default constructor of the Vector3 class : Every attributes are initialized to 0 (int,float,double,...) NULL (pointers) or are cleared (lists, stacks, ...).
 	*/
-    Vector3D();
+    Vector3();
 	
 	/*!
-	*  \brief Overload constructor of the Vector3D class.
+	*  \brief Overload constructor of the Vector3 class.
 	*
-	*  Overload constructor of the Vector3D class.
+	*  Overload constructor of the Vector3 class.
 	*/
-    Vector3D( double _x, double _y, double _z );
+    Vector3( T _x, T _y, T _z );
 	
 	/*!
-	*  \brief Copy constructor of the Vector3D class.
+	*  \brief Copy constructor of the Vector3 class.
 	*
-	*  Copy constructor of the Vector3D class.
+	*  Copy constructor of the Vector3 class.
 	*/
-    Vector3D( const Vector3D& _v );
+    Vector3( const Vector3& _v );
 	
 	/*!
-	*  \brief Destructor of the Vector3D class.
+	*  \brief Destructor of the Vector3 class.
 	*
-	*  Destructor of the Vector3D class.
+	*  Destructor of the Vector3 class.
 	*/
-	~Vector3D();
+	~Vector3();
 	
 	/*!
-	*  \brief Affectation operator of the Vector3D class.
+	*  \brief Affectation operator of the Vector3 class.
 	*
-	*  Affectation operator of the Vector3D class.
+	*  Affectation operator of the Vector3 class.
 	*/
-	Vector3D& operator= ( const Vector3D& _v );
+	Vector3& operator= ( const Vector3& _v );
 	
 	/*!
-	*  \brief Addition operator of the Vector3D class.
+	*  \brief Addition operator of the Vector3 class.
 	*
-	*  Addition operator of the Vector3D class.
+	*  Addition operator of the Vector3 class.
 	*/
-	Vector3D operator+ ( const double& _a );
+	Vector3 operator+ ( const T& _a );
 	
 	/*!
-	*  \brief Addition operator of the Vector3D class.
+	*  \brief Addition operator of the Vector3 class.
 	*
-	*  Addition operator of the Vector3D class.
+	*  Addition operator of the Vector3 class.
 	*/
-	Vector3D operator+ ( const Vector3D& _v );
+	Vector3 operator+ ( const Vector3& _v );
 	
 	/*!
-	*  \brief Self addition operator of the Vector3D class.
+	*  \brief Self addition operator of the Vector3 class.
 	*
-	*  Self addition operator of the Vector3D class.
+	*  Self addition operator of the Vector3 class.
 	*/
-	Vector3D operator+= ( const double& _a );
+	Vector3 operator+= ( const T& _a );
 	
 	/*!
-	*  \brief Self addition operator of the Vector3D class.
+	*  \brief Self addition operator of the Vector3 class.
 	*
-	*  Self addition operator of the Vector3D class.
+	*  Self addition operator of the Vector3 class.
 	*/
-	Vector3D operator+= ( const Vector3D& _v );
+	Vector3 operator+= ( const Vector3& _v );
 	
 	/*!
-	*  \brief Substraction operator of the Vector3D class.
+	*  \brief Substraction operator of the Vector3 class.
 	*
-	*  Substraction operator of the Vector3D class.
+	*  Substraction operator of the Vector3 class.
 	*/
-	Vector3D operator- ( const double& _a );
+	Vector3 operator- ( const T& _a );
 	
 	/*!
-	*  \brief Substraction operator of the Vector3D class.
+	*  \brief Substraction operator of the Vector3 class.
 	*
-	*  Substraction operator of the Vector3D class.
+	*  Substraction operator of the Vector3 class.
 	*/
-	Vector3D operator- ( const Vector3D& _v );
+	Vector3 operator- ( const Vector3& _v );
 	
 	/*!
-	*  \brief Self substraction operator of the Vector3D class.
+	*  \brief Self substraction operator of the Vector3 class.
 	*
-	*  Self substraction operator of the Vector3D class.
+	*  Self substraction operator of the Vector3 class.
 	*/
-	Vector3D operator-= ( const double& _a );
+	Vector3 operator-= ( const T& _a );
 	
 	/*!
-	*  \brief Self substraction operator of the Vector3D class.
+	*  \brief Self substraction operator of the Vector3 class.
 	*
-	*  Self substraction operator of the Vector3D class.
+	*  Self substraction operator of the Vector3 class.
 	*/
-	Vector3D operator-= ( const Vector3D& _v );
+	Vector3 operator-= ( const Vector3& _v );
 	
 	/*!
-	*  \brief Multiplication operator of the Vector3D class.
+	*  \brief Multiplication operator of the Vector3 class.
 	*
-	*  Multiplication operator of the Vector3D class.
+	*  Multiplication operator of the Vector3 class.
 	*/
-	Vector3D operator* ( const Vector3D& _v );
+	Vector3 operator* ( const Vector3& _v );
 	
 	/*!
-	*  \brief Multiplication operator of the Vector3D class.
+	*  \brief Multiplication operator of the Vector3 class.
 	*
-	*  Multiplication operator of the Vector3D class.
+	*  Multiplication operator of the Vector3 class.
 	*/
-	Vector3D operator* ( const double& _a );
+	Vector3 operator* ( const T& _a );
 	
 	/*!
-	*  \brief Self multiplication operator of the Vector3D class.
+	*  \brief Self multiplication operator of the Vector3 class.
 	*
-	*  Self multiplication operator of the Vector3D class.
+	*  Self multiplication operator of the Vector3 class.
 	*/
-	Vector3D operator*= ( const Vector3D& _v );
+	Vector3 operator*= ( const Vector3& _v );
 	
 	/*!
-	*  \brief Self multiplication operator of the Vector3D class.
+	*  \brief Self multiplication operator of the Vector3 class.
 	*
-	*  Self multiplication operator of the Vector3D class.
+	*  Self multiplication operator of the Vector3 class.
 	*/
-	Vector3D operator*= ( const double& _a );
+	Vector3 operator*= ( const T& _a );
 	
 	/*!
-	*  \brief Self division operator of the Vector3D class.
+	*  \brief Self division operator of the Vector3 class.
 	*
-	*  Self division operator of the Vector3D class.
+	*  Self division operator of the Vector3 class.
 	*/
-	Vector3D operator/= ( const double& _a );
+	Vector3 operator/= ( const T& _a );
 	
 	/*!
-	*  \brief Self division operator of the Vector3D class.
+	*  \brief Self division operator of the Vector3 class.
 	*
-	*  Self division operator of the Vector3D class.
+	*  Self division operator of the Vector3 class.
 	*/
-	Vector3D operator/= ( const Vector3D& _v );
+	Vector3 operator/= ( const Vector3& _v );
 	
 	/*!
-	*  \brief Division operator of the Vector3D class.
+	*  \brief Division operator of the Vector3 class.
 	*
-	*  Division operator of the Vector3D class.
+	*  Division operator of the Vector3 class.
 	*/
-	Vector3D operator/ ( const double& _a );
+	Vector3 operator/ ( const T& _a );
 	
 	/*!
-	*  \brief Division operator of the Vector3D class.
+	*  \brief Division operator of the Vector3 class.
 	*
-	*  Division operator of the Vector3D class.
+	*  Division operator of the Vector3 class.
 	*/
-	Vector3D operator/ ( const Vector3D& _v );
+	Vector3 operator/ ( const Vector3& _v );
 	
 	/*!
-	*  \brief Getter of the Vector3D class.
+	*  \brief Getter of the Vector3 class.
 	*
-	*  Getter of the Vector3D class.
+	*  Getter of the Vector3 class.
 	*
-	*  \return (double) returns the X component of the vector.
+	*  \return (T) returns the X component of the vector.
 	*/
-	double getX();
+	T getX();
 	
 	/*!
-	*  \brief Getter of the Vector3D class.
+	*  \brief Getter of the Vector3 class.
 	*
-	*  Getter of the Vector3D class.
+	*  Getter of the Vector3 class.
 	*
-	*  \return (double) returns the Y component of the vector.
+	*  \return (T) returns the Y component of the vector.
 	*/
-	double getY();
+	T getY();
 	
 	/*!
-	*  \brief Getter of the Vector3D class.
+	*  \brief Getter of the Vector3 class.
 	*
-	*  Getter of the Vector3D class.
+	*  Getter of the Vector3 class.
 	*
-	*  \return (double) returns the Z component of the vector.
+	*  \return (T) returns the Z component of the vector.
 	*/
-	double getZ();
+	T getZ();
 	
 	/*!
-	*  \brief Getter of the Vector3D class.
+	*  \brief Getter of the Vector3 class.
 	*
-	*  Getter of the Vector3D class.
+	*  Getter of the Vector3 class.
 	*  This one is a little special while it is implemented to get all the vector data into one array.
 	*  This might be usefull for some further usages ( as with the glColor3dv func for example ).
+	*  Nothing is allocated : the array is the one of the vector, it is valid as long as the vector is.
 	*
-	*  \return (double*) returns an array of double containing the Vector3D informations.
+	*  \return (T*) returns the array of the three components of the vector.
 	*/
-	double* getArray ();
+	T* getArray ();
 	
 	/*!
-	*  \brief Setter of the Vector3D class.
+	*  \brief Setter of the Vector3 class.
 	*
-	*  Setter of the Vector3D class.
+	*  Setter of the Vector3 class.
 	*
 	*  \param _x : value to affect to the x attribute of the vector.
 	*
 	*  \return (void)
 	*/
-	void setX	( double _x );
+	void setX	( T _x );
 	
 	/*!
-	*  \brief Setter of the Vector3D class.
+	*  \brief Setter of the Vector3 class.
 	*
-	*  Setter of the Vector3D class.
+	*  Setter of the Vector3 class.
 	*
 	*  \param _y : value to affect to the y attribute of the vector.
 	*
 	*  \return (void)
 	*/
-	void setY	( double _y );
+	void setY	( T _y );
 	
 	/*!
-	*  \brief Setter of the Vector3D class.
+	*  \brief Setter of the Vector3 class.
 	*
-	*  Setter of the Vector3D class.
+	*  Setter of the Vector3 class.
 	*
 	*  \param _z : value to affect to the z attribute of the vector.
 	*
 	*  \return (void)
 	*/
-	void setZ	( double _z );
+	void setZ	( T _z );
 	
 	/*!
-	*  \brief Setter of the Vector3D class.
+	*  \brief Setter of the Vector3 class.
 	*
-	*  Setter of the Vector3D class : sets all attributes of the vector.
+	*  Setter of the Vector3 class : sets all attributes of the vector.
 	*
 	*  \param _x : value to affect to the x attribute of the vector.
 	*  \param _y : value to affect to the y attribute of the vector.
@@ -254,7 +256,7 @@ public:
 	*
 	*  \return (void)
 	*/
-	void set	( double _x, double _y, double _z );
+	void set	( T _x, T _y, T _z );
 	
 	/*!
 	*  \brief Clears a 3D vector.
@@ -275,13 +277,35 @@ public:
 	void normalize ();
 	
 	/*!
-	*  \brief Prints the Vector3D in the terminal output.
+	*  \brief Prints the Vector3 in the terminal output.
 	*
-	*  Printf the Vector3D as follow : "[ x, y, z ]\n".
+	*  Printf the Vector3 as follow : "[ x, y, z ]\n".
 	*
 	*  \return (void)
 	*/
 	void print ();
 };
 
+/*!
+ * \typedef Vector3D
+ * \brief Vecteur en double precision, celui de l'interface des maillages.
+ */
+typedef Vector3<double> Vector3D;
+
+/*!
+ * \typedef Vector3F
+ * \brief Vecteur en simple precision.
+ */
+typedef Vector3<float> Vector3F;
+
+/*!
+ * \typedef Real
+ * \brief Type des positions, normales et couleurs rangees dans les maillages : double, ou float si la librairie est compilee avec SML_FLOAT.
+ */
+#ifdef SML_FLOAT
+typedef float Real;
+#else
+typedef double Real;
+#endif
+
 #endif
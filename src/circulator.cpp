@@ -0,0 +1,391 @@
+#include "../inc/circulator.h"
+#include "../inc/mesh.h"
+
+VertexEdgeCirculator::VertexEdgeCirculator(Vertex _v)
+{
+	mesh = _v.getMesh();
+	edge = ( mesh == NULL ) ? -1 : mesh->topo->vertEdge[ _v.getID() ];
+}
+
+bool VertexEdgeCirculator::isValid() const
+{
+	return edge != -1;
+}
+
+Edge VertexEdgeCirculator::operator * () const
+{
+	return Edge( mesh, edge );
+}
+
+VertexEdgeCirculator& VertexEdgeCirculator::operator ++ ()
+{
+	edge = mesh->topo->heNextOut[edge];
+	
+	return *this;
+}
+
+VertexEdgeCirculator VertexEdgeCirculator::begin() const
+{
+	return *this;
+}
+
+VertexEdgeCirculator VertexEdgeCirculator::end() const
+{
+	VertexEdgeCirculator c = *this;
+	
+	c.edge = -1;
+	
+	return c;
+}
+
+bool VertexEdgeCirculator::operator != ( const VertexEdgeCirculator& _c ) const
+{
+	return edge != _c.edge;
+}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+VertexVertexCirculator::VertexVertexCirculator(Vertex _v)
+{
+	mesh = _v.getMesh();
+	edge = ( mesh == NULL ) ? -1 : mesh->topo->vertEdge[ _v.getID() ];
+}
+
+bool VertexVertexCirculator::isValid() const
+{
+	return edge != -1;
+}
+
+Vertex VertexVertexCirculator::operator * () const
+{
+	return Vertex( mesh, mesh->topo->heHead[edge] );
+}
+
+VertexVertexCirculator& VertexVertexCirculator::operator ++ ()
+{
+	edge = mesh->topo->heNextOut[edge];
+	
+	return *this;
+}
+
+VertexVertexCirculator VertexVertexCirculator::begin() const
+{
+	return *this;
+}
+
+VertexVertexCirculator VertexVertexCirculator::end() const
+{
+	VertexVertexCirculator c = *this;
+	
+	c.edge = -1;
+	
+	return c;
+}
+
+bool VertexVertexCirculator::operator != ( const VertexVertexCirculator& _c ) const
+{
+	return edge != _c.edge;
+}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+VertexFaceCirculator::VertexFaceCirculator(Vertex _v)
+{
+	mesh = _v.getMesh();
+	edge = ( mesh == NULL ) ? -1 : mesh->topo->vertEdge[ _v.getID() ];
+	extra = -1;
+	
+	/* The half edges of the border have no face. */
+	while ( edge != -1 && mesh->topo->heFace[edge] == -1 )
+		edge = mesh->topo->heNextOut[edge];
+}
+
+bool VertexFaceCirculator::isValid() const
+{
+	return edge != -1;
+}
+
+Face VertexFaceCirculator::operator * () const
+{
+	return Face( mesh, ( extra == -1 ) ? mesh->topo->heFace[edge] : mesh->topo->extraFace[extra] );
+}
+
+VertexFaceCirculator& VertexFaceCirculator::operator ++ ()
+{
+	/* The other faces of the half edge first, then the next half edge having a face. */
+	extra = ( extra == -1 ) ? mesh->topo->heExtra[edge] : mesh->topo->extraNext[extra];
+	
+	if ( extra == -1 )
+	{
+		do
+			edge = mesh->topo->heNextOut[edge];
+		while ( edge != -1 && mesh->topo->heFace[edge] == -1 );
+	}
+	
+	return *this;
+}
+
+VertexFaceCirculator VertexFaceCirculator::begin() const
+{
+	return *this;
+}
+
+VertexFaceCirculator VertexFaceCirculator::end() const
+{
+	VertexFaceCirculator c = *this;
+	
+	c.edge = -1;
+	c.extra = -1;
+	
+	return c;
+}
+
+bool VertexFaceCirculator::operator != ( const VertexFaceCirculator& _c ) const
+{
+	return edge != _c.edge || extra != _c.extra;
+}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+EdgeFaceCirculator::EdgeFaceCirculator(Edge _e)
+{
+	mesh = _e.getMesh();
+	edge = ( mesh == NULL || mesh->topo->heFace[ _e.getID() ] == -1 ) ? -1 : _e.getID();
+	extra = -1;
+}
+
+bool EdgeFaceCirculator::isValid() const
+{
+	return edge != -1;
+}
+
+Face EdgeFaceCirculator::operator * () const
+{
+	return Face( mesh, ( extra == -1 ) ? mesh->topo->heFace[edge] : mesh->topo->extraFace[extra] );
+}
+
+EdgeFaceCirculator& EdgeFaceCirculator::operator ++ ()
+{
+	extra = ( extra == -1 ) ? mesh->topo->heExtra[edge] : mesh->topo->extraNext[extra];
+	
+	if ( extra == -1 )
+		edge = -1;
+	
+	return *this;
+}
+
+EdgeFaceCirculator EdgeFaceCirculator::begin() const
+{
+	return *this;
+}
+
+EdgeFaceCirculator EdgeFaceCirculator::end() const
+{
+	EdgeFaceCirculator c = *this;
+	
+	c.edge = -1;
+	c.extra = -1;
+	
+	return c;
+}
+
+bool EdgeFaceCirculator::operator != ( const EdgeFaceCirculator& _c ) const
+{
+	return edge != _c.edge || extra != _c.extra;
+}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+FaceEdgeCirculator::FaceEdgeCirculator(Face _f)
+{
+	mesh = _f.getMesh();
+	corner = ( mesh == NULL ) ? 0 : mesh->topo->faceStart[ _f.getID() ];
+	stop = ( mesh == NULL ) ? 0 : mesh->topo->faceStart[ _f.getID()+1 ];
+}
+
+bool FaceEdgeCirculator::isValid() const
+{
+	return corner < stop;
+}
+
+Edge FaceEdgeCirculator::operator * () const
+{
+	return Edge( mesh, mesh->topo->faceEdges[corner] );
+}
+
+FaceEdgeCirculator& FaceEdgeCirculator::operator ++ ()
+{
+	corner++;
+	
+	return *this;
+}
+
+FaceEdgeCirculator FaceEdgeCirculator::begin() const
+{
+	return *this;
+}
+
+FaceEdgeCirculator FaceEdgeCirculator::end() const
+{
+	FaceEdgeCirculator c = *this;
+	
+	c.corner = stop;
+	
+	return c;
+}
+
+bool FaceEdgeCirculator::operator != ( const FaceEdgeCirculator& _c ) const
+{
+	return corner != _c.corner;
+}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+FaceFaceCirculator::FaceFaceCirculator(Face _f)
+{
+	mesh = _f.getMesh();
+	corner = ( mesh == NULL ) ? 0 : mesh->topo->faceStart[ _f.getID() ];
+	stop = ( mesh == NULL ) ? 0 : mesh->topo->faceStart[ _f.getID()+1 ];
+	extra = -1;
+	
+	this->skipBorder();
+}
+
+void FaceFaceCirculator::skipBorder()
+{
+	while ( corner < stop && mesh->topo->heFace[ mesh->topo->heTwin[ mesh->topo->faceEdges[corner] ] ] == -1 )
+		corner++;
+}
+
+bool FaceFaceCirculator::isValid() const
+{
+	return corner < stop;
+}
+
+Face FaceFaceCirculator::operator * () const
+{
+	int twin = mesh->topo->heTwin[ mesh->topo->faceEdges[corner] ];
+	
+	return Face( mesh, ( extra == -1 ) ? mesh->topo->heFace[twin] : mesh->topo->extraFace[extra] );
+}
+
+FaceFaceCirculator& FaceFaceCirculator::operator ++ ()
+{
+	int twin = mesh->topo->heTwin[ mesh->topo->faceEdges[corner] ];
+	
+	/* The other faces of the twin first, then the next half edge of the loop whose twin has a face. */
+	extra = ( extra == -1 ) ? mesh->topo->heExtra[twin] : mesh->topo->extraNext[extra];
+	
+	if ( extra == -1 )
+	{
+		corner++;
+		this->skipBorder();
+	}
+	
+	return *this;
+}
+
+FaceFaceCirculator FaceFaceCirculator::begin() const
+{
+	return *this;
+}
+
+FaceFaceCirculator FaceFaceCirculator::end() const
+{
+	FaceFaceCirculator c = *this;
+	
+	c.corner = stop;
+	c.extra = -1;
+	
+	return c;
+}
+
+bool FaceFaceCirculator::operator != ( const FaceFaceCirculator& _c ) const
+{
+	return corner != _c.corner || extra != _c.extra;
+}
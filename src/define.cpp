@@ -1,107 +1,104 @@
 #include <iostream>
+#include <math.h>
 #include "../inc/define.h"
+#include "../inc/mesh.h"
+#include "../inc/circulator.h"
 
 using namespace std;
 
 Vertex::Vertex()
 {
+	mesh = NULL;
 	id = 0;
-	
-	pos.set( 0, 0, 0 );
-	color.set( 0, 0, 0 );
-	normal.set( 0, 0, 0 );
-	
-	edges.clear();
 }
 
-Vertex::Vertex(const Vertex & _v)
+Vertex::Vertex(Mesh *_mesh, int _ID)
 {
-	id = _v.id;
-	
-	pos = _v.pos;
-	color = _v.color;
-	normal = _v.normal;
-	
-	edges.clear();
-	edges.assign( _v.edges.begin(), _v.edges.end() );
+	mesh = _mesh;
+	id = _ID;
 }
 
-Vertex::Vertex(int _ID, Vector3D _pos)
+bool Vertex::isValid()
 {
-	id = _ID;
-	
-	pos = _pos;
-	color.set( 0, 0, 0 );
-	normal.set( 0, 0, 0 );
-	
-	edges.clear();
+	return mesh != NULL;
 }
 
-Vertex::~Vertex()
+int Vertex::getID()
 {
-	pos.~Vector3D();
-	color.~Vector3D();
-	normal.~Vector3D();
-	edges.clear();
+	return id;
 }
 
-Vertex& Vertex::operator = ( const Vertex& _v )
+Mesh* Vertex::getMesh()
 {
-	id = _v.id;
-	
-	pos = _v.pos;
-	color = _v.color;
-	normal = _v.normal;
-	
-	edges.clear();
-	edges.assign( _v.edges.begin(), _v.edges.end() );
-	
-	return *this;
+	return mesh;
 }
 
-int Vertex::getID()
+Edge Vertex::getEdge()
 {
-	return id;
+	int e = mesh->topo->vertEdge[id];
+	
+	return ( e == -1 ) ? Edge() : Edge( mesh, e );
 }
 
 Vector3D Vertex::getPos()
 {
-	return pos;
+	const Real* p = &mesh->positions[ 3 * (size_t)id ];
+	
+	return Vector3D( p[0], p[1], p[2] );
 }
 
-double* Vertex::getPosArray()
+Real* Vertex::getPosArray()
 {
-	return pos.getArray();
+	return &mesh->positions[ 3 * (size_t)id ];
 }
 
 Vector3D Vertex::getColor()
 {
-	return color;
+	const Real* c = &mesh->colors[ 3 * (size_t)id ];
+	
+	return Vector3D( c[0], c[1], c[2] );
 }
 
-double* Vertex::getColorArray()
+Real* Vertex::getColorArray()
 {
-	return color.getArray();
+	return &mesh->colors[ 3 * (size_t)id ];
 }
 
 Vector3D Vertex::getNormal()
 {
-	return normal;
+	const Real* n = &mesh->normals[ 3 * (size_t)id ];
+	
+	return Vector3D( n[0], n[1], n[2] );
 }
 
-double* Vertex::getNormalArray()
+Real* Vertex::getNormalArray()
 {
-	return normal.getArray();
+	return &mesh->normals[ 3 * (size_t)id ];
 }
 
-vector<Edge*> Vertex::getEdges()
+vector<Edge> Vertex::getEdges()
 {
-	return edges;
+	vector<Edge> rslt;
+	
+	for ( int e = mesh->topo->vertEdge[id] ; e != -1 ; e = mesh->topo->heNextOut[e] )
+		rslt.push_back( Edge( mesh, e ) );
+	
+	return rslt;
 }
 
-Edge* Vertex::getIEdge(int _i)
+VertexEdgeCirculator Vertex::getEdgeRange()
 {
-	return edges[_i];
+	return VertexEdgeCirculator( *this );
+}
+
+Edge Vertex::getIEdge(int _i)
+{
+	int e = mesh->topo->vertEdge[id];
+	
+	for ( int i = 0 ; i < _i && e != -1 ; i++ )
+		e = mesh->topo->heNextOut[e];
+	
+	return ( e == -1 ) ? Edge() : Edge( mesh, e );
 }
 
 void Vertex::printID()
@@ -112,19 +109,19 @@ void Vertex::printID()
 void Vertex::printPos()
 {
 	cout<<"Position ";
-	pos.print();
+	this->getPos().print();
 }
 
 void Vertex::printNormal()
 {
 	cout<<"Normal ";
-	normal.print();
+	this->getNormal().print();
 }
 
 void Vertex::printColor()
 {
 	cout<<"Color ";
-	color.print();
+	this->getColor().print();
 }
 
 void Vertex::print()
@@ -135,80 +132,89 @@ void Vertex::print()
 	this->printColor();
 }
 
-void Vertex::setID(int _ID)
-{
-	id = _ID;
-}
-
 void Vertex::setPos(Vector3D _pos)
 {
-	pos = _pos;
+	Real* p = this->getPosArray();
+	
+	p[0] = _pos.getX();
+	p[1] = _pos.getY();
+	p[2] = _pos.getZ();
+	
+	mesh->markMoved( id );
 }
 
 void Vertex::setPos(double *_pos)
 {
-	pos.set( _pos[0], _pos[1], _pos[2] );
+	Real* p = this->getPosArray();
+	
+	p[0] = _pos[0];
+	p[1] = _pos[1];
+	p[2] = _pos[2];
+	
+	mesh->markMoved( id );
 }
 
 void Vertex::setNormal(Vector3D _normal)
 {
-	normal = _normal;
+	Real* n = this->getNormalArray();
+	
+	n[0] = _normal.getX();
+	n[1] = _normal.getY();
+	n[2] = _normal.getZ();
 }
 
 void Vertex::setNormal(double *_normal)
 {
-	normal.set( _normal[0], _normal[1], _normal[2] );
+	Real* n = this->getNormalArray();
+	
+	n[0] = _normal[0];
+	n[1] = _normal[1];
+	n[2] = _normal[2];
 }
 
 void Vertex::setColor(Vector3D _color)
 {
-	color = _color;
+	Real* c = this->getColorArray();
+	
+	c[0] = _color.getX();
+	c[1] = _color.getY();
+	c[2] = _color.getZ();
 }
 
 void Vertex::setColor(double *_color)
 {
-	color.set( _color[0], _color[1], _color[2] );
-}
-
-void Vertex::setEdges(vector<Edge*> _edges)
-{
-	edges.clear();
-	edges.assign( _edges.begin(), _edges.end() );
+	Real* c = this->getColorArray();
+	
+	c[0] = _color[0];
+	c[1] = _color[1];
+	c[2] = _color[2];
 }
 
 int Vertex::containsEdge(int _iTail, int _iHead)
-{	
-	for ( int i = 0 ; i < (int)edges.size() ; i++ )
+{
+	if ( _iTail != id )
+		return -1;
+	
+	for ( int e = mesh->topo->vertEdge[id] ; e != -1 ; e = mesh->topo->heNextOut[e] )
 	{
-		if ( this->getIEdge(i)->getTail()->getID() == _iTail && this->getIEdge(i)->getHead()->getID() == _iHead )
+		if ( mesh->topo->heHead[e] == _iHead )
 		{
-			return this->getIEdge(i)->getID();
+			return e;
 		}
 	}
 	
 	return -1;
 }
 
-void Vertex::addEdge(Edge *_e)
+bool Vertex::operator == ( const Vertex& _v ) const
 {
-	edges.push_back( _e );
+	return mesh == _v.mesh && id == _v.id;
 }
 
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
+bool Vertex::operator != ( const Vertex& _v ) const
+{
+	return !( *this == _v );
+}
 
 
 
@@ -251,127 +257,121 @@ void Vertex::addEdge(Edge *_e)
 
 Edge::Edge()
 {
+	mesh = NULL;
 	id = 0;
-	tail = NULL;
-	head = NULL;
-	twin = NULL;
-	faces.clear();
 }
 
-Edge::Edge(int _ID, Vertex *_tail, Vertex *_head)
+Edge::Edge(Mesh *_mesh, int _ID)
 {
+	mesh = _mesh;
 	id = _ID;
-	tail = _tail;
-	head = _head;
-	twin = NULL;
-	
-	faces.clear();
 }
 
-Edge::Edge(const Edge &_e)
+bool Edge::isValid()
 {
-	id = _e.id;
-	tail = _e.tail;
-	head = _e.head;
-	twin = _e.twin;
-	
-	faces.clear();
-	faces.assign( _e.faces.begin(), _e.faces.end() );
+	return mesh != NULL;
 }
 
-Edge::~Edge()
+int Edge::getID()
 {
-	/*
-	free ( &tail );
-	free ( &head );
-	free ( &twin );
-	I am not sure that these instructions won't erase what is pointed by tail, head and twin so i comment it and let someone else judge the situation.
-	*/
-	faces.clear();
+	return id;
 }
 
-Edge& Edge::operator = ( const Edge& _e )
+Mesh* Edge::getMesh()
 {
-	id = _e.id;
-	tail = _e.tail;
-	head = _e.head;
-	twin = _e.twin;
-	
-	faces.clear();
-	faces.assign( _e.faces.begin(), _e.faces.end() );
-	
-	return *this;
+	return mesh;
 }
 
-int Edge::getID()
+Vertex Edge::getTail()
 {
-	return id;
+	return Vertex( mesh, mesh->topo->heHead[ mesh->topo->heTwin[id] ] );
 }
 
-Vertex* Edge::getTail()
+Vertex Edge::getHead()
 {
-	return tail;
+	return Vertex( mesh, mesh->topo->heHead[id] );
 }
 
-Vertex* Edge::getHead()
+Edge Edge::getTwin()
 {
-	return head;
+	return Edge( mesh, mesh->topo->heTwin[id] );
 }
 
-Edge* Edge::getTwin()
+Edge Edge::getNext()
 {
-	return twin;
+	int next = mesh->topo->heNext[id];
+	
+	return ( next == -1 ) ? Edge() : Edge( mesh, next );
 }
 
-vector<Face*> Edge::getFaces()
+Edge Edge::getPrev()
 {
-	return faces;
+	int prev = mesh->topo->hePrev[id];
+	
+	return ( prev == -1 ) ? Edge() : Edge( mesh, prev );
 }
 
-Face* Edge::getIFace( int _i )
+Face Edge::getFace()
 {
-	return faces[_i];
+	int f = mesh->topo->heFace[id];
+	
+	return ( f == -1 ) ? Face() : Face( mesh, f );
 }
 
-Vector3D Edge::toVector()
+vector<Face> Edge::getFaces()
 {
-	Vector3D rslt;
+	vector<Face> rslt;
 	
-	rslt = head->getPos() - tail->getPos();
+	if ( mesh->topo->heFace[id] == -1 )
+		return rslt;
+	
+	rslt.push_back( Face( mesh, mesh->topo->heFace[id] ) );
+	for ( int x = mesh->topo->heExtra[id] ; x != -1 ; x = mesh->topo->extraNext[x] )
+		rslt.push_back( Face( mesh, mesh->topo->extraFace[x] ) );
 	
 	return rslt;
 }
 
-void Edge::setID(int _ID)
+EdgeFaceCirculator Edge::getFaceRange()
 {
-	id = _ID;
+	return EdgeFaceCirculator( *this );
 }
 
-void Edge::setHead(Vertex *_head)
+Face Edge::getIFace( int _i )
 {
-	head = _head;
+	if ( _i == 0 )
+		return this->getFace();
+	
+	int x = mesh->topo->heExtra[id];
+	
+	for ( int i = 1 ; i < _i && x != -1 ; i++ )
+		x = mesh->topo->extraNext[x];
+	
+	return ( x == -1 ) ? Face() : Face( mesh, mesh->topo->extraFace[x] );
 }
 
-void Edge::setTail(Vertex *_tail)
+Vector3D Edge::toVector()
 {
-	tail = _tail;
+	Vector3D rslt;
+	
+	rslt = this->getHead().getPos() - this->getTail().getPos();
+	
+	return rslt;
 }
 
-void Edge::setTwin(Edge *_twin)
+bool Edge::operator == ( const Edge& _e ) const
 {
-	twin = _twin;
+	return mesh == _e.mesh && id == _e.id;
 }
 
-void Edge::setFaces(vector<Face *> _faces)
+bool Edge::operator != ( const Edge& _e ) const
 {
-	faces.clear();
-	faces.assign( _faces.begin(), _faces.end() );
+	return !( *this == _e );
 }
 
-void Edge::addFace(Face *_f)
-{
-	faces.push_back( _f );
-}
+
+
+
 
 
 
@@ -410,94 +410,98 @@ void Edge::addFace(Face *_f)
 
 Face::Face()
 {
+	mesh = NULL;
 	id = 0;
-	
-	/*normal.set( 0, 0, 0 );*/
-	normal.setX( 0 );
-	
-	edges.clear();
 }
 
-Face::Face(const Face &_face)
-{
-	id = _face.id;
-	normal = _face.normal;
-	
-	edges.clear();
-	edges.assign( _face.edges.begin(), _face.edges.end() );
-}
-
-Face::Face(int _ID)
+Face::Face(Mesh *_mesh, int _ID)
 {
+	mesh = _mesh;
 	id = _ID;
-	
-	edges.clear();
-	normal.set( 0, 0, 0 );
 }
 
-Face::Face(int _ID, vector<Edge *> _edges)
+bool Face::isValid()
 {
-	id = _ID;
-	edges = _edges;
-	
-	normal.set ( 0, 0, 0 );
+	return mesh != NULL;
 }
 
-Face::~Face()
+int Face::getID()
 {
-	normal.~Vector3D();
-	edges.clear();
+	return id;
 }
 
-Face& Face::operator = ( const Face& _f )
+Mesh* Face::getMesh()
 {
-	id = _f.id;
-	normal = _f.normal;
-	edges.clear();
-	edges.assign( _f.edges.begin(), _f.edges.end() );
-	
-	return *this;
+	return mesh;
 }
 
-int Face::getID()
+Vector3D Face::getNormal()
 {
-	return id;
+	const Real* n = &mesh->faceNormals[ 3 * (size_t)id ];
+	
+	return Vector3D( n[0], n[1], n[2] );
 }
 
-Vector3D Face::getNormal()
+Real* Face::getNormalArray()
 {
-	return normal;
+	return &mesh->faceNormals[ 3 * (size_t)id ];
 }
 
-double* Face::getNormalArray()
+int Face::getNEdges()
 {
-	return normal.getArray();
+	return mesh->topo->faceStart[id+1] - mesh->topo->faceStart[id];
 }
 
-vector<Edge*> Face::getEdges()
+double Face::getArea()
 {
-	return edges;
+	const MeshTopology&	t = *mesh->topo;
+	const Real*			p0 = &mesh->positions[ 3 * (size_t)t.heHead[ t.faceEdges[ t.faceStart[id+1] - 1 ] ] ];
+	double				sum[3] = { 0, 0, 0 };
+	
+	/* The sum of the normals of the triangles (v0, vj, vj+1), whose length is twice their area, is the normal of the face : its length is twice the area of the face. */
+	for ( int j = t.faceStart[id] ; j < t.faceStart[id+1] - 2 ; j++ )
+	{
+		const Real*	p1 = &mesh->positions[ 3 * (size_t)t.heHead[ t.faceEdges[j] ] ];
+		const Real*	p2 = &mesh->positions[ 3 * (size_t)t.heHead[ t.faceEdges[j+1] ] ];
+		double		a[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+		double		b[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+		
+		sum[0] += a[1] * b[2] - a[2] * b[1];
+		sum[1] += a[2] * b[0] - a[0] * b[2];
+		sum[2] += a[0] * b[1] - a[1] * b[0];
+	}
+	
+	return 0.5 * sqrt( sum[0] * sum[0] + sum[1] * sum[1] + sum[2] * sum[2] );
 }
 
-void Face::setID(int _ID)
+vector<Edge> Face::getEdges()
 {
-	id = _ID;
+	vector<Edge> rslt;
+	
+	rslt.reserve( this->getNEdges() );
+	for ( int j = mesh->topo->faceStart[id] ; j < mesh->topo->faceStart[id+1] ; j++ )
+		rslt.push_back( Edge( mesh, mesh->topo->faceEdges[j] ) );
+	
+	return rslt;
 }
 
-void Face::setNormal(Vector3D _normal)
+FaceEdgeCirculator Face::getEdgeRange()
 {
-	normal = _normal;
+	return FaceEdgeCirculator( *this );
 }
 
-void Face::setEdges(vector<Edge *> _edges)
+Edge Face::getIEdge(int _i)
 {
-	edges.clear();
-	edges.assign( _edges.begin(), _edges.end() );
+	return Edge( mesh, mesh->topo->faceEdges[ mesh->topo->faceStart[id] + _i ] );
 }
 
-void Face::addEdge(Edge *_e)
+void Face::setNormal(Vector3D _normal)
 {
-	edges.push_back( _e );
+	Real* n = this->getNormalArray();
+	
+	n[0] = _normal.getX();
+	n[1] = _normal.getY();
+	n[2] = _normal.getZ();
 }
 
 void Face::display(float _r, float _g, float _b )
@@ -505,10 +509,12 @@ void Face::display(float _r, float _g, float _b )
 	glColor3f ( _r, _g, _b );
 	glBegin ( GL_POLYGON );
 	
-	for ( int i = 0 ; i < (int)edges.size() ; i++ )
+	for ( int j = mesh->topo->faceStart[id] ; j < mesh->topo->faceStart[id+1] ; j++ )
 	{
-		glNormal3dv ( edges[i]->getHead()->getNormalArray() );
-		glVertex3dv ( edges[i]->getHead()->getPosArray() );
+		int v = mesh->topo->heHead[ mesh->topo->faceEdges[j] ];
+		
+		glNormal3rv ( &mesh->normals[ 3 * (size_t)v ] );
+		glVertex3rv ( &mesh->positions[ 3 * (size_t)v ] );
 	}
 	
 	glEnd();
@@ -518,12 +524,24 @@ void Face::display()
 {
 	glBegin ( GL_POLYGON );
 	
-	for ( int i = 0 ; i < (int)edges.size() ; i++ )
+	for ( int j = mesh->topo->faceStart[id] ; j < mesh->topo->faceStart[id+1] ; j++ )
 	{
-		glColor3dv ( edges[i]->getHead()->getColorArray() );
-		glNormal3dv ( edges[i]->getHead()->getNormalArray() );
-		glVertex3dv ( edges[i]->getHead()->getPosArray() );
+		int v = mesh->topo->heHead[ mesh->topo->faceEdges[j] ];
+		
+		glColor3rv ( &mesh->colors[ 3 * (size_t)v ] );
+		glNormal3rv ( &mesh->normals[ 3 * (size_t)v ] );
+		glVertex3rv ( &mesh->positions[ 3 * (size_t)v ] );
 	}
 	
 	glEnd();
 }
+
+bool Face::operator == ( const Face& _f ) const
+{
+	return mesh == _f.mesh && id == _f.id;
+}
+
+bool Face::operator != ( const Face& _f ) const
+{
+	return !( *this == _f );
+}
@@ -0,0 +1,119 @@
+#include "../inc/edgeindex.h"
+
+EdgeIndex::EdgeIndex()
+{
+	count = 0;
+	slots.clear();
+}
+
+EdgeIndex::EdgeIndex(const EdgeIndex &_i)
+{
+	count = _i.count;
+	slots = _i.slots;
+}
+
+EdgeIndex::EdgeIndex(EdgeIndex &&_i)
+{
+	count = 0;
+	*this = std::move( _i );
+}
+
+EdgeIndex::~EdgeIndex()
+{
+	slots.clear();
+}
+
+EdgeIndex& EdgeIndex::operator = ( const EdgeIndex& _i )
+{
+	count = _i.count;
+	slots = _i.slots;
+
+	return *this;
+}
+
+EdgeIndex& EdgeIndex::operator = ( EdgeIndex&& _i )
+{
+	count = _i.count;
+	slots.swap( _i.slots );
+	_i.clear();
+
+	return *this;
+}
+
+size_t EdgeIndex::slot(int _iTail, int _iHead) const
+{
+	size_t		mask = slots.size() - 1;
+	unsigned	h = (unsigned)_iHead * 0x9E3779B9u;
+	/* The probe starts in a window of 8 slots reserved to the tail vertex : consecutive faces share their vertices,
+	   so the lookups of a load hit the same few cache lines instead of jumping all over the table. */
+	size_t		i = ( (size_t)(unsigned)_iTail * 8 + ( h >> 29 ) ) & mask;
+	/* Once the window is crossed, the step depends on the whole key (double hashing) :
+	   the half edges of a vertex with a high valence are scattered instead of piling up in one long cluster. */
+	size_t		step = ( ( (size_t)(unsigned)_iTail * 0x85EBCA6Bu ) ^ h ) | 1;
+
+	for ( int k = 0 ; slots[i].index != -1 && ( slots[i].tail != _iTail || slots[i].head != _iHead ) ; k++ )
+		i = ( i + ( k < 8 ? 1 : step ) ) & mask;
+
+	return i;
+}
+
+void EdgeIndex::rehash(size_t _capacity)
+{
+	vector<Slot>	old;
+	Slot			empty = { 0, 0, -1 };
+
+	old.swap( slots );
+	slots.assign( _capacity, empty );
+
+	for ( size_t i = 0 ; i < old.size() ; i++ )
+	{
+		if ( old[i].index != -1 )
+			slots[ this->slot( old[i].tail, old[i].head ) ] = old[i];
+	}
+}
+
+int EdgeIndex::getSize() const
+{
+	return count;
+}
+
+void EdgeIndex::clear()
+{
+	count = 0;
+	vector<Slot>().swap( slots );
+}
+
+void EdgeIndex::reserve(int _n)
+{
+	/* The table is kept at most half full so that the probe sequences stay short. */
+	size_t capacity = 16;
+	while ( capacity < 2 * (size_t)_n )
+		capacity *= 2;
+
+	if ( capacity > slots.size() )
+		this->rehash( capacity );
+}
+
+int EdgeIndex::find(int _iTail, int _iHead) const
+{
+	if ( count == 0 )
+		return -1;
+
+	return slots[ this->slot( _iTail, _iHead ) ].index;
+}
+
+void EdgeIndex::insert(int _iTail, int _iHead, int _index)
+{
+	if ( 2 * (size_t)( count + 1 ) > slots.size() )
+		this->reserve( 2 * ( count + 1 ) );
+
+	size_t s = this->slot( _iTail, _iHead );
+
+	if ( slots[s].index == -1 )
+	{
+		slots[s].tail = _iTail;
+		slots[s].head = _iHead;
+		slots[s].index = _index;
+		count++;
+	}
+}
@@ -0,0 +1,449 @@
+#include "../inc/fileio.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <charconv>
+#include <climits>
+#include <zlib.h>
+
+#ifndef _WIN32
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+#endif
+
+MappedFile::MappedFile()
+{
+	data = NULL;
+	size = 0;
+	mapped = false;
+}
+
+MappedFile::~MappedFile()
+{
+	this->close();
+}
+
+int MappedFile::open(const char *_path)
+{
+	this->close();
+
+#ifdef _WIN32
+	/* No mmap : the whole file is read in a buffer. */
+	FILE* file = fopen( _path, "rb" );
+
+	if ( file == NULL )
+		return -1;
+
+	fseek( file, 0, SEEK_END );
+	size = (size_t)ftell( file );
+	fseek( file, 0, SEEK_SET );
+
+	if ( size > 0 )
+	{
+		data = (char*) malloc ( size );
+
+		if ( data == NULL || fread( data, 1, size, file ) != size )
+		{
+			free( data );
+			data = NULL;
+			size = 0;
+			fclose( file );
+			return -1;
+		}
+	}
+
+	fclose( file );
+	mapped = false;
+#else
+	int			fd = ::open( _path, O_RDONLY );
+	struct stat	st;
+
+	if ( fd < 0 )
+		return -1;
+
+	if ( fstat( fd, &st ) != 0 )
+	{
+		::close( fd );
+		return -1;
+	}
+
+	size = (size_t)st.st_size;
+
+	/* An empty file can not be mapped, it is simply seen as an empty array. */
+	if ( size > 0 )
+	{
+		void* addr = mmap( NULL, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+
+		if ( addr == MAP_FAILED )
+		{
+			::close( fd );
+			size = 0;
+			return -1;
+		}
+
+		/* The loaders read the files from the beginning to the end : the kernel can read ahead aggressively. */
+		madvise( addr, size, MADV_SEQUENTIAL );
+
+		data = (char*)addr;
+		mapped = true;
+	}
+
+	/* The projection stays valid once the descriptor is closed. */
+	::close( fd );
+#endif
+
+	return 1;
+}
+
+void MappedFile::close()
+{
+	if ( data != NULL )
+	{
+#ifndef _WIN32
+		if ( mapped )
+			munmap( data, size );
+		else
+#endif
+			free( data );
+	}
+
+	data = NULL;
+	size = 0;
+	mapped = false;
+}
+
+const char* MappedFile::getData() const
+{
+	return data;
+}
+
+size_t MappedFile::getSize() const
+{
+	return size;
+}
+
+bool MappedFile::isGzip() const
+{
+	return size >= 2 && (unsigned char)data[0] == 0x1F && (unsigned char)data[1] == 0x8B;
+}
+
+/*! Size of the blocks produced by the decompression thread of an InputStream. */
+#define INFLATE_BLOCK_SIZE ( 1 << 20 )
+
+/*! Number of decompressed blocks an InputStream can keep waiting. */
+#define INFLATE_QUEUE_SIZE 4
+
+InputStream::InputStream()
+{
+	file = NULL;
+	gzip = false;
+	pos = 0;
+	finished = true;
+	stopping = false;
+	failed = false;
+}
+
+InputStream::~InputStream()
+{
+	this->close();
+}
+
+int InputStream::open(const char *_path)
+{
+	this->close();
+
+	if ( compressed.open( _path ) == -1 )
+		return -1;
+
+	gzip = compressed.isGzip();
+	failed = false;
+	stopping = false;
+
+	if ( !gzip )
+	{
+		/* Not compressed : the file is simply read. */
+		compressed.close();
+		file = fopen( _path, "rb" );
+		return ( file == NULL ) ? -1 : 1;
+	}
+
+	finished = false;
+	inflater = thread( &InputStream::inflateAll, this );
+
+	return 1;
+}
+
+void InputStream::close()
+{
+	if ( inflater.joinable() )
+	{
+		{
+			lock_guard<mutex> guard( lock );
+			stopping = true;
+		}
+		changed.notify_all();
+		inflater.join();
+	}
+
+	if ( file != NULL )
+		fclose( file );
+
+	file = NULL;
+	compressed.close();
+	ready.clear();
+	current.clear();
+	pos = 0;
+	gzip = false;
+	finished = true;
+}
+
+void InputStream::inflateAll()
+{
+	z_stream		z;
+	const char*		in = compressed.getData();
+	size_t			left = compressed.getSize();
+	int				status = Z_OK;
+	bool			ok;
+
+	memset( &z, 0, sizeof( z ) );
+
+	/* 15 + 32 : the biggest window and automatic detection of the gzip header. */
+	ok = ( inflateInit2( &z, 15 + 32 ) == Z_OK );
+
+	while ( ok && status != Z_STREAM_END )
+	{
+		vector<char> block( INFLATE_BLOCK_SIZE );
+
+		z.next_out = (Bytef*)block.data();
+		z.avail_out = (uInt)block.size();
+
+		while ( z.avail_out > 0 )
+		{
+			if ( z.avail_in == 0 )
+			{
+				/* zlib counts the input in uInt : a huge file is given in pieces. */
+				z.avail_in = (uInt)min( left, (size_t)UINT_MAX );
+				z.next_in = (Bytef*)in;
+				in += z.avail_in;
+				left -= z.avail_in;
+			}
+
+			status = inflate( &z, Z_NO_FLUSH );
+
+			if ( status == Z_STREAM_END )
+			{
+				/* Several gzip members can follow each other (concatenated files). */
+				if ( z.avail_in == 0 && left == 0 )
+					break;
+				inflateReset( &z );
+				status = Z_OK;
+			}
+
+			else if ( status != Z_OK || ( z.avail_in == 0 && left == 0 && z.avail_out > 0 ) )
+			{
+				/* Corrupted or truncated data. */
+				if ( status == Z_OK || status == Z_BUF_ERROR )
+					status = Z_DATA_ERROR;
+				ok = false;
+				break;
+			}
+		}
+
+		block.resize( block.size() - z.avail_out );
+
+		unique_lock<mutex> guard( lock );
+		changed.wait( guard, [this] { return stopping || ready.size() < INFLATE_QUEUE_SIZE; } );
+
+		if ( stopping )
+			break;
+
+		if ( !block.empty() )
+		{
+			ready.push_back( vector<char>() );
+			ready.back().swap( block );
+		}
+		guard.unlock();
+		changed.notify_all();
+	}
+
+	inflateEnd( &z );
+
+	{
+		lock_guard<mutex> guard( lock );
+		finished = true;
+		if ( !ok )
+			failed = true;
+	}
+	changed.notify_all();
+}
+
+size_t InputStream::read(char *_dst, size_t _size)
+{
+	if ( !gzip )
+	{
+		if ( file == NULL )
+			return 0;
+
+		size_t n = fread( _dst, 1, _size, file );
+
+		if ( n < _size && ferror( file ) )
+			failed = true;
+
+		return n;
+	}
+
+	size_t done = 0;
+
+	while ( done < _size )
+	{
+		if ( pos == current.size() )
+		{
+			/* The current block is read : the next one is taken from the queue. */
+			unique_lock<mutex> guard( lock );
+			changed.wait( guard, [this] { return !ready.empty() || finished; } );
+
+			if ( ready.empty() )
+				break;
+
+			current.swap( ready.front() );
+			ready.pop_front();
+			pos = 0;
+			guard.unlock();
+			changed.notify_all();
+		}
+
+		size_t n = min( _size - done, current.size() - pos );
+
+		memcpy( _dst + done, current.data() + pos, n );
+		pos += n;
+		done += n;
+	}
+
+	return done;
+}
+
+bool InputStream::isCompressed() const
+{
+	return gzip;
+}
+
+bool InputStream::hasFailed()
+{
+	lock_guard<mutex> guard( lock );
+
+	return failed;
+}
+
+/*! Size of the buffer of a FileWriter. */
+#define WRITER_BUFFER_SIZE ( 1 << 20 )
+
+FileWriter::FileWriter()
+{
+	file = NULL;
+	used = 0;
+	failed = false;
+}
+
+FileWriter::~FileWriter()
+{
+	this->close();
+}
+
+int FileWriter::open(const char *_path)
+{
+	this->close();
+
+	file = fopen( _path, "wb" );
+
+	if ( file == NULL )
+		return -1;
+
+	buffer.resize( WRITER_BUFFER_SIZE );
+	used = 0;
+	failed = false;
+
+	return 1;
+}
+
+int FileWriter::close()
+{
+	if ( file == NULL )
+		return -1;
+
+	this->reserve( buffer.size() );
+
+	if ( fclose( file ) != 0 )
+		failed = true;
+
+	file = NULL;
+	vector<char>().swap( buffer );
+	used = 0;
+
+	return failed ? -1 : 1;
+}
+
+void FileWriter::reserve(size_t _n)
+{
+	if ( buffer.size() - used >= _n )
+		return;
+
+	if ( used > 0 && fwrite( buffer.data(), 1, used, file ) != used )
+		failed = true;
+
+	used = 0;
+}
+
+void FileWriter::write(const void *_data, size_t _size)
+{
+	/* Big blocks do not go through the buffer. */
+	if ( _size >= buffer.size() )
+	{
+		this->reserve( buffer.size() );
+		if ( fwrite( _data, 1, _size, file ) != _size )
+			failed = true;
+		return;
+	}
+
+	this->reserve( _size );
+	memcpy( buffer.data() + used, _data, _size );
+	used += _size;
+}
+
+void FileWriter::writeText(const char *_text)
+{
+	this->write( _text, strlen( _text ) );
+}
+
+void FileWriter::writeChar(char _c)
+{
+	this->reserve( 1 );
+	buffer[used++] = _c;
+}
+
+void FileWriter::writeInt(long long _i)
+{
+	this->reserve( 24 );
+	used = std::to_chars( buffer.data() + used, buffer.data() + buffer.size(), _i ).ptr - buffer.data();
+}
+
+void FileWriter::writeReal(double _x)
+{
+	char* end;
+
+	this->reserve( 32 );
+
+	if ( (double)(float)_x == _x )
+		end = std::to_chars( buffer.data() + used, buffer.data() + buffer.size(), (float)_x ).ptr;
+	else
+		end = std::to_chars( buffer.data() + used, buffer.data() + buffer.size(), _x ).ptr;
+
+	used = end - buffer.data();
+}
+
+void FileWriter::writeDouble(double _x)
+{
+	this->reserve( 32 );
+	used = std::to_chars( buffer.data() + used, buffer.data() + buffer.size(), _x ).ptr - buffer.data();
+}
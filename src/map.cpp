@@ -1,13 +1,42 @@
 #include "../inc/map.h"
+#include "../inc/parser.h"
 #include <iostream>
 #include <limits>
-#include <fstream>
+#include <climits>
+#include <cstring>
+#include <cstdio>
+#include <string>
+
+/*! \def SMLM_VERSION
+  version of the binary ".smlm" format written by Map::saveBinary.
+ */
+#define SMLM_VERSION 1
+
+/*! \def SMLM_BYTE_ORDER
+  value written in the header of a ".smlm" file to detect a file saved by a computer with another byte order.
+ */
+#define SMLM_BYTE_ORDER 0x01020304
+
+/* Header of a ".smlm" file (48 bytes), followed by the values : the array of doubles is aligned in a mapped file. */
+struct MapHeader
+{
+	char		magic[4];		/* "SMLM". */
+	int			version;		/* SMLM_VERSION. */
+	int			byteOrder;		/* SMLM_BYTE_ORDER. */
+	int			reserved;
+	long long	size;			/* Number of values. */
+	double		min;
+	double		max;
+	long long	reserved2;
+};
 
 Map::Map()
 {
 	min = 0;
 	max = 0;
 	data.clear();
+	mapped = NULL;
+	nMapped = 0;
 }
 
 Map::Map(const Map &_m)
@@ -16,6 +45,11 @@ Map::Map(const Map &_m)
 	max = _m.max;
 	data.clear();
 	data = _m.data;
+	
+	/* A mapped file is read only : the copies share it. */
+	mapping = _m.mapping;
+	mapped = _m.mapped;
+	nMapped = _m.nMapped;
 }
 
 Map::~Map()
@@ -29,33 +63,47 @@ Map& Map::operator = ( const Map& _m )
 	max = _m.max;
 	data.clear();
 	data = _m.data;
+	mapping = _m.mapping;
+	mapped = _m.mapped;
+	nMapped = _m.nMapped;
 	
 	return *this;
 }
 
-double Map::getMin()
+double Map::getMin() const
 {
 	return min;
 }
 
-double Map::getMax()
+double Map::getMax() const
 {
 	return max;
 }
 
 vector<double> Map::getData()
 {
+	if ( mapping )
+		return vector<double>( mapped, mapped + nMapped );
+	
 	return data;
 }
 
-double Map::getIData(int _i)
+ArrayView<double> Map::getDataView() const
 {
-	return data[_i];
+	if ( mapping )
+		return ArrayView<double>( mapped, nMapped );
+	
+	return ArrayView<double>( data.data(), data.size() );
 }
 
-int Map::getSize()
+double Map::getIData(int _i) const
 {
-	return (int)data.size() - 1;
+	return mapping ? mapped[_i] : data[_i];
+}
+
+int Map::getSize() const
+{
+	return mapping ? (int)nMapped : (int)data.size();
 }
 
 void Map::setMin(double _min)
@@ -70,11 +118,13 @@ void Map::setMax(double _max)
 
 void Map::setData(vector<double> _data)
 {
+	mapping.reset();
 	data = _data;
 }
 
 void Map::setIData(int _i, double _iData)
 {
+	this->unmap();
 	data[_i] = _iData;
 }
 
@@ -83,6 +133,20 @@ void Map::clear()
 	min = 0;
 	max = 0;
 	data.clear();
+	mapping.reset();
+	mapped = NULL;
+	nMapped = 0;
+}
+
+void Map::unmap()
+{
+	if ( !mapping )
+		return;
+	
+	data.assign( mapped, mapped + nMapped );
+	mapping.reset();
+	mapped = NULL;
+	nMapped = 0;
 }
 
 void Map::expand(int _min, int _max)
@@ -96,6 +160,8 @@ void Map::expand(int _min, int _max)
 	
 	double a = 0, b = 0;
 	
+	this->unmap();
+	
 	a = ( _max - _min ) / ( max - min );
 	b = _min - ( a * min );
 	
@@ -110,10 +176,11 @@ void Map::expand(int _min, int _max)
 
 int Map::load(char *_path)
 {
-	ifstream		file ( _path, ifstream::in );
+	InputStream		file;
+	int				errorLine;
 	
 	/* Testing if the file has been succesfully opened. */
-	if ( ! file.is_open() )
+	if ( file.open( _path ) == -1 )
 	{
 		cout<<"Error while opening the file \""<<_path<<"\""<<endl;
 		cout<<"Method Map::load is returning -1, check it if you didn't"<<endl;
@@ -122,22 +189,49 @@ int Map::load(char *_path)
 	
 	/* The map is cleared and min & max are initialized to find the real min & max. */
 	this->clear();
-	min = INT_MAX;
-	max = INT_MIN;
+	min = numeric_limits<double>::max();
+	max = -numeric_limits<double>::max();
 	
-	/* We read one feature after another until the end of the file. And change the min and max value if necessary. */
-	while ( file.good() )
+	/* We read one feature after another until the end of the file, block after block (a gzip compressed file is decompressed on the fly).
+	   And change the min and max value if necessary. */
+	auto readValues = [this] ( const char* _begin, const char* _end ) -> const char*
 	{
-		double		value = 0;
+		const char* p = _begin;
 		
-		file >> value;
-		data.push_back( value );
-		
-		if ( value > max )
-			max = value;
-		
-		if ( value < min )
-			min = value;
+		while ( true )
+		{
+			while ( p < _end && ( *p == ' ' || *p == '\t' || *p == '\r' || *p == '\n' ) )
+				p++;
+			
+			if ( p == _end )
+				return NULL;
+			
+			const char*	start = p;
+			double		value = 0;
+			
+			/* A value has to be followed by a blank. */
+			if ( !parser_readDouble( p, _end, value ) || ( p < _end && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n' ) )
+				return start;
+			
+			data.push_back( value );
+			
+			if ( value > max )
+				max = value;
+			
+			if ( value < min )
+				min = value;
+		}
+	};
+	
+	if ( parser_streamLines( file, readValues, errorLine ) == -1 )
+	{
+		if ( errorLine == 0 )
+			cout<<"Error while reading the file \""<<_path<<"\""<<endl;
+		else
+			cout<<"Error while reading the file \""<<_path<<"\" : not a value at line "<<errorLine<<endl;
+		cout<<"Method Map::load is returning -1, check it if you didn't"<<endl;
+		this->clear();
+		return -1;
 	}
 	
 	/* Closing file. */
@@ -149,28 +243,151 @@ int Map::load(char *_path)
 	return 1;
 }
 
+int Map::loadBinary(char *_path)
+{
+	shared_ptr<MappedFile>	file ( new MappedFile );
+	MapHeader				header;
+	
+	/* If the file can not be mapped in memory.
+	   Print an error message and return -1.
+	*/
+	if ( file->open( _path ) == -1 )
+	{
+		cout<<"Error while opening the file \""<<_path<<"\""<<endl;
+		cout<<"Method Map::loadBinary is returning -1, check it if you didn't"<<endl;
+		return -1;
+	}
+	
+	if ( file->getSize() < sizeof( header ) )
+		memset( &header, 0, sizeof( header ) );
+	else
+		memcpy( &header, file->getData(), sizeof( header ) );
+	
+	if ( memcmp( header.magic, "SMLM", 4 ) != 0 || header.byteOrder != SMLM_BYTE_ORDER || header.version != SMLM_VERSION )
+	{
+		cout<<"Error while reading the file \""<<_path<<"\" : not a binary map of version "<<SMLM_VERSION<<" saved with the byte order of this computer"<<endl;
+		cout<<"Method Map::loadBinary is returning -1, check it if you didn't"<<endl;
+		return -1;
+	}
+	
+	if ( header.size < 0 || header.size > INT_MAX || file->getSize() != sizeof( header ) + sizeof( double ) * (size_t)header.size )
+	{
+		cout<<"Error while reading the file \""<<_path<<"\" : the file is truncated or corrupted"<<endl;
+		cout<<"Method Map::loadBinary is returning -1, check it if you didn't"<<endl;
+		return -1;
+	}
+	
+	/* The values are used in place, in the mapped file. */
+	this->clear();
+	min = header.min;
+	max = header.max;
+	mapping = file;
+	mapped = (const double*)( file->getData() + sizeof( header ) );
+	nMapped = (size_t)header.size;
+	
+	return 1;
+}
+
+/* Path of the file a map is written to : a mapped map still reads its values in its file (maybe _path itself) while it is written,
+   so it is written aside and then moved over _path (see finishFile), the mapping keeps the old file alive. */
+static string writtenPath ( bool _mapped, const char* _path )
+{
+	return _mapped ? string( _path ) + ".tmp" : string( _path );
+}
+
+/* Moves the file written aside over _path, the file is removed if it could not be written. */
+static int finishFile ( bool _mapped, bool _written, const char* _path )
+{
+	if ( !_mapped )
+		return _written ? 1 : -1;
+	
+	string tmp = writtenPath( _mapped, _path );
+	
+#ifdef _WIN32
+	/* rename does not replace a file on Windows (where the files are read, not mapped). */
+	if ( _written )
+		remove( _path );
+#endif
+	
+	if ( !_written || rename( tmp.c_str(), _path ) != 0 )
+	{
+		remove( tmp.c_str() );
+		return -1;
+	}
+	
+	return 1;
+}
+
+int Map::saveBinary(char *_path)
+{
+	FileWriter		file;
+	MapHeader		header;
+	
+	/* Testing if the file has been succesfully opened/created. */
+	if ( file.open( writtenPath( mapping != NULL, _path ).c_str() ) == -1 )
+	{
+		cout<<"Error while opening the file \""<<_path<<"\""<<endl;
+		cout<<"Method Map::saveBinary is returning -1, check it if you didn't"<<endl;
+		return -1;
+	}
+	
+	memset( &header, 0, sizeof( header ) );
+	memcpy( header.magic, "SMLM", 4 );
+	header.version = SMLM_VERSION;
+	header.byteOrder = SMLM_BYTE_ORDER;
+	header.size = this->getSize();
+	header.min = min;
+	header.max = max;
+	
+	file.write( &header, sizeof( header ) );
+	if ( mapping )
+		file.write( mapped, sizeof( double ) * nMapped );
+	else if ( !data.empty() )
+		file.write( data.data(), sizeof( double ) * data.size() );
+	
+	if ( finishFile( mapping != NULL, file.close() != -1, _path ) == -1 )
+	{
+		cout<<"Error while writing the file \""<<_path<<"\""<<endl;
+		cout<<"Method Map::saveBinary is returning -1, check it if you didn't"<<endl;
+		return -1;
+	}
+	
+	return 1;
+}
+
 int Map::save(char *_path)
 {
-	ofstream		file ( _path );
+	FileWriter		file;
+	int				n = this->getSize();
 	
 	/* Testing if the file has been succesfully opened/created. */
-	if ( ! file.is_open() )
+	if ( file.open( writtenPath( mapping != NULL, _path ).c_str() ) == -1 )
 	{
 		cout<<"Error while opening the file \""<<_path<<"\""<<endl;
 		cout<<"Method Map::save is returning -1, check it if you didn't"<<endl;
 		return -1;
 	}
 	
-	for ( int i = 0 ; i < (int)data.size() ; i++ )
-		file<<data[i]<<endl;
+	for ( int i = 0 ; i < n ; i++ )
+	{
+		file.writeDouble( this->getIData( i ) );
+		file.writeChar( '\n' );
+	}
 	
-	file.close();
+	if ( finishFile( mapping != NULL, file.close() != -1, _path ) == -1 )
+	{
+		cout<<"Error while writing the file \""<<_path<<"\""<<endl;
+		cout<<"Method Map::save is returning -1, check it if you didn't"<<endl;
+		return -1;
+	}
 	
 	return 1;
 }
 
 void Map::segment(int _n)
 {	
+	this->unmap();
+	
 	/* Formula to get the class of the vertex. */
 	for ( int i = 0 ; i < (int)data.size() ; i++ )
 		data[i] = (int)( (data[i]-min) * ( (double)_n / (max - min)  ));
@@ -189,12 +406,12 @@ void Map::printInfos()
 	cout<<"________________"<<endl;
 	cout<<"Minimum value : "<<min<<endl;
 	cout<<"Maximum value : "<<max<<endl;
-	cout<<"Number of elements : "<<data.size()<<endl;
+	cout<<"Number of elements : "<<this->getSize()<<endl;
 }
 
 void Map::printIData(int _i)
 {
-	cout<<_i<<"th element of the map : "<<data[_i]<<endl;
+	cout<<_i<<"th element of the map : "<<this->getIData( _i )<<endl;
 }
 
 void Map::printData()
@@ -202,6 +419,6 @@ void Map::printData()
 	cout<<"Entire Map :"<<endl;
 	cout<<"____________"<<endl;
 	
-	for ( int i = 0 ; i < (int)data.size() ; i++ )
+	for ( int i = 0 ; i < this->getSize() ; i++ )
 		this->printIData( i );
 }
@@ -1,9 +1,105 @@
 #include "../inc/mesh.h"
+#include "../inc/fileio.h"
+#include "../inc/parser.h"
+#include "../inc/parallel.h"
+#include "../inc/ply.h"
+#include "../inc/spatialhash.h"
 #include <math.h>
 #include <limits>
-#include <fstream>
+#include <climits>
+#include <algorithm>
+#include <cstdio>
 #include <sstream>
-#include <string>
+
+/*! \def SMLB_VERSION
+  version of the binary ".smlb" format written by Mesh::saveBinary.
+ */
+#define SMLB_VERSION 1
+
+/*! \def SMLB_BYTE_ORDER
+  value written in the header of a ".smlb" file to detect a file saved by a computer with another byte order.
+ */
+#define SMLB_BYTE_ORDER 0x01020304
+
+/*! \def LOAD_SLICE_SIZE
+  size in bytes of the slices of a ".obj" file parsed between two updates of the progress of a load.
+ */
+#define LOAD_SLICE_SIZE ( 4 << 20 )
+
+/*! \def LOAD_FACE_STEP
+  number of faces built between two updates of the progress of a load.
+ */
+#define LOAD_FACE_STEP 65536
+
+/* Header of a ".smlb" file (64 bytes), followed by the arrays described in Mesh::saveBinary :
+   the arrays of doubles come first so that every array is aligned in a mapped file. */
+struct BinaryHeader
+{
+	char	magic[4];		/* "SMLB". */
+	int		version;		/* SMLB_VERSION. */
+	int		byteOrder;		/* SMLB_BYTE_ORDER. */
+	int		nVerts;
+	int		nEdges;
+	int		nFaces;
+	int		nFaceEdges;		/* Sum of the sizes of the edge loops of the faces. */
+	int		nEdgeFaces;		/* Sum of the sizes of the face lists of the edges. */
+	int		nVertEdges;		/* Sum of the sizes of the edge lists of the vertices. */
+	int		reserved[7];
+};
+
+/* Returns true if the load followed by _progress has been cancelled. */
+static bool isCancelled ( const LoadProgress* _progress )
+{
+	return _progress != NULL && _progress->cancelled.load();
+}
+
+/* Appends a value to a binary buffer, in little endian order. */
+template < class T >
+static void appendLE ( vector<char>& _buffer, T _value )
+{
+	size_t size = _buffer.size();
+	
+	_buffer.resize( size + sizeof( T ) );
+	ply_copyLE( &_buffer[size], &_value, sizeof( T ) );
+}
+
+/* Writes a whole buffer in a file, returns false if it fails. */
+static bool writeFile ( const char* _path, const vector<char>& _buffer )
+{
+	FILE*	file = fopen( _path, "wb" );
+	bool	ok = ( file != NULL );
+	
+	if ( ok && !_buffer.empty() && fwrite( _buffer.data(), 1, _buffer.size(), file ) != _buffer.size() )
+		ok = false;
+	
+	if ( file != NULL && fclose( file ) != 0 )
+		ok = false;
+	
+	return ok;
+}
+
+/* Checks that the _n values of _a are in [_min, _max). */
+static bool checkIndices ( const int* _a, int _n, int _min, int _max )
+{
+	for ( int i = 0 ; i < _n ; i++ )
+		if ( _a[i] < _min || _a[i] >= _max )
+			return false;
+	
+	return true;
+}
+
+/* Checks that the _n+1 starts of a compressed row array are increasing from 0 to _total. */
+static bool checkStarts ( const int* _starts, int _n, int _total )
+{
+	if ( _starts[0] != 0 || _starts[_n] != _total )
+		return false;
+	
+	for ( int i = 0 ; i < _n ; i++ )
+		if ( _starts[i] > _starts[i+1] )
+			return false;
+	
+	return true;
+}
 
 Mesh::Mesh()
 {
@@ -13,52 +109,116 @@ Mesh::Mesh()
 	nEdges = 0;
 	nFaces = 0;
 	
-	verts.clear();
-	edges.clear();
-	faces.clear();
+	topo = make_shared<MeshTopology>();
+	
+	edgeIndexValid = true;
+	
+	normalsValid = false;
+	normalsWeighting = NORMALS_UNIFORM;
+	
+	boxValid = false;
 }
 
 Mesh::Mesh(const Mesh &_m)
+{
+	*this = _m;
+}
+
+Mesh::Mesh(Mesh &&_m)
+{
+	*this = std::move( _m );
+}
+
+Mesh::~Mesh()
+{
+	edgeIndex.clear();
+}
+
+Mesh& Mesh::operator = ( const Mesh& _m )
 {
 	id = _m.id;
 	nVerts = _m.nVerts;
 	nEdges = _m.nEdges;
 	nFaces = _m.nFaces;
 	
-	verts.clear();
-	edges.clear();
-	faces.clear();
+	positions = _m.positions;
+	normals = _m.normals;
+	colors = _m.colors;
+	faceNormals = _m.faceNormals;
 	
-	verts.assign( _m.verts.begin(), _m.verts.end() );
-	edges.assign( _m.edges.begin(), _m.edges.end() );
-	faces.assign( _m.faces.begin(), _m.faces.end() );
-}
-
-Mesh::~Mesh()
-{
-	verts.clear();
-	edges.clear();
-	faces.clear();
+	/* The connectivity is shared. The edge index is not copied : it is rebuilt the first time it is needed. */
+	topo = _m.topo;
+	
+	edgeIndex.clear();
+	edgeIndexValid = false;
+	
+	vertProps = _m.vertProps;
+	edgeProps = _m.edgeProps;
+	faceProps = _m.faceProps;
+	
+	normalsValid = _m.normalsValid;
+	normalsWeighting = _m.normalsWeighting;
+	movedFlags = _m.movedFlags;
+	
+	boxBot = _m.boxBot;
+	boxTop = _m.boxTop;
+	boxValid = _m.boxValid.load();
+	
+	return *this;
 }
 
-Mesh& Mesh::operator = ( const Mesh& _m )
+Mesh& Mesh::operator = ( Mesh&& _m )
 {
+	if ( this == &_m )
+		return *this;
+	
 	id = _m.id;
 	nVerts = _m.nVerts;
 	nEdges = _m.nEdges;
 	nFaces = _m.nFaces;
 	
-	verts.clear();
-	edges.clear();
-	faces.clear();
+	positions = std::move( _m.positions );
+	normals = std::move( _m.normals );
+	colors = std::move( _m.colors );
+	faceNormals = std::move( _m.faceNormals );
+	topo = std::move( _m.topo );
+	
+	edgeIndex = std::move( _m.edgeIndex );
+	edgeIndexValid = _m.edgeIndexValid;
+	
+	vertProps = std::move( _m.vertProps );
+	edgeProps = std::move( _m.edgeProps );
+	faceProps = std::move( _m.faceProps );
 	
-	verts.assign( _m.verts.begin(), _m.verts.end() );
-	edges.assign( _m.edges.begin(), _m.edges.end() );
-	faces.assign( _m.faces.begin(), _m.faces.end() );
+	normalsValid = _m.normalsValid;
+	normalsWeighting = _m.normalsWeighting;
+	movedFlags = std::move( _m.movedFlags );
+	
+	boxBot = _m.boxBot;
+	boxTop = _m.boxTop;
+	boxValid = _m.boxValid.load();
+	
+	/* _m is left as an empty mesh. */
+	_m.clear();
 	
 	return *this;
 }
 
+Mesh Mesh::clone()
+{
+	Mesh copy( *this );
+	
+	copy.topo = make_shared<MeshTopology>( *topo );
+	
+	return copy;
+}
+
+void Mesh::unshare()
+{
+	if ( topo.use_count() > 1 )
+		topo = make_shared<MeshTopology>( *topo );
+}
+
 
 int Mesh::getID()
 {
@@ -80,64 +240,92 @@ int Mesh::getNFaces()
 	return nFaces;
 }
 
-vector<Vertex*> Mesh::getVerts()
+vector<Vertex> Mesh::getVerts()
 {
-	return verts;
+	vector<Vertex> rslt;
+	
+	rslt.reserve( nVerts );
+	for ( int i = 0 ; i < nVerts ; i++ )
+		rslt.push_back( Vertex( this, i ) );
+	
+	return rslt;
 }
 
-Vertex* Mesh::getIVert(int _i)
+IndexRange<Vertex> Mesh::getVertRange()
 {
-	return verts[_i];
+	return IndexRange<Vertex>( this, 0, nVerts );
 }
 
-vector<Edge*> Mesh::getEdges()
+Vertex Mesh::getIVert(int _i)
 {
-	return edges;
+	return Vertex( this, _i );
 }
 
-Edge* Mesh::getIEdge(int _i)
+vector<Edge> Mesh::getEdges()
 {
-	return edges[_i];
+	vector<Edge> rslt;
+	
+	rslt.reserve( nEdges );
+	for ( int i = 0 ; i < nEdges ; i++ )
+		rslt.push_back( Edge( this, i ) );
+	
+	return rslt;
 }
 
-vector<Face*> Mesh::getFaces()
+IndexRange<Edge> Mesh::getEdgeRange()
 {
-	return faces;
+	return IndexRange<Edge>( this, 0, nEdges );
 }
 
-void Mesh::setID(int _ID)
+Edge Mesh::getIEdge(int _i)
 {
-	id = _ID;
+	return Edge( this, _i );
 }
 
-void Mesh::setNVerts(int _nVerts)
+vector<Face> Mesh::getFaces()
 {
-	nVerts = _nVerts;
+	vector<Face> rslt;
+	
+	rslt.reserve( nFaces );
+	for ( int i = 0 ; i < nFaces ; i++ )
+		rslt.push_back( Face( this, i ) );
+	
+	return rslt;
 }
 
-void Mesh::setNEdges(int _nEdges)
+IndexRange<Face> Mesh::getFaceRange()
 {
-	nEdges = _nEdges;
+	return IndexRange<Face>( this, 0, nFaces );
 }
 
-void Mesh::setNFaces(int _nFaces)
+Face Mesh::getIFace(int _i)
 {
-	nFaces = _nFaces;
+	return Face( this, _i );
+}
+
+ArrayView<Real> Mesh::getPositions()
+{
+	return ArrayView<Real>( positions.data(), positions.size() );
+}
+
+ArrayView<Real> Mesh::getNormals()
+{
+	return ArrayView<Real>( normals.data(), normals.size() );
 }
 
-void Mesh::setVerts(vector<Vertex *> _verts)
+ArrayView<Real> Mesh::getColors()
 {
-	verts = _verts;
+	return ArrayView<Real>( colors.data(), colors.size() );
 }
 
-void Mesh::setEdges(vector<Edge *> _edges)
+ArrayView<Real> Mesh::getFaceNormals()
 {
-	edges = _edges;
+	return ArrayView<Real>( faceNormals.data(), faceNormals.size() );
 }
 
-void Mesh::setFaces(vector<Face *> _faces)
+void Mesh::setID(int _ID)
 {
-	faces = _faces;
+	id = _ID;
 }
 
 void Mesh::clear()
@@ -148,323 +336,2407 @@ void Mesh::clear()
 	nEdges = 0;
 	nFaces = 0;
 	
-	verts.clear();
-	edges.clear();
-	faces.clear();
+	/* Swapping with empty arrays frees the memory, clearing them would keep it. */
+	vector<Real>().swap( positions );
+	vector<Real>().swap( normals );
+	vector<Real>().swap( colors );
+	vector<Real>().swap( faceNormals );
+	
+	/* A new connectivity : the old one is freed, unless it is shared with another mesh. */
+	topo = make_shared<MeshTopology>();
+	
+	edgeIndex.clear();
+	edgeIndexValid = true;
+	
+	/* The properties are kept, without any element. */
+	vertProps.clear();
+	edgeProps.clear();
+	faceProps.clear();
+	
+	normalsValid = false;
+	vector<char>().swap( movedFlags );
+	
+	boxValid = false;
 }
 
-int Mesh::containsEdge(int _iTail, int _iHead)
+void Mesh::reserve(int _nVerts, int _nFaces, int _nIndices)
+{
+	/* Each face index is a half edge with a face, the half edges of the border come in addition :
+	   reserving the arrays for them avoids most of the reallocations. */
+	size_t nHalfEdges = _nIndices + _nIndices / 8;
+	
+	this->unshare();
+	
+	positions.reserve( 3 * (size_t)_nVerts );
+	normals.reserve( 3 * (size_t)_nVerts );
+	colors.reserve( 3 * (size_t)_nVerts );
+	topo->vertEdge.reserve( _nVerts );
+	topo->vertLastEdge.reserve( _nVerts );
+	
+	topo->heHead.reserve( nHalfEdges );
+	topo->heTwin.reserve( nHalfEdges );
+	topo->heNext.reserve( nHalfEdges );
+	topo->hePrev.reserve( nHalfEdges );
+	topo->heFace.reserve( nHalfEdges );
+	topo->heNextOut.reserve( nHalfEdges );
+	topo->heExtra.reserve( nHalfEdges );
+	if ( edgeIndexValid )
+		edgeIndex.reserve( (int)nHalfEdges );
+	
+	topo->faceStart.reserve( _nFaces + 1 );
+	topo->faceEdges.reserve( _nIndices );
+	faceNormals.reserve( 3 * (size_t)_nFaces );
+	
+	vertProps.reserve( _nVerts );
+	edgeProps.reserve( (int)nHalfEdges );
+	faceProps.reserve( _nFaces );
+}
+
+PropertySet* Mesh::getPropertySet(int _element)
+{
+	switch ( _element )
+	{
+		case VERTICES :
+			return &vertProps;
+		
+		case EDGES :
+			return &edgeProps;
+		
+		case FACES :
+			return &faceProps;
+		
+		default :
+			return NULL;
+	}
+}
+
+void Mesh::resizeProperties()
+{
+	vertProps.resize( nVerts );
+	edgeProps.resize( nEdges );
+	faceProps.resize( nFaces );
+}
+
+int Mesh::removeProperty(int _element, const string &_name)
+{
+	PropertySet* set = this->getPropertySet( _element );
+	
+	if ( set == NULL || set->remove( _name ) == -1 )
+	{
+		cout<<"Error while removing the property \""<<_name<<"\" : no such property"<<endl;
+		cout<<"Method Mesh::removeProperty is returning -1, check it if you didn't"<<endl;
+		return -1;
+	}
+	
+	return 1;
+}
+
+void Mesh::indexEdges()
 {
+	edgeIndex.clear();
+	edgeIndex.reserve( nEdges );
 	for ( int i = 0 ; i < nEdges ; i++ )
+		edgeIndex.insert( topo->heHead[ topo->heTwin[i] ], topo->heHead[i], i );
+	
+	edgeIndexValid = true;
+}
+
+int Mesh::containsEdge(int _iTail, int _iHead)
+{
+	if ( !edgeIndexValid )
+		this->indexEdges();
+	
+	return edgeIndex.find( _iTail, _iHead );
+}
+
+Vertex Mesh::addVertex(Vector3D _pos)
+{
+	this->unshare();
+	
+	positions.push_back( _pos.getX() );
+	positions.push_back( _pos.getY() );
+	positions.push_back( _pos.getZ() );
+	
+	/* A valid box only has to be extended to the new vertex. */
+	if ( boxValid )
+		tools_extendBox( boxBot, boxTop, Vector3D( positions[3*(size_t)nVerts], positions[3*(size_t)nVerts+1], positions[3*(size_t)nVerts+2] ) );
+	
+	normals.insert( normals.end(), 3, 0.0 );
+	colors.insert( colors.end(), 3, 0.0 );
+	topo->vertEdge.push_back( -1 );
+	topo->vertLastEdge.push_back( -1 );
+	vertProps.resize( nVerts+1 );
+	
+	/* The flags of the moved vertices are kept at one per vertex, markMoved does not allocate. */
+	if ( normalsValid )
+		movedFlags.push_back( 0 );
+	
+	return Vertex( this, nVerts++ );
+}
+
+int Mesh::addEdgePair(int _iTail, int _iHead)
+{
+	int e = nEdges;
+	
+	topo->heHead.push_back( _iHead );
+	topo->heHead.push_back( _iTail );
+	topo->heTwin.push_back( e+1 );
+	topo->heTwin.push_back( e );
+	topo->heNext.insert( topo->heNext.end(), 2, -1 );
+	topo->hePrev.insert( topo->hePrev.end(), 2, -1 );
+	topo->heFace.insert( topo->heFace.end(), 2, -1 );
+	topo->heNextOut.insert( topo->heNextOut.end(), 2, -1 );
+	topo->heExtra.insert( topo->heExtra.end(), 2, -1 );
+	
+	/* The half edges are appended to the lists of their tails : a list keeps the order of creation. */
+	for ( int k = 0 ; k < 2 ; k++ )
+	{
+		int v = ( k == 0 ) ? _iTail : _iHead;
+		
+		if ( topo->vertLastEdge[v] == -1 )
+			topo->vertEdge[v] = e+k;
+		else
+			topo->heNextOut[ topo->vertLastEdge[v] ] = e+k;
+		topo->vertLastEdge[v] = e+k;
+	}
+	
+	/* A stale index is rebuilt from the half edge arrays when it is needed. */
+	if ( edgeIndexValid )
+	{
+		edgeIndex.insert( _iTail, _iHead, e );
+		edgeIndex.insert( _iHead, _iTail, e+1 );
+	}
+	
+	nEdges += 2;
+	
+	return e;
+}
+
+void Mesh::addEdgeFace(int _e, int _f)
+{
+	if ( topo->heFace[_e] == -1 )
+	{
+		topo->heFace[_e] = _f;
+		return;
+	}
+	
+	/* A non manifold half edge : the face is appended to its extra list. */
+	int x = (int)topo->extraFace.size();
+	
+	topo->extraFace.push_back( _f );
+	topo->extraNext.push_back( -1 );
+	
+	if ( topo->heExtra[_e] == -1 )
+		topo->heExtra[_e] = x;
+	else
 	{
-		if ( this->getIEdge( i )->getTail()->getID() == _iTail && this->getIEdge( i )->getHead()->getID() == _iHead )
+		int last = topo->heExtra[_e];
+		
+		while ( topo->extraNext[last] != -1 )
+			last = topo->extraNext[last];
+		topo->extraNext[last] = x;
+	}
+}
+
+void Mesh::linkFace(int _f)
+{
+	int begin = topo->faceStart[_f], end = topo->faceStart[_f+1];
+	
+	/* A half edge only follows the loop of its first face (and its first occurrence in it). */
+	for ( int j = begin ; j < end ; j++ )
+	{
+		int e = topo->faceEdges[j];
+		
+		if ( topo->heFace[e] == _f && topo->heNext[e] == -1 )
 		{
-			return i;
+			topo->heNext[e] = topo->faceEdges[ ( j+1 == end ) ? begin : j+1 ];
+			topo->hePrev[e] = topo->faceEdges[ ( j == begin ) ? end-1 : j-1 ];
 		}
 	}
-	
-	return -1;
 }
 
-void Mesh::addVertex(Vertex *_v)
+void Mesh::countNonTriangles()
 {
-	verts.push_back( _v );
-	nVerts++;
+	topo->nNonTriangles = 0;
+	
+	for ( int i = 0 ; i < nFaces ; i++ )
+		if ( topo->faceStart[i+1] - topo->faceStart[i] != 3 )
+			topo->nNonTriangles++;
 }
 
-void Mesh::addEdgeToIVertex(int _i, Edge *_e)
+Face Mesh::addFace(const vector<int> &_loop)
 {
-	verts[_i]->addEdge ( _e );
+	int n = (int)_loop.size();
+	
+	if ( n == 0 )
+		return Face();
+	
+	for ( int j = 0 ; j < n ; j++ )
+	{
+		if ( _loop[j] < 0 || _loop[j] >= nVerts )
+		{
+			cout<<"Error while adding a face : the face refers to the vertex "<<_loop[j]<<" while there are "<<nVerts<<" vertices"<<endl;
+			return Face();
+		}
+	}
+	
+	this->unshare();
+	
+	int f = nFaces;
+	
+	/* The edges [v0, v1], [v1, v2], ..., [vn-1, v0] of the face, created with their twins if the mesh does not have them yet. */
+	for ( int j = 0 ; j < n ; j++ )
+	{
+		int iTail = _loop[j], iHead = _loop[ ( j+1 ) % n ];
+		int e = this->containsEdge( iTail, iHead );
+		
+		if ( e == -1 )
+			e = this->addEdgePair( iTail, iHead );
+		
+		topo->faceEdges.push_back( e );
+		this->addEdgeFace( e, f );
+	}
+	
+	topo->faceStart.push_back( (int)topo->faceEdges.size() );
+	faceNormals.insert( faceNormals.end(), 3, 0.0 );
+	nFaces++;
+	
+	if ( n != 3 )
+		topo->nNonTriangles++;
+	
+	this->linkFace( f );
+	
+	/* The normals of the vertices of the face change as if they were moved. */
+	for ( int j = 0 ; j < n ; j++ )
+		this->markMoved( _loop[j] );
+	
+	edgeProps.resize( nEdges );
+	faceProps.resize( nFaces );
+	
+	return Face( this, f );
 }
 
-void Mesh::addEdge(Edge *_e)
+int Mesh::build(int _nVerts, const double *_positions, int _nFaces, const int *_faceStarts, const int *_indices, LoadProgress *_progress)
 {
-	edges.push_back( _e );
-	nEdges++;
+	int nIndices = _faceStarts[_nFaces];
+	
+	this->clear();
+	
+	/* Every index is checked before anything is built, so that a bad file can not leave a half built mesh. */
+	for ( int i = 0 ; i < nIndices ; i++ )
+	{
+		if ( _indices[i] < 0 || _indices[i] >= _nVerts )
+		{
+			cout<<"Error while building the mesh : a face refers to the vertex "<<_indices[i]+1<<" while there are "<<_nVerts<<" vertices"<<endl;
+			cout<<"Method Mesh::build is returning -1, check it if you didn't"<<endl;
+			return -1;
+		}
+	}
+	
+	/* Every array is allocated once. */
+	this->reserve( _nVerts, _nFaces, nIndices );
+	
+	/* Vertices. */
+	positions.assign( _positions, _positions + 3 * (size_t)_nVerts );
+	normals.assign( 3 * (size_t)_nVerts, 0.0 );
+	colors.assign( 3 * (size_t)_nVerts, 0.0 );
+	topo->vertEdge.assign( _nVerts, -1 );
+	topo->vertLastEdge.assign( _nVerts, -1 );
+	nVerts = _nVerts;
+	
+	for ( int i = 0 ; i < _nFaces ; i++ )
+	{
+		int begin = _faceStarts[i], end = _faceStarts[i+1];
+		
+		/* The edges [v0, v1], [v1, v2], ..., [vn-1, v0] of the face. */
+		for ( int c = begin ; c < end ; c++ )
+		{
+			int iTail = _indices[c], iHead = _indices[ ( c+1 == end ) ? begin : c+1 ];
+			int e = this->containsEdge( iTail, iHead );
+			
+			/* If the mesh does not have the edge [iTail, iHead] yet, we have to create the edge and its twin */
+			if ( e == -1 )
+				e = this->addEdgePair( iTail, iHead );
+			
+			topo->faceEdges.push_back( e );
+			this->addEdgeFace( e, i );
+		}
+		
+		topo->faceStart.push_back( (int)topo->faceEdges.size() );
+		faceNormals.insert( faceNormals.end(), 3, 0.0 );
+		nFaces++;
+		
+		this->linkFace( i );
+		
+		if ( _progress != NULL && ( i+1 ) % LOAD_FACE_STEP == 0 )
+		{
+			_progress->facesBuilt = i+1;
+			
+			if ( isCancelled( _progress ) )
+			{
+				this->clear();
+				return -1;
+			}
+		}
+	}
+	
+	/* The edge index takes as much memory as the half edges : it is only kept while building,
+	   it is rebuilt the first time it is needed afterwards (as after a parallel build). */
+	edgeIndex.clear();
+	edgeIndexValid = false;
+	
+	this->countNonTriangles();
+	this->resizeProperties();
+	
+	if ( _progress != NULL )
+		_progress->facesBuilt = _nFaces;
+	
+	return 1;
 }
 
-void Mesh::addFaceToIEdge(int _i, Face *_f)
+int Mesh::buildParallel(int _nVerts, const double *_positions, int _nFaces, const int *_faceStarts, const int *_indices, int _nThreads, LoadProgress *_progress)
 {
-	edges[_i]->addFace( _f );
+	int				nIndices = _faceStarts[_nFaces];
+	int				T = _nThreads;
+	int				nEdgePairs = 0;
+	vector<char>	badIndex( T, 0 );
+	vector<int>		cornerFace( nIndices );	/* Face of each corner (each index of a face). */
+	vector<int>		sorted( nIndices );		/* Corners sorted by bucket, in increasing order inside each bucket. */
+	vector<int>		bucketStart( T+1, 0 );
+	vector<int>		cellStart( T*T, 0 );	/* Where the thread t puts its corners of the bucket b : cellStart[t*T+b]. */
+	vector<int>		creator( nIndices );	/* First corner (in the order of a serial build) having the same edge as the corner. */
+	vector<int>		pairOf( nIndices );		/* Number of the half edge pair created by a first corner. */
+	vector<int>		threadCount( T+1, 0 );
+	vector< vector<int> >	extras( T );	/* Half edges and faces (by pairs) going to the extra lists, found by each thread. */
+	
+	this->clear();
+	
+	/* Every index is checked before anything is built, so that a bad file can not leave a half built mesh. */
+	tools_parallelFor( nIndices, T, [&] ( int _begin, int _end, int _t )
+	{
+		for ( int i = _begin ; i < _end ; i++ )
+			if ( _indices[i] < 0 || _indices[i] >= _nVerts )
+				badIndex[_t] = 1;
+	} );
+	
+	for ( int t = 0 ; t < T ; t++ )
+	{
+		if ( badIndex[t] )
+		{
+			/* The serial check gives the exact message. */
+			return this->build( _nVerts, _positions, _nFaces, _faceStarts, _indices, _progress );
+		}
+	}
+	
+	if ( isCancelled( _progress ) )
+		return -1;
+	
+	tools_parallelFor( _nFaces, T, [&] ( int _begin, int _end, int )
+	{
+		for ( int i = _begin ; i < _end ; i++ )
+			for ( int c = _faceStarts[i] ; c < _faceStarts[i+1] ; c++ )
+				cornerFace[c] = i;
+	} );
+	
+	/* The corner c is the half edge [tail, head] of its face loop. */
+	auto tail = [&] ( int _c ) { return _indices[_c]; };
+	auto head = [&] ( int _c ) { return _indices[ ( _c+1 == _faceStarts[ cornerFace[_c]+1 ] ) ? _faceStarts[ cornerFace[_c] ] : _c+1 ]; };
+	/* Both half edges of an edge go in the same bucket. */
+	auto bucket = [&] ( int _c )
+	{
+		unsigned lo = (unsigned)min( tail( _c ), head( _c ) ), hi = (unsigned)max( tail( _c ), head( _c ) );
+		return (int)( ( ( lo * 0x9E3779B9u ) ^ ( hi * 0x85EBCA6Bu ) ) % (unsigned)T );
+	};
+	
+	/* Dispatching the corners in the buckets : counting, then each thread writes its corners at its own place,
+	   the corners of a bucket stay in increasing order. */
+	tools_parallelFor( nIndices, T, [&] ( int _begin, int _end, int _t )
+	{
+		for ( int c = _begin ; c < _end ; c++ )
+			cellStart[ _t*T + bucket( c ) ]++;
+	} );
+	
+	for ( int b = 0, n = 0 ; b < T ; b++ )
+	{
+		bucketStart[b] = n;
+		for ( int t = 0 ; t < T ; t++ )
+		{
+			int size = cellStart[ t*T + b ];
+			cellStart[ t*T + b ] = n;
+			n += size;
+		}
+	}
+	bucketStart[T] = nIndices;
+	
+	tools_parallelFor( nIndices, T, [&] ( int _begin, int _end, int _t )
+	{
+		for ( int c = _begin ; c < _end ; c++ )
+			sorted[ cellStart[ _t*T + bucket( c ) ]++ ] = c;
+	} );
+	
+	/* In each bucket, the first corner of an edge is the one which creates the half edge pair in a serial build. */
+	tools_parallelFor( T, T, [&] ( int _begin, int _end, int )
+	{
+		for ( int b = _begin ; b < _end ; b++ )
+		{
+			EdgeIndex index;
+			index.reserve( bucketStart[b+1] - bucketStart[b] );
+			
+			for ( int i = bucketStart[b] ; i < bucketStart[b+1] ; i++ )
+			{
+				int c = sorted[i];
+				int lo = min( tail( c ), head( c ) ), hi = max( tail( c ), head( c ) );
+				int first = index.find( lo, hi );
+				
+				if ( first == -1 )
+				{
+					index.insert( lo, hi, c );
+					first = c;
+				}
+				creator[c] = first;
+			}
+		}
+	} );
+	
+	/* Last chance to stop : nothing is built yet. */
+	if ( isCancelled( _progress ) )
+		return -1;
+	
+	/* The pairs are numbered in the order of their first corners, as in a serial build. */
+	tools_parallelFor( nIndices, T, [&] ( int _begin, int _end, int _t )
+	{
+		for ( int c = _begin ; c < _end ; c++ )
+			if ( creator[c] == c )
+				threadCount[_t+1]++;
+	} );
+	
+	for ( int t = 0 ; t < T ; t++ )
+		threadCount[t+1] += threadCount[t];
+	nEdgePairs = threadCount[T];
+	
+	tools_parallelFor( nIndices, T, [&] ( int _begin, int _end, int _t )
+	{
+		int n = threadCount[_t];
+		
+		for ( int c = _begin ; c < _end ; c++ )
+			if ( creator[c] == c )
+				pairOf[c] = n++;
+	} );
+	
+	/* Vertices. */
+	positions.assign( _positions, _positions + 3 * (size_t)_nVerts );
+	normals.assign( 3 * (size_t)_nVerts, 0.0 );
+	colors.assign( 3 * (size_t)_nVerts, 0.0 );
+	topo->vertEdge.assign( _nVerts, -1 );
+	topo->vertLastEdge.assign( _nVerts, -1 );
+	
+	/* Half edges : a corner uses the first half edge of the pair if it goes in the same direction as the first corner, the twin else. */
+	topo->heHead.resize( 2 * (size_t)nEdgePairs );
+	topo->heTwin.resize( 2 * (size_t)nEdgePairs );
+	topo->heNext.assign( 2 * (size_t)nEdgePairs, -1 );
+	topo->hePrev.assign( 2 * (size_t)nEdgePairs, -1 );
+	topo->heFace.assign( 2 * (size_t)nEdgePairs, -1 );
+	topo->heNextOut.assign( 2 * (size_t)nEdgePairs, -1 );
+	topo->heExtra.assign( 2 * (size_t)nEdgePairs, -1 );
+	topo->faceStart.assign( _faceStarts, _faceStarts + _nFaces + 1 );
+	topo->faceEdges.resize( nIndices );
+	faceNormals.assign( 3 * (size_t)_nFaces, 0.0 );
+	
+	tools_parallelFor( nIndices, T, [&] ( int _begin, int _end, int )
+	{
+		for ( int c = _begin ; c < _end ; c++ )
+		{
+			int first = creator[c];
+			
+			topo->faceEdges[c] = 2 * pairOf[first] + ( ( tail( c ) == tail( first ) ) ? 0 : 1 );
+			
+			if ( first == c )
+			{
+				int e = topo->faceEdges[c];
+				
+				topo->heHead[e] = head( c );
+				topo->heHead[e+1] = tail( c );
+				topo->heTwin[e] = e+1;
+				topo->heTwin[e+1] = e;
+			}
+		}
+	} );
+	
+	/* Faces of the half edges : a half edge only has corners of one bucket, which are in increasing order.
+	   The extra faces are rare, they are linked afterwards. */
+	tools_parallelFor( T, T, [&] ( int _begin, int _end, int _t )
+	{
+		for ( int b = _begin ; b < _end ; b++ )
+		{
+			for ( int i = bucketStart[b] ; i < bucketStart[b+1] ; i++ )
+			{
+				int c = sorted[i], e = topo->faceEdges[c];
+				
+				if ( topo->heFace[e] == -1 )
+					topo->heFace[e] = cornerFace[c];
+				else
+				{
+					extras[_t].push_back( e );
+					extras[_t].push_back( cornerFace[c] );
+				}
+			}
+		}
+	} );
+	
+	for ( int t = 0 ; t < T ; t++ )
+		for ( int i = 0 ; i < (int)extras[t].size() ; i += 2 )
+			this->addEdgeFace( extras[t][i], extras[t][i+1] );
+	
+	tools_parallelFor( _nFaces, T, [&] ( int _begin, int _end, int )
+	{
+		for ( int i = _begin ; i < _end ; i++ )
+			this->linkFace( i );
+	} );
+	
+	/* Half edges of the vertices : the vertices are split in T ranges, the half edges are dispatched in these ranges
+	   (in increasing order, the same way the corners were) and each range is linked by one thread. */
+	int				nHalfEdges = 2 * nEdgePairs;
+	vector<int>		sortedEdges( nHalfEdges );
+	auto range = [&] ( int _e ) { return (int)( (long long)topo->heHead[ topo->heTwin[_e] ] * T / _nVerts ); };
+	
+	std::fill( cellStart.begin(), cellStart.end(), 0 );
+	tools_parallelFor( nHalfEdges, T, [&] ( int _begin, int _end, int _t )
+	{
+		for ( int e = _begin ; e < _end ; e++ )
+			cellStart[ _t*T + range( e ) ]++;
+	} );
+	
+	for ( int b = 0, n = 0 ; b < T ; b++ )
+	{
+		bucketStart[b] = n;
+		for ( int t = 0 ; t < T ; t++ )
+		{
+			int size = cellStart[ t*T + b ];
+			cellStart[ t*T + b ] = n;
+			n += size;
+		}
+	}
+	bucketStart[T] = nHalfEdges;
+	
+	tools_parallelFor( nHalfEdges, T, [&] ( int _begin, int _end, int _t )
+	{
+		for ( int e = _begin ; e < _end ; e++ )
+			sortedEdges[ cellStart[ _t*T + range( e ) ]++ ] = e;
+	} );
+	
+	tools_parallelFor( T, T, [&] ( int _begin, int _end, int )
+	{
+		for ( int b = _begin ; b < _end ; b++ )
+		{
+			for ( int i = bucketStart[b] ; i < bucketStart[b+1] ; i++ )
+			{
+				int e = sortedEdges[i], v = topo->heHead[ topo->heTwin[e] ];
+				
+				if ( topo->vertLastEdge[v] == -1 )
+					topo->vertEdge[v] = e;
+				else
+					topo->heNextOut[ topo->vertLastEdge[v] ] = e;
+				topo->vertLastEdge[v] = e;
+			}
+		}
+	} );
+	
+	nVerts = _nVerts;
+	nEdges = nHalfEdges;
+	nFaces = _nFaces;
+	
+	/* Filling the edge index is a serial job : it is done the first time the index is needed. */
+	edgeIndexValid = false;
+	
+	this->countNonTriangles();
+	this->resizeProperties();
+	
+	if ( _progress != NULL )
+		_progress->facesBuilt = _nFaces;
+	
+	return 1;
+}
+
+int Mesh::loadOBJ(char *_path, int _nThreads, LoadProgress *_progress)
+{
+	/* For .obj format spec., see http://en.wikipedia.org/wiki/Wavefront_.obj_file */
+	MappedFile		file;
+	ObjBuffer		obj;
+	const char*		error;
+	
+	/* Clearing the mesh. */
+	this->clear();
+	
+	/* If the file can not be mapped in memory.
+	   Print an error message and return -1.
+	*/
+	if ( file.open( _path ) == -1 )
+	{
+		cout<<"Error while opening the file \""<<_path<<"\""<<endl;
+		cout<<"Method Mesh::loadOBJ is returning -1, check it if you didn't"<<endl;
+		return -1;
+	}
+	
+	if ( _nThreads < 1 )
+		_nThreads = tools_nThreads();
+	
+	if ( _progress != NULL )
+	{
+		/* The size of a compressed file says nothing about the size of its content. */
+		_progress->bytesTotal = file.isGzip() ? 0 : (long long)file.getSize();
+		_progress->stage = LOAD_PARSING;
+	}
+	
+	if ( _nThreads == 1 || file.isGzip() )
+	{
+		if ( file.isGzip() )
+		{
+			/* A compressed file is decompressed by a second thread while the blocks already decompressed are parsed. */
+			InputStream	in;
+			int			errorLine = 0;
+			
+			file.close();
+			
+			if ( in.open( _path ) == -1 || parser_streamLines( in, [&] ( const char* _begin, const char* _end )
+				{
+					const char* blockError = parser_parseOBJ( _begin, _end, obj );
+					
+					if ( _progress != NULL )
+					{
+						_progress->bytesRead += _end - _begin;
+						_progress->facesRead = obj.getNFaces();
+					}
+					
+					/* A cancelled load stops as a syntax error would, the error line is then ignored. */
+					return ( blockError == NULL && isCancelled( _progress ) ) ? _begin : blockError;
+				}, errorLine ) == -1 )
+			{
+				if ( isCancelled( _progress ) )
+					cout<<"Loading of the file \""<<_path<<"\" cancelled"<<endl;
+				else if ( errorLine == 0 )
+					cout<<"Error while decompressing the file \""<<_path<<"\""<<endl;
+				else
+					cout<<"Error while reading the file \""<<_path<<"\" at line "<<errorLine<<endl;
+				cout<<"Method Mesh::loadOBJ is returning -1, check it if you didn't"<<endl;
+				return -1;
+			}
+		}
+		
+		else
+		{
+			/* Parsing the whole file : vertices and faces are stored in flat arrays.
+			   The file is parsed in slices cut at line boundaries, so that the progress is updated and the cancellation checked regularly. */
+			const char*	begin = file.getData();
+			const char*	end = file.getData() + file.getSize();
+			
+			for ( const char* p = begin ; p < end ; )
+			{
+				const char* stop = ( end - p > LOAD_SLICE_SIZE ) ? p + LOAD_SLICE_SIZE : end;
+				
+				if ( stop < end && stop[-1] != '\n' )
+					parser_nextLine( stop, end );
+				
+				error = parser_parseOBJ( p, stop, obj );
+				
+				if ( error != NULL )
+				{
+					cout<<"Error while reading the file \""<<_path<<"\" at line "<<1 + count( begin, error, '\n' )<<endl;
+					cout<<"Method Mesh::loadOBJ is returning -1, check it if you didn't"<<endl;
+					return -1;
+				}
+				
+				p = stop;
+				
+				if ( _progress != NULL )
+				{
+					_progress->bytesRead = p - begin;
+					_progress->facesRead = obj.getNFaces();
+				}
+				
+				if ( isCancelled( _progress ) )
+				{
+					cout<<"Loading of the file \""<<_path<<"\" cancelled"<<endl;
+					cout<<"Method Mesh::loadOBJ is returning -1, check it if you didn't"<<endl;
+					return -1;
+				}
+			}
+			
+			file.close();
+		}
+		
+		/* Then the mesh is built from these arrays. */
+		int result;
+		
+		if ( _progress != NULL )
+			_progress->stage = LOAD_BUILDING;
+		
+		if ( _nThreads == 1 )
+			result = this->build( obj.getNVerts(), obj.positions.data(), obj.getNFaces(), obj.faceStarts.data(), obj.indices.data(), _progress );
+		else
+			result = this->buildParallel( obj.getNVerts(), obj.positions.data(), obj.getNFaces(), obj.faceStarts.data(), obj.indices.data(), _nThreads, _progress );
+		
+		if ( result == -1 )
+		{
+			if ( isCancelled( _progress ) )
+				cout<<"Loading of the file \""<<_path<<"\" cancelled"<<endl;
+			else
+				cout<<"Error while loading the file \""<<_path<<"\""<<endl;
+			cout<<"Method Mesh::loadOBJ is returning -1, check it if you didn't"<<endl;
+			return -1;
+		}
+		
+		return 1;
+	}
+	
+	/* The file is split in chunks which begin at the beginning of a line. */
+	int					T = _nThreads;
+	const char*			begin = file.getData();
+	const char*			end = file.getData() + file.getSize();
+	vector<const char*>	bounds( T+1 );
+	vector<const char*>	errors( T, (const char*)NULL );
+	vector<ObjChunk>	chunks( T );
+	vector<int>			vertBase( T+1, 0 ), faceBase( T+1, 0 ), indexBase( T+1, 0 );
+	
+	bounds[0] = begin;
+	bounds[T] = end;
+	for ( int t = 1 ; t < T ; t++ )
+	{
+		const char* p = begin + (size_t)( (long double)file.getSize() * t / T );
+		
+		if ( p < bounds[t-1] )
+			p = bounds[t-1];
+		else if ( p > begin && p[-1] != '\n' )
+			parser_nextLine( p, end );
+		
+		bounds[t] = p;
+	}
+	
+	/* Each chunk is parsed on its own : the indices of the faces are kept relative to the chunk when they are negative. */
+	tools_parallelFor( T, T, [&] ( int _begin, int _end, int )
+	{
+		for ( int t = _begin ; t < _end ; t++ )
+		{
+			errors[t] = parser_parseOBJ( bounds[t], bounds[t+1], chunks[t] );
+			
+			if ( _progress != NULL )
+			{
+				_progress->bytesRead += bounds[t+1] - bounds[t];
+				_progress->facesRead += chunks[t].getNFaces();
+			}
+		}
+	} );
+	
+	for ( int t = 0 ; t < T ; t++ )
+	{
+		if ( errors[t] != NULL )
+		{
+			cout<<"Error while reading the file \""<<_path<<"\" at line "<<1 + count( begin, errors[t], '\n' )<<endl;
+			cout<<"Method Mesh::loadOBJ is returning -1, check it if you didn't"<<endl;
+			return -1;
+		}
+	}
+	
+	file.close();
+	
+	if ( isCancelled( _progress ) )
+	{
+		cout<<"Loading of the file \""<<_path<<"\" cancelled"<<endl;
+		cout<<"Method Mesh::loadOBJ is returning -1, check it if you didn't"<<endl;
+		return -1;
+	}
+	
+	/* Merging the chunks. */
+	for ( int t = 0 ; t < T ; t++ )
+	{
+		vertBase[t+1] = vertBase[t] + chunks[t].getNVerts();
+		faceBase[t+1] = faceBase[t] + chunks[t].getNFaces();
+		indexBase[t+1] = indexBase[t] + (int)chunks[t].indices.size();
+	}
+	
+	obj.positions.resize( 3 * (size_t)vertBase[T] );
+	obj.faceStarts.resize( faceBase[T] + 1 );
+	obj.indices.resize( indexBase[T] );
+	obj.faceStarts[ faceBase[T] ] = indexBase[T];
+	
+	tools_parallelFor( T, T, [&] ( int _begin, int _end, int )
+	{
+		for ( int t = _begin ; t < _end ; t++ )
+		{
+			ObjChunk& c = chunks[t];
+			
+			std::copy( c.positions.begin(), c.positions.end(), obj.positions.begin() + 3 * (size_t)vertBase[t] );
+			
+			for ( int i = 0 ; i < c.getNFaces() ; i++ )
+				obj.faceStarts[ faceBase[t] + i ] = indexBase[t] + c.faceStarts[i];
+			
+			/* The relative indices are given an absolute value now that the vertices of the previous chunks are known. */
+			for ( int i = 0 ; i < (int)c.relative.size() ; i++ )
+				c.indices[ c.relative[i] ] += vertBase[t];
+			
+			std::copy( c.indices.begin(), c.indices.end(), obj.indices.begin() + indexBase[t] );
+			
+			vector<double>().swap( c.positions );
+			vector<int>().swap( c.indices );
+		}
+	} );
+	
+	/* Then the mesh is built from these arrays. */
+	if ( _progress != NULL )
+		_progress->stage = LOAD_BUILDING;
+	
+	if ( this->buildParallel( vertBase[T], obj.positions.data(), faceBase[T], obj.faceStarts.data(), obj.indices.data(), T, _progress ) == -1 )
+	{
+		if ( isCancelled( _progress ) )
+			cout<<"Loading of the file \""<<_path<<"\" cancelled"<<endl;
+		else
+			cout<<"Error while loading the file \""<<_path<<"\""<<endl;
+		cout<<"Method Mesh::loadOBJ is returning -1, check it if you didn't"<<endl;
+		return -1;
+	}
+	
+	return 1;
+}
+
+int Mesh::saveOBJ(char *_path, bool _normals)
+{
+	FileWriter file;
+	
+	/* If the file can not be created.
+	   Print an error message and return -1.
+	*/
+	if ( file.open( _path ) == -1 )
+	{
+		cout<<"Error while opening the file \""<<_path<<"\""<<endl;
+		cout<<"Method Mesh::saveOBJ is returning -1, check it if you didn't"<<endl;
+		return -1;
+	}
+	
+	file.writeText( "# written by SML\n" );
+	
+	for ( int i = 0 ; i < nVerts ; i++ )
+	{
+		const Real* pos = &positions[ 3 * (size_t)i ];
+		
+		file.writeText( "v " );
+		file.writeReal( pos[0] );
+		file.writeChar( ' ' );
+		file.writeReal( pos[1] );
+		file.writeChar( ' ' );
+		file.writeReal( pos[2] );
+		file.writeChar( '\n' );
+	}
+	
+	if ( _normals )
+	{
+		for ( int i = 0 ; i < nVerts ; i++ )
+		{
+			const Real* normal = &normals[ 3 * (size_t)i ];
+			
+			file.writeText( "vn " );
+			file.writeReal( normal[0] );
+			file.writeChar( ' ' );
+			file.writeReal( normal[1] );
+			file.writeChar( ' ' );
+			file.writeReal( normal[2] );
+			file.writeChar( '\n' );
+		}
+	}
+	
+	for ( int i = 0 ; i < nFaces ; i++ )
+	{
+		/* Each vertex has its own normal : "f v//v ...". */
+		file.writeChar( 'f' );
+		for ( int j = topo->faceStart[i] ; j < topo->faceStart[i+1] ; j++ )
+		{
+			int index = topo->heHead[ topo->heTwin[ topo->faceEdges[j] ] ] + 1;
+			
+			file.writeChar( ' ' );
+			file.writeInt( index );
+			if ( _normals )
+			{
+				file.writeText( "//" );
+				file.writeInt( index );
+			}
+		}
+		file.writeChar( '\n' );
+	}
+	
+	if ( file.close() == -1 )
+	{
+		cout<<"Error while writing the file \""<<_path<<"\""<<endl;
+		cout<<"Method Mesh::saveOBJ is returning -1, check it if you didn't"<<endl;
+		return -1;
+	}
+	
+	return 1;
+}
+
+int Mesh::saveBinary(char *_path)
+{
+	BinaryHeader	header;
+	FILE*			file;
+	bool			ok = true;
+	vector<int>		tails( nEdges ), edgeFaceStarts( nEdges+1, 0 ), vertEdgeStarts( nVerts+1, 0 );
+	vector<int>		edgeFaces, vertEdges;
+	
+	/* The arrays of the mesh are written as they are, the lists (faces of the half edges, half edges of the vertices) are flattened. */
+	for ( int i = 0 ; i < nVerts ; i++ )
+	{
+		for ( int e = topo->vertEdge[i] ; e != -1 ; e = topo->heNextOut[e] )
+			vertEdges.push_back( e );
+		vertEdgeStarts[i+1] = (int)vertEdges.size();
+	}
+	
+	for ( int i = 0 ; i < nEdges ; i++ )
+	{
+		tails[i] = topo->heHead[ topo->heTwin[i] ];
+		
+		if ( topo->heFace[i] != -1 )
+			edgeFaces.push_back( topo->heFace[i] );
+		for ( int x = topo->heExtra[i] ; x != -1 ; x = topo->extraNext[x] )
+			edgeFaces.push_back( topo->extraFace[x] );
+		edgeFaceStarts[i+1] = (int)edgeFaces.size();
+	}
+	
+	memset( &header, 0, sizeof( header ) );
+	memcpy( header.magic, "SMLB", 4 );
+	header.version = SMLB_VERSION;
+	header.byteOrder = SMLB_BYTE_ORDER;
+	header.nVerts = nVerts;
+	header.nEdges = nEdges;
+	header.nFaces = nFaces;
+	header.nFaceEdges = topo->faceStart[nFaces];
+	header.nEdgeFaces = (int)edgeFaces.size();
+	header.nVertEdges = (int)vertEdges.size();
+	
+	file = fopen( _path, "wb" );
+	
+	/* If the file can not be opened.
+	   Print an error message and return -1.
+	*/
+	if ( file == NULL )
+	{
+		cout<<"Error while opening the file \""<<_path<<"\""<<endl;
+		cout<<"Method Mesh::saveBinary is returning -1, check it if you didn't"<<endl;
+		return -1;
+	}
+	
+	/* Each array is written in one call. */
+	auto write = [&] ( const void* _data, size_t _size )
+	{
+		if ( ok && _size > 0 && fwrite( _data, 1, _size, file ) != _size )
+			ok = false;
+	};
+
+	/* The values are always saved as doubles : a file is the same whatever the precision the library is compiled with. */
+	auto writeReals = [&] ( const vector<Real>& _values )
+	{
+		if ( sizeof( Real ) == sizeof( double ) )
+			write( _values.data(), _values.size() * sizeof( double ) );
+		else
+		{
+			vector<double> values( _values.begin(), _values.end() );
+
+			write( values.data(), values.size() * sizeof( double ) );
+		}
+	};
+
+	write( &header, sizeof( header ) );
+	writeReals( positions );
+	writeReals( normals );
+	writeReals( colors );
+	writeReals( faceNormals );
+	write( tails.data(), tails.size() * sizeof( int ) );
+	write( topo->heHead.data(), topo->heHead.size() * sizeof( int ) );
+	write( topo->heTwin.data(), topo->heTwin.size() * sizeof( int ) );
+	write( topo->faceStart.data(), topo->faceStart.size() * sizeof( int ) );
+	write( topo->faceEdges.data(), topo->faceEdges.size() * sizeof( int ) );
+	write( edgeFaceStarts.data(), edgeFaceStarts.size() * sizeof( int ) );
+	write( edgeFaces.data(), edgeFaces.size() * sizeof( int ) );
+	write( vertEdgeStarts.data(), vertEdgeStarts.size() * sizeof( int ) );
+	write( vertEdges.data(), vertEdges.size() * sizeof( int ) );
+	
+	if ( fclose( file ) != 0 )
+		ok = false;
+	
+	if ( !ok )
+	{
+		cout<<"Error while writing the file \""<<_path<<"\""<<endl;
+		cout<<"Method Mesh::saveBinary is returning -1, check it if you didn't"<<endl;
+		return -1;
+	}
+	
+	return 1;
+}
+
+int Mesh::loadBinary(char *_path, int _nThreads)
+{
+	MappedFile		file;
+	BinaryHeader	header;
+	size_t			expected;
+	
+	/* Clearing the mesh. */
+	this->clear();
+	
+	/* If the file can not be mapped in memory.
+	   Print an error message and return -1.
+	*/
+	if ( file.open( _path ) == -1 )
+	{
+		cout<<"Error while opening the file \""<<_path<<"\""<<endl;
+		cout<<"Method Mesh::loadBinary is returning -1, check it if you didn't"<<endl;
+		return -1;
+	}
+	
+	if ( file.getSize() < sizeof( header ) )
+		memset( &header, 0, sizeof( header ) );
+	else
+		memcpy( &header, file.getData(), sizeof( header ) );
+	
+	if ( memcmp( header.magic, "SMLB", 4 ) != 0 || header.byteOrder != SMLB_BYTE_ORDER || header.version != SMLB_VERSION )
+	{
+		cout<<"Error while reading the file \""<<_path<<"\" : not a binary mesh of version "<<SMLB_VERSION<<" saved with the byte order of this computer"<<endl;
+		cout<<"Method Mesh::loadBinary is returning -1, check it if you didn't"<<endl;
+		return -1;
+	}
+	
+	int V = header.nVerts, E = header.nEdges, F = header.nFaces;
+	
+	/* The counts are checked before the size is computed from them (in size_t : a count of INT_MAX must not overflow). */
+	if ( V >= 0 && E >= 0 && F >= 0 && header.nFaceEdges >= 0 && header.nEdgeFaces >= 0 && header.nVertEdges >= 0 )
+		expected = sizeof( header ) + sizeof( double ) * ( 9 * (size_t)V + 3 * (size_t)F )
+				 + sizeof( int ) * ( 3 * (size_t)E + ( (size_t)F + 1 ) + (size_t)header.nFaceEdges + ( (size_t)E + 1 ) + (size_t)header.nEdgeFaces + ( (size_t)V + 1 ) + (size_t)header.nVertEdges );
+	else
+		expected = 0;
+	
+	if ( expected == 0 || file.getSize() != expected )
+	{
+		cout<<"Error while reading the file \""<<_path<<"\" : the file is truncated or corrupted"<<endl;
+		cout<<"Method Mesh::loadBinary is returning -1, check it if you didn't"<<endl;
+		return -1;
+	}
+	
+	/* The arrays are used in place, in the mapped file. */
+	const double*	positions = (const double*)( file.getData() + sizeof( header ) );
+	const double*	normals = positions + 3 * (size_t)V;
+	const double*	colors = normals + 3 * (size_t)V;
+	const double*	faceNormals = colors + 3 * (size_t)V;
+	const int*		tails = (const int*)( faceNormals + 3 * (size_t)F );
+	const int*		heads = tails + E;
+	const int*		twins = heads + E;
+	const int*		faceStarts = twins + E;
+	const int*		loops = faceStarts + F+1;
+	const int*		edgeFaceStarts = loops + header.nFaceEdges;
+	const int*		edgeFaces = edgeFaceStarts + E+1;
+	const int*		vertEdgeStarts = edgeFaces + header.nEdgeFaces;
+	const int*		vertEdges = vertEdgeStarts + V+1;
+	
+	/* Every index is checked before anything is built, so that a bad file can not leave a half built mesh. */
+	bool valid = checkIndices( tails, E, 0, V ) && checkIndices( heads, E, 0, V ) && checkIndices( twins, E, 0, E )
+			  && checkStarts( faceStarts, F, header.nFaceEdges ) && checkIndices( loops, header.nFaceEdges, 0, E )
+			  && checkStarts( edgeFaceStarts, E, header.nEdgeFaces ) && checkIndices( edgeFaces, header.nEdgeFaces, 0, F )
+			  && checkStarts( vertEdgeStarts, V, header.nVertEdges ) && checkIndices( vertEdges, header.nVertEdges, 0, E )
+			  && header.nVertEdges == E;
+	
+	/* The half edges go by pairs of twins, and each half edge is in the list of its tail vertex exactly once. */
+	for ( int i = 0 ; i < E && valid ; i++ )
+		valid = ( twins[i] != i && twins[ twins[i] ] == i && tails[i] == heads[ twins[i] ] );
+	
+	if ( valid )
+	{
+		vector<char> listed( E, 0 );
+		
+		for ( int i = 0 ; i < V && valid ; i++ )
+		{
+			for ( int j = vertEdgeStarts[i] ; j < vertEdgeStarts[i+1] && valid ; j++ )
+			{
+				valid = ( tails[ vertEdges[j] ] == i && !listed[ vertEdges[j] ] );
+				listed[ vertEdges[j] ] = 1;
+			}
+		}
+	}
+	
+	if ( !valid )
+	{
+		cout<<"Error while reading the file \""<<_path<<"\" : the file is corrupted"<<endl;
+		cout<<"Method Mesh::loadBinary is returning -1, check it if you didn't"<<endl;
+		return -1;
+	}
+	
+	if ( _nThreads < 1 )
+		_nThreads = tools_nThreads();
+	
+	/* The arrays of the file are copied, the lists are linked. */
+	this->positions.assign( positions, positions + 3 * (size_t)V );
+	this->normals.assign( normals, normals + 3 * (size_t)V );
+	this->colors.assign( colors, colors + 3 * (size_t)V );
+	this->faceNormals.assign( faceNormals, faceNormals + 3 * (size_t)F );
+	topo->heHead.assign( heads, heads + E );
+	topo->heTwin.assign( twins, twins + E );
+	topo->faceStart.assign( faceStarts, faceStarts + F+1 );
+	topo->faceEdges.assign( loops, loops + header.nFaceEdges );
+	
+	topo->heNext.assign( E, -1 );
+	topo->hePrev.assign( E, -1 );
+	topo->heFace.assign( E, -1 );
+	topo->heNextOut.assign( E, -1 );
+	topo->heExtra.assign( E, -1 );
+	topo->vertEdge.assign( V, -1 );
+	topo->vertLastEdge.assign( V, -1 );
+	
+	tools_parallelFor( E, _nThreads, [&] ( int _begin, int _end, int )
+	{
+		for ( int i = _begin ; i < _end ; i++ )
+			if ( edgeFaceStarts[i] < edgeFaceStarts[i+1] )
+				topo->heFace[i] = edgeFaces[ edgeFaceStarts[i] ];
+	} );
+	
+	/* Only the non manifold half edges have extra faces. */
+	for ( int i = 0 ; i < E ; i++ )
+		for ( int j = edgeFaceStarts[i] + 1 ; j < edgeFaceStarts[i+1] ; j++ )
+			this->addEdgeFace( i, edgeFaces[j] );
+	
+	tools_parallelFor( F, _nThreads, [&] ( int _begin, int _end, int )
+	{
+		for ( int i = _begin ; i < _end ; i++ )
+			this->linkFace( i );
+	} );
+	
+	tools_parallelFor( V, _nThreads, [&] ( int _begin, int _end, int )
+	{
+		for ( int i = _begin ; i < _end ; i++ )
+		{
+			for ( int j = vertEdgeStarts[i] ; j < vertEdgeStarts[i+1] ; j++ )
+			{
+				if ( j == vertEdgeStarts[i] )
+					topo->vertEdge[i] = vertEdges[j];
+				else
+					topo->heNextOut[ vertEdges[j-1] ] = vertEdges[j];
+				topo->vertLastEdge[i] = vertEdges[j];
+			}
+		}
+	} );
+	
+	nVerts = V;
+	nEdges = E;
+	nFaces = F;
+	
+	/* The edge index is rebuilt the first time it is needed. */
+	edgeIndexValid = false;
+	
+	this->countNonTriangles();
+	this->resizeProperties();
+	
+	return 1;
+}
+
+int Mesh::loadPLY(char *_path, int _nThreads)
+{
+	/* For .ply format spec., see http://paulbourke.net/dataformats/ply/ */
+	MappedFile		file;
+	PlyHeader		header;
+	vector<double>	positions, colors;
+	vector<int>		faceStarts( 1, 0 ), indices;
+	
+	/* Clearing the mesh. */
+	this->clear();
+	
+	/* If the file can not be mapped in memory.
+	   Print an error message and return -1.
+	*/
+	if ( file.open( _path ) == -1 )
+	{
+		cout<<"Error while opening the file \""<<_path<<"\""<<endl;
+		cout<<"Method Mesh::loadPLY is returning -1, check it if you didn't"<<endl;
+		return -1;
+	}
+	
+	if ( header.read( file.getData(), file.getSize() ) == -1 )
+	{
+		cout<<"Error while reading the header of the file \""<<_path<<"\""<<endl;
+		cout<<"Method Mesh::loadPLY is returning -1, check it if you didn't"<<endl;
+		return -1;
+	}
+	
+	if ( header.getFormat() != PLY_BINARY_LE )
+	{
+		cout<<"Error while reading the file \""<<_path<<"\" : only the binary little endian ply files are supported"<<endl;
+		cout<<"Method Mesh::loadPLY is returning -1, check it if you didn't"<<endl;
+		return -1;
+	}
+	
+	const vector<PlyElement>&	elements = header.getElements();
+	const char*					p = file.getData() + header.getSize();
+	const char*					end = file.getData() + file.getSize();
+	bool						truncated = false;
+	
+	for ( int e = 0 ; e < (int)elements.size() && !truncated ; e++ )
+	{
+		const PlyElement&	element = elements[e];
+		int					rowSize = element.getRowSize();
+		
+		if ( element.name == "vertex" )
+		{
+			/* The vertices have fixed size rows : each property is read at its offset in the row. */
+			int			prop[6], offset[6], scale[6];
+			const char*	names[6] = { "x", "y", "z", "red", "green", "blue" };
+			
+			for ( int k = 0 ; k < 6 ; k++ )
+			{
+				prop[k] = element.findProperty( names[k] );
+				offset[k] = 0;
+				for ( int j = 0 ; j < prop[k] ; j++ )
+					offset[k] += ply_typeSize( element.properties[j].type );
+				
+				/* Integer color components are scaled to [0, 1]. */
+				if ( prop[k] != -1 )
+				{
+					int type = element.properties[ prop[k] ].type;
+					scale[k] = ( type == PLY_UCHAR ) ? 255 : ( type == PLY_USHORT ) ? 65535 : 1;
+				}
+			}
+			
+			if ( rowSize == -1 || prop[0] == -1 || prop[1] == -1 || prop[2] == -1 )
+			{
+				cout<<"Error while reading the file \""<<_path<<"\" : the vertices must have x, y and z properties and no list property"<<endl;
+				cout<<"Method Mesh::loadPLY is returning -1, check it if you didn't"<<endl;
+				return -1;
+			}
+			
+			if ( (size_t)( end - p ) < (size_t)element.count * rowSize )
+			{
+				truncated = true;
+				break;
+			}
+			
+			bool hasColors = ( prop[3] != -1 && prop[4] != -1 && prop[5] != -1 );
+			
+			positions.resize( 3 * (size_t)element.count );
+			if ( hasColors )
+				colors.resize( 3 * (size_t)element.count );
+			
+			for ( int i = 0 ; i < element.count ; i++, p += rowSize )
+			{
+				for ( int k = 0 ; k < 3 ; k++ )
+					positions[3*i+k] = ply_readValue( p + offset[k], element.properties[ prop[k] ].type );
+				
+				if ( hasColors )
+					for ( int k = 0 ; k < 3 ; k++ )
+						colors[3*i+k] = ply_readValue( p + offset[3+k], element.properties[ prop[3+k] ].type ) / scale[3+k];
+			}
+		}
+		
+		else if ( element.name == "face" )
+		{
+			int list = element.findProperty( "vertex_indices" );
+			
+			if ( list == -1 )
+				list = element.findProperty( "vertex_index" );
+			
+			if ( list == -1 || element.properties[list].countType == -1 )
+			{
+				cout<<"Error while reading the file \""<<_path<<"\" : the faces must have a vertex_indices list"<<endl;
+				cout<<"Method Mesh::loadPLY is returning -1, check it if you didn't"<<endl;
+				return -1;
+			}
+			
+			const PlyProperty&	indexList = element.properties[list];
+			int					countSize = ply_typeSize( indexList.countType ), indexSize = ply_typeSize( indexList.type );
+			
+			faceStarts.reserve( element.count + 1 );
+			indices.reserve( 3 * (size_t)element.count );
+			
+			for ( int i = 0 ; i < element.count && !truncated ; i++ )
+			{
+				for ( int j = 0 ; j < (int)element.properties.size() && !truncated ; j++ )
+				{
+					const PlyProperty& prop = element.properties[j];
+					
+					if ( j != list )
+					{
+						/* Other properties of the faces are skipped. */
+						const char* next = prop.skip( p, end );
+						
+						truncated = ( next == NULL );
+						p = next;
+					}
+					
+					else if ( p + countSize > end )
+						truncated = true;
+					
+					else
+					{
+						int n = (int)ply_readValue( p, indexList.countType );
+						
+						p += countSize;
+						if ( n < 0 || (size_t)( end - p ) < (size_t)n * indexSize )
+						{
+							truncated = true;
+							break;
+						}
+						
+						for ( int k = 0 ; k < n ; k++, p += indexSize )
+							indices.push_back( (int)ply_readValue( p, indexList.type ) );
+						
+						/* The faces with less than three vertices are dropped. */
+						if ( n < 3 )
+							indices.resize( indices.size() - n );
+						else
+							faceStarts.push_back( (int)indices.size() );
+					}
+				}
+			}
+		}
+		
+		else
+		{
+			/* Other elements are skipped. */
+			if ( rowSize != -1 )
+			{
+				if ( (size_t)( end - p ) < (size_t)element.count * rowSize )
+					truncated = true;
+				else
+					p += (size_t)element.count * rowSize;
+			}
+			
+			else
+			{
+				for ( int i = 0 ; i < element.count && !truncated ; i++ )
+				{
+					p = element.skipRow( p, end );
+					truncated = ( p == NULL );
+				}
+			}
+		}
+	}
+	
+	if ( truncated )
+	{
+		cout<<"Error while reading the file \""<<_path<<"\" : the file is truncated"<<endl;
+		cout<<"Method Mesh::loadPLY is returning -1, check it if you didn't"<<endl;
+		return -1;
+	}
+	
+	file.close();
+	
+	int nVertsRead = (int)( positions.size() / 3 );
+	int nFacesRead = (int)faceStarts.size() - 1;
+	int result;
+	
+	if ( _nThreads < 1 )
+		_nThreads = tools_nThreads();
+	
+	if ( _nThreads == 1 )
+		result = this->build( nVertsRead, positions.data(), nFacesRead, faceStarts.data(), indices.data() );
+	else
+		result = this->buildParallel( nVertsRead, positions.data(), nFacesRead, faceStarts.data(), indices.data(), _nThreads );
+	
+	if ( result == -1 )
+	{
+		cout<<"Error while loading the file \""<<_path<<"\""<<endl;
+		cout<<"Method Mesh::loadPLY is returning -1, check it if you didn't"<<endl;
+		return -1;
+	}
+	
+	if ( !colors.empty() )
+		this->colors.assign( colors.begin(), colors.end() );
+	
+	return 1;
+}
+
+int Mesh::savePLY(char *_path)
+{
+	vector<char>	buffer;
+	bool			hasColors = false;
+	int				maxSize = 0;
+	
+	for ( int i = 0 ; i < 3 * nVerts && !hasColors ; i++ )
+		hasColors = ( colors[i] != 0 );
+	
+	for ( int i = 0 ; i < nFaces ; i++ )
+		maxSize = max( maxSize, topo->faceStart[i+1] - topo->faceStart[i] );
+	
+	/* Header. */
+	ostringstream header;
+	
+	header<<"ply\nformat binary_little_endian 1.0\ncomment written by SML\n";
+	header<<"element vertex "<<nVerts<<"\nproperty double x\nproperty double y\nproperty double z\n";
+	if ( hasColors )
+		header<<"property uchar red\nproperty uchar green\nproperty uchar blue\n";
+	header<<"element face "<<nFaces<<"\nproperty list "<<( ( maxSize > 255 ) ? "int" : "uchar" )<<" int vertex_indices\nend_header\n";
+	
+	string text = header.str();
+	buffer.reserve( text.size() + (size_t)nVerts * 27 + (size_t)nFaces * 13 );
+	buffer.insert( buffer.end(), text.begin(), text.end() );
+	
+	/* Body. */
+	for ( int i = 0 ; i < nVerts ; i++ )
+	{
+		const Real* pos = &positions[ 3 * (size_t)i ];
+		
+		appendLE( buffer, (double)pos[0] );
+		appendLE( buffer, (double)pos[1] );
+		appendLE( buffer, (double)pos[2] );
+		
+		if ( hasColors )
+		{
+			const Real* c = &colors[ 3 * (size_t)i ];
+			
+			for ( int k = 0 ; k < 3 ; k++ )
+				appendLE( buffer, (unsigned char)( min( max( (double)c[k], 0.0 ), 1.0 ) * 255 + 0.5 ) );
+		}
+	}
+	
+	for ( int i = 0 ; i < nFaces ; i++ )
+	{
+		int n = topo->faceStart[i+1] - topo->faceStart[i];
+		
+		if ( maxSize > 255 )
+			appendLE( buffer, n );
+		else
+			appendLE( buffer, (unsigned char)n );
+		
+		for ( int j = topo->faceStart[i] ; j < topo->faceStart[i+1] ; j++ )
+			appendLE( buffer, topo->heHead[ topo->heTwin[ topo->faceEdges[j] ] ] );
+	}
+	
+	if ( !writeFile( _path, buffer ) )
+	{
+		cout<<"Error while writing the file \""<<_path<<"\""<<endl;
+		cout<<"Method Mesh::savePLY is returning -1, check it if you didn't"<<endl;
+		return -1;
+	}
+	
+	return 1;
+}
+
+int Mesh::loadSTL(char *_path, double _tolerance)
+{
+	MappedFile		file;
+	SpatialHash		welder( _tolerance );
+	vector<int>		faceStarts( 1, 0 ), indices;
+	unsigned int	nTriangles = 0;
+	
+	/* Clearing the mesh. */
+	this->clear();
+	
+	/* If the file can not be mapped in memory.
+	   Print an error message and return -1.
+	*/
+	if ( file.open( _path ) == -1 )
+	{
+		cout<<"Error while opening the file \""<<_path<<"\""<<endl;
+		cout<<"Method Mesh::loadSTL is returning -1, check it if you didn't"<<endl;
+		return -1;
+	}
+	
+	/* A binary STL file : a 80 bytes header, the number of triangles and 50 bytes per triangle
+	   (normal, three vertices as floats and a 2 bytes attribute). */
+	if ( file.getSize() >= 84 )
+		ply_copyLE( &nTriangles, file.getData() + 80, 4 );
+	
+	if ( file.getSize() < 84 || file.getSize() != 84 + 50 * (size_t)nTriangles )
+	{
+		cout<<"Error while reading the file \""<<_path<<"\" : not a binary stl file"<<endl;
+		cout<<"Method Mesh::loadSTL is returning -1, check it if you didn't"<<endl;
+		return -1;
+	}
+	
+	/* A closed mesh has about half as many vertices as triangles. */
+	welder.reserve( nTriangles / 2 + 3 );
+	faceStarts.reserve( nTriangles + 1 );
+	indices.reserve( 3 * (size_t)nTriangles );
+	
+	for ( const char* p = file.getData() + 84 ; p < file.getData() + file.getSize() ; p += 50 )
+	{
+		int v[3];
+		
+		for ( int k = 0 ; k < 3 ; k++ )
+		{
+			float pos[3];
+			
+			for ( int c = 0 ; c < 3 ; c++ )
+				ply_copyLE( &pos[c], p + 12 + 12 * k + 4 * c, 4 );
+			v[k] = welder.insert( pos[0], pos[1], pos[2] );
+		}
+		
+		/* A triangle that has two welded vertices would give degenerate edges. */
+		if ( v[0] != v[1] && v[1] != v[2] && v[2] != v[0] )
+		{
+			indices.insert( indices.end(), v, v+3 );
+			faceStarts.push_back( (int)indices.size() );
+		}
+	}
+	
+	file.close();
+	
+	if ( this->build( welder.getSize(), welder.getPoints().data(), (int)faceStarts.size() - 1, faceStarts.data(), indices.data() ) == -1 )
+	{
+		cout<<"Error while loading the file \""<<_path<<"\""<<endl;
+		cout<<"Method Mesh::loadSTL is returning -1, check it if you didn't"<<endl;
+		return -1;
+	}
+	
+	return 1;
+}
+
+int Mesh::saveSTL(char *_path)
+{
+	vector<char>	buffer( 80, 0 );
+	unsigned int	nTriangles = 0;
+	const char*		title = "binary STL written by SML";
+	
+	memcpy( buffer.data(), title, strlen( title ) );
+	
+	for ( int i = 0 ; i < nFaces ; i++ )
+		nTriangles += max( 0, topo->faceStart[i+1] - topo->faceStart[i] - 2 );
+	
+	buffer.reserve( 84 + 50 * (size_t)nTriangles );
+	appendLE( buffer, nTriangles );
+	
+	for ( int i = 0 ; i < nFaces ; i++ )
+	{
+		const int*	loop = &topo->faceEdges[ topo->faceStart[i] ];
+		int			n = topo->faceStart[i+1] - topo->faceStart[i];
+		
+		/* Fan triangulation from the first vertex of the face. */
+		for ( int j = 1 ; j+1 < n ; j++ )
+		{
+			Vertex		va( this, topo->heHead[ topo->heTwin[ loop[0] ] ] ), vb( this, topo->heHead[ topo->heTwin[ loop[j] ] ] ), vc( this, topo->heHead[ topo->heTwin[ loop[j+1] ] ] );
+			Vector3D	a = va.getPos(), b = vb.getPos(), c = vc.getPos();
+			double		u[3] = { b.getX() - a.getX(), b.getY() - a.getY(), b.getZ() - a.getZ() };
+			double		v[3] = { c.getX() - a.getX(), c.getY() - a.getY(), c.getZ() - a.getZ() };
+			double		n[3] = { u[1]*v[2] - u[2]*v[1], u[2]*v[0] - u[0]*v[2], u[0]*v[1] - u[1]*v[0] };
+			double		length = sqrt( n[0]*n[0] + n[1]*n[1] + n[2]*n[2] );
+			
+			for ( int k = 0 ; k < 3 ; k++ )
+				appendLE( buffer, (float)( ( length > 0 ) ? n[k] / length : 0 ) );
+			
+			appendLE( buffer, (float)a.getX() );	appendLE( buffer, (float)a.getY() );	appendLE( buffer, (float)a.getZ() );
+			appendLE( buffer, (float)b.getX() );	appendLE( buffer, (float)b.getY() );	appendLE( buffer, (float)b.getZ() );
+			appendLE( buffer, (float)c.getX() );	appendLE( buffer, (float)c.getY() );	appendLE( buffer, (float)c.getZ() );
+			appendLE( buffer, (unsigned short)0 );
+		}
+	}
+	
+	if ( !writeFile( _path, buffer ) )
+	{
+		cout<<"Error while writing the file \""<<_path<<"\""<<endl;
+		cout<<"Method Mesh::saveSTL is returning -1, check it if you didn't"<<endl;
+		return -1;
+	}
+	
+	return 1;
+}
+
+void Mesh::faceCross(int _f, double *_n)
+{
+	const int*		loop = &topo->faceEdges[ topo->faceStart[_f] ];
+	int				size = topo->faceStart[_f+1] - topo->faceStart[_f];
+	
+	if ( size == 3 )
+	{
+		const Real*		p0 = &positions[ 3 * (size_t)topo->heHead[ loop[2] ] ];
+		const Real*		p1 = &positions[ 3 * (size_t)topo->heHead[ loop[0] ] ];
+		const Real*		p2 = &positions[ 3 * (size_t)topo->heHead[ loop[1] ] ];
+		double			u[3] = { (double)p1[0] - p0[0], (double)p1[1] - p0[1], (double)p1[2] - p0[2] };
+		double			v[3] = { (double)p2[0] - p1[0], (double)p2[1] - p1[1], (double)p2[2] - p1[2] };
+		
+		_n[0] = u[1] * v[2] - u[2] * v[1];
+		_n[1] = u[2] * v[0] - u[0] * v[2];
+		_n[2] = u[0] * v[1] - u[1] * v[0];
+		return;
+	}
+	
+	/* Newell's method : the sum over the edges (p, q) of ( (py - qy) (pz + qz), (pz - qz) (px + qx), (px - qx) (py + qy) ). */
+	_n[0] = _n[1] = _n[2] = 0;
+	for ( int j = 0 ; j < size ; j++ )
+	{
+		const Real* p = &positions[ 3 * (size_t)topo->heHead[ loop[ ( j+size-1 ) % size ] ] ];
+		const Real* q = &positions[ 3 * (size_t)topo->heHead[ loop[j] ] ];
+		
+		_n[0] += ( (double)p[1] - q[1] ) * ( (double)p[2] + q[2] );
+		_n[1] += ( (double)p[2] - q[2] ) * ( (double)p[0] + q[0] );
+		_n[2] += ( (double)p[0] - q[0] ) * ( (double)p[1] + q[1] );
+	}
+}
+
+double Mesh::cornerAngle(int _f, int _j)
+{
+	const int*		loop = &topo->faceEdges[ topo->faceStart[_f] ];
+	int				size = topo->faceStart[_f+1] - topo->faceStart[_f];
+	const Real*		prev = &positions[ 3 * (size_t)topo->heHead[ loop[ ( _j+size-2 ) % size ] ] ];
+	const Real*		p = &positions[ 3 * (size_t)topo->heHead[ loop[ ( _j+size-1 ) % size ] ] ];
+	const Real*		next = &positions[ 3 * (size_t)topo->heHead[ loop[_j] ] ];
+	double			a[3] = { (double)next[0] - p[0], (double)next[1] - p[1], (double)next[2] - p[2] };
+	double			b[3] = { (double)prev[0] - p[0], (double)prev[1] - p[1], (double)prev[2] - p[2] };
+	double			c[3] = { a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0] };
+	
+	/* The angle between the edge leaving the vertex and the one arriving at it. */
+	return atan2( sqrt( c[0]*c[0] + c[1]*c[1] + c[2]*c[2] ), a[0]*b[0] + a[1]*b[1] + a[2]*b[2] );
+}
+
+double Mesh::faceWeight(int _weighting, int _e, int _f)
+{
+	if ( _weighting == NORMALS_AREA )
+	{
+		double n[3];
+		
+		this->faceCross( _f, n );
+		return 0.5 * sqrt( n[0] * n[0] + n[1] * n[1] + n[2] * n[2] );
+	}
+	
+	for ( int j = topo->faceStart[_f] ; j < topo->faceStart[_f+1] ; j++ )
+		if ( topo->faceEdges[j] == _e )
+			return this->cornerAngle( _f, j - topo->faceStart[_f] );
+	
+	return 0.0;
+}
+
+void Mesh::vertexNormal(int _v, int _weighting, const double *_faceWeight, const double *_edgeWeight, const double *_extraWeight)
+{
+	double	normal[3] = { 0, 0, 0 };
+	int		nbFaces = 0;
+	
+	/* Weight of the face _f of the half edge _e (item _x of its extra list, -1 for its first face), given by the arrays or computed. */
+	auto weight = [&] ( int _e, int _f, int _x )
+	{
+		if ( _weighting == NORMALS_UNIFORM )
+			return 1.0;
+		if ( _weighting == NORMALS_AREA && _faceWeight != NULL )
+			return _faceWeight[_f];
+		if ( _weighting == NORMALS_ANGLE && _edgeWeight != NULL )
+			return ( _x == -1 ) ? _edgeWeight[_e] : _extraWeight[_x];
+		
+		return this->faceWeight( _weighting, _e, _f );
+	};
+	
+	auto add = [&] ( int _e, int _f, int _x )
+	{
+		const Real*	n = &faceNormals[ 3 * (size_t)_f ];
+		double		w = weight( _e, _f, _x );
+		
+		/* A degenerate face has no normal : it does not count in the weighted means. */
+		if ( _weighting != NORMALS_UNIFORM && !( w > 0 ) )
+			return;
+		
+		normal[0] += w * n[0];
+		normal[1] += w * n[1];
+		normal[2] += w * n[2];
+		nbFaces++;
+	};
+	
+	/* We cover all the edges that goes from this vertex, in order to cover all the faces which contain this vertex. */
+	for ( int e = topo->vertEdge[_v] ; e != -1 ; e = topo->heNextOut[e] )
+	{
+		if ( topo->heFace[e] == -1 )
+			continue;
+		
+		add( e, topo->heFace[e], -1 );
+		for ( int x = topo->heExtra[e] ; x != -1 ; x = topo->extraNext[x] )
+			add( e, topo->extraFace[x], x );
+	}
+	
+	Real*	n = &normals[ 3 * (size_t)_v ];
+	
+	for ( int c = 0 ; c < 3 ; c++ )
+		normal[c] /= nbFaces;
+	
+	double norm = sqrt( normal[0]*normal[0] + normal[1]*normal[1] + normal[2]*normal[2] );
+	
+	n[0] = normal[0] / norm;
+	n[1] = normal[1] / norm;
+	n[2] = normal[2] / norm;
+}
+
+int Mesh::computeNormals(int _weighting, int _nThreads)
+{
+	if ( _weighting != NORMALS_UNIFORM && _weighting != NORMALS_AREA && _weighting != NORMALS_ANGLE )
+	{
+		cout<<"Error while computing the normals : "<<_weighting<<" is not a normals weighting"<<endl;
+		cout<<"Method Mesh::computeNormals is returning -1, check it if you didn't"<<endl;
+		return -1;
+	}
+	
+	/* In a triangle mesh, the loop of a face is at a known place and the tail of its first edge is the head of the third one. */
+	bool			tri = this->isTriangleMesh();
+	const int		block = 256;
+	vector<double>	faceWeight, edgeWeight, extraWeight;
+	
+	/* Weight of each face (area), or of each face at the tail of each half edge (angle) : the first face in edgeWeight, the other ones in extraWeight. */
+	if ( _weighting == NORMALS_AREA )
+		faceWeight.resize( nFaces );
+	else if ( _weighting == NORMALS_ANGLE )
+	{
+		edgeWeight.resize( nEdges );
+		extraWeight.resize( topo->extraFace.size() );
+	}
+	
+	/* Faces : each thread computes the normals of a range of faces, block by block.
+	   The edges of the triangles of a block are gathered first, their cross products are then computed in a loop without any indirection
+	   (which the compiler turns into SIMD instructions). The other faces get their sum of Newell (see faceCross). */
+	tools_parallelFor( nFaces, _nThreads, [&] ( int _begin, int _end, int )
+	{
+		double	u[3][block], v[3][block];
+		
+		for ( int first = _begin ; first < _end ; first += block )
+		{
+			int n = min( block, _end - first );
+			
+			for ( int k = 0 ; k < n ; k++ )
+			{
+				int				i = first + k;
+				const int*		loop = tri ? &topo->faceEdges[ 3 * (size_t)i ] : &topo->faceEdges[ topo->faceStart[i] ];
+				const Real*		p0 = &positions[ 3 * (size_t)topo->heHead[ tri ? loop[2] : topo->heTwin[ loop[0] ] ] ];
+				const Real*		p1 = &positions[ 3 * (size_t)topo->heHead[ loop[0] ] ];
+				const Real*		p2 = &positions[ 3 * (size_t)topo->heHead[ loop[1] ] ];
+				
+				for ( int c = 0 ; c < 3 ; c++ )
+				{
+					u[c][k] = (double)p1[c] - p0[c];
+					v[c][k] = (double)p2[c] - p1[c];
+				}
+			}
+			
+			for ( int k = 0 ; k < n ; k++ )
+			{
+				double x = u[1][k] * v[2][k] - u[2][k] * v[1][k];
+				double y = u[2][k] * v[0][k] - u[0][k] * v[2][k];
+				double z = u[0][k] * v[1][k] - u[1][k] * v[0][k];
+				
+				u[0][k] = x;
+				u[1][k] = y;
+				u[2][k] = z;
+			}
+			
+			if ( !tri )
+			{
+				for ( int k = 0 ; k < n ; k++ )
+				{
+					if ( topo->faceStart[first+k+1] - topo->faceStart[first+k] != 3 )
+					{
+						double w[3];
+						
+						this->faceCross( first+k, w );
+						u[0][k] = w[0];
+						u[1][k] = w[1];
+						u[2][k] = w[2];
+					}
+				}
+			}
+			
+			Real* normal = &faceNormals[ 3 * (size_t)first ];
+			
+			for ( int k = 0 ; k < n ; k++ )
+			{
+				double norm = sqrt( u[0][k] * u[0][k] + u[1][k] * u[1][k] + u[2][k] * u[2][k] );
+				
+				normal[3*k] = u[0][k] / norm;
+				normal[3*k+1] = u[1][k] / norm;
+				normal[3*k+2] = u[2][k] / norm;
+				
+				/* The length of the cross product (or of the sum of Newell) is twice the area of the face. */
+				if ( _weighting == NORMALS_AREA )
+					faceWeight[first+k] = 0.5 * norm;
+			}
+			
+			if ( _weighting != NORMALS_ANGLE )
+				continue;
+			
+			/* Angle of each face at each of its vertices. Each (half edge, face) pair is written by the thread of the face only. */
+			for ( int i = first ; i < first + n ; i++ )
+			{
+				for ( int j = topo->faceStart[i] ; j < topo->faceStart[i+1] ; j++ )
+				{
+					int		e = topo->faceEdges[j];
+					double	angle = this->cornerAngle( i, j - topo->faceStart[i] );
+					
+					if ( topo->heFace[e] == i )
+						edgeWeight[e] = angle;
+					else
+						for ( int x = topo->heExtra[e] ; x != -1 ; x = topo->extraNext[x] )
+							if ( topo->extraFace[x] == i )
+								extraWeight[x] = angle;
+				}
+			}
+		}
+	} );
+	
+	/* Vertices : the normal of a vertex is the mean of the weighted normals of its faces, normalized.
+	   Each vertex gathers the normals of its faces through its half edges : the threads only write their own vertices, no lock is needed. */
+	tools_parallelFor( nVerts, _nThreads, [&] ( int _begin, int _end, int )
+	{
+		for ( int i = _begin ; i < _end ; i++ )
+			this->vertexNormal( i, _weighting, faceWeight.data(), edgeWeight.data(), extraWeight.data() );
+	} );
+	
+	normalsValid = true;
+	normalsWeighting = _weighting;
+	movedFlags.assign( nVerts, 0 );
+	
+	return 1;
+}
+
+int Mesh::refreshNormals(int _nThreads)
+{
+	if ( !normalsValid )
+		return this->computeNormals( normalsWeighting, _nThreads );
+	
+	/* The moved vertices are found from their flags, each thread lists its own range. */
+	int					T = ( nVerts < 65536 ) ? 1 : ( ( _nThreads < 1 ) ? tools_nThreads() : _nThreads );
+	vector< vector<int> >	moved( T );
+	vector<int>			movedVerts;
+	
+	tools_parallelFor( nVerts, T, [&] ( int _begin, int _end, int _t )
+	{
+		for ( int i = _begin ; i < _end ; i++ )
+			if ( movedFlags[i] )
+				moved[_t].push_back( i );
+	} );
+	
+	for ( int t = 0 ; t < T ; t++ )
+		movedVerts.insert( movedVerts.end(), moved[t].begin(), moved[t].end() );
+	
+	if ( movedVerts.empty() )
+		return 1;
+	
+	/* The faces of the moved vertices, then the vertices of these faces (each one once). */
+	vector<int> faces, verts;
+	
+	for ( size_t i = 0 ; i < movedVerts.size() ; i++ )
+	{
+		for ( int e = topo->vertEdge[ movedVerts[i] ] ; e != -1 ; e = topo->heNextOut[e] )
+		{
+			if ( topo->heFace[e] == -1 )
+				continue;
+			
+			faces.push_back( topo->heFace[e] );
+			for ( int x = topo->heExtra[e] ; x != -1 ; x = topo->extraNext[x] )
+				faces.push_back( topo->extraFace[x] );
+		}
+	}
+	
+	sort( faces.begin(), faces.end() );
+	faces.erase( unique( faces.begin(), faces.end() ), faces.end() );
+	
+	for ( size_t i = 0 ; i < faces.size() ; i++ )
+		for ( int j = topo->faceStart[ faces[i] ] ; j < topo->faceStart[ faces[i]+1 ] ; j++ )
+			verts.push_back( topo->heHead[ topo->faceEdges[j] ] );
+	
+	sort( verts.begin(), verts.end() );
+	verts.erase( unique( verts.begin(), verts.end() ), verts.end() );
+	
+	/* A small edit is not worth starting threads. */
+	if ( faces.size() < 4096 )
+		_nThreads = 1;
+	
+	tools_parallelFor( (int)faces.size(), _nThreads, [&] ( int _begin, int _end, int )
+	{
+		for ( int i = _begin ; i < _end ; i++ )
+		{
+			double	w[3];
+			Real*	n = &faceNormals[ 3 * (size_t)faces[i] ];
+			
+			this->faceCross( faces[i], w );
+			
+			double norm = sqrt( w[0] * w[0] + w[1] * w[1] + w[2] * w[2] );
+			
+			n[0] = w[0] / norm;
+			n[1] = w[1] / norm;
+			n[2] = w[2] / norm;
+		}
+	} );
+	
+	/* The weights of the faces are computed again for these vertices only. */
+	tools_parallelFor( (int)verts.size(), _nThreads, [&] ( int _begin, int _end, int )
+	{
+		for ( int i = _begin ; i < _end ; i++ )
+			this->vertexNormal( verts[i], normalsWeighting, NULL, NULL, NULL );
+	} );
+	
+	for ( size_t i = 0 ; i < movedVerts.size() ; i++ )
+		movedFlags[ movedVerts[i] ] = 0;
+	
+	return 1;
 }
 
-void Mesh::addFace(Face *_f)
+void Mesh::markMoved(int _i)
 {
-	faces.push_back( _f );
-	nFaces++;
+	/* Only stores, nothing is allocated : the threads moving different vertices do not write the same data. */
+	boxValid.store( false, memory_order_relaxed );
+	
+	/* Nothing to track if every normal has to be computed anyway. */
+	if ( normalsValid )
+		movedFlags[_i] = 1;
 }
 
-int Mesh::loadOBJ(char *_path)
+int Mesh::getBoundingBox(Vector3D &_bot, Vector3D &_top, int _nThreads)
 {
-	/* For .obj format spec., see http://en.wikipedia.org/wiki/Wavefront_.obj_file */
-	char			type;
-	bool			vert = true;
-	ifstream		file ( _path, ifstream::in );
-	
-	/* Clearing the mesh. */
-	this->clear();
-	
-	/* If the file is not opened and attached to the file stream.
-	   Print an error message and return -1.
-	*/
-	if ( ! file.is_open() )
-	{
-		cout<<"Error while opening the file \""<<_path<<"\""<<endl;
-		cout<<"Method Mesh::loadOBJ is returning -1, check it if you didn't"<<endl;
+	if ( nVerts == 0 )
 		return -1;
-	}
 	
-	/* Reading the first character of the file. */
-	file >> type;
-	/* If the character read is a 'v' then we have to red a vertex list. */
-	vert = ( type == 'v' );
-	
-	/* A 'v' character has been read, we are going to read the vertex list. */
-	while ( file.good() && vert == true )
-	{
-		/* Allocate three variable to get the space coordinates of the vertex. */
-		float x, y, z;
-		
-		/* Processing the vertex line : we read the 3 components of the vertex location and then add the mesh a pointer to the vertex created from these coordinates. */
-		file >> x;
-		file >> y;
-		file >> z;
-		this->addVertex( new Vertex( this->getNVerts(), Vector3D( x, y, z ) ) );
-		
-		/* Read another character and check for its value ('v' or not ) in order to stop (or not) the loop. */
-		file >> type;
-		vert = ( type == 'v' );
-	}
-		
-	/* Once the vertices list has been read, we have to read the face list. */
-	while ( file.good() )
+	if ( !boxValid )
 	{
-		/* Declaring a new face. */
-		Face*			f = new Face( this->getNFaces() );
-		char			faceList[255];
-		int				index = -5;
+		/* Small meshes are not worth starting threads. */
+		int				T = ( nVerts < 65536 ) ? 1 : ( ( _nThreads < 1 ) ? tools_nThreads() : _nThreads );
+		vector<Real>	bot( 3 * (size_t)T ), top( 3 * (size_t)T );
 		
-		/* Reading the entire line to get the index of the vertices componing the face. */
-		file.getline( faceList, 255 );
-		
-		/* Allocate variables to store the first indexe of the face row and two to read the index of the tail and head vertex of each edge of the face. */
-		int first;
-		int iTail, iHead;
-		
-		/* The last line is not to read, it only contains "\n" so that faceList only contains a empty string. */
-		if ( strcmp( "", faceList ) != 0 )
+		tools_parallelFor( nVerts, T, [&] ( int _begin, int _end, int _t )
 		{
-			/* Declaring an istrinstream to read the line word per word. */
-			istringstream	iss ( faceList, istringstream::in );
-			/* Ignore the first word of the line which should be 'f'. */
-			iss.ignore(255,' ');
-						
-			/* Reading the first edge of the face. */
-			iss >> first;
-			iss >> iHead;
-			iTail = first;
+			const Real*	p = &positions[ 3 * (size_t)_begin ];
+			size_t		n = 3 * (size_t)( _end - _begin );
+			size_t		i = 0;
+			Real		lo[12], hi[12];
+			
+			/* Four vertices at a time : twelve independent minimums and maximums, the loop is vectorized without any branch. */
+			for ( int k = 0 ; k < 12 ; k++ )
+				lo[k] = hi[k] = p[k%3];
 			
-			/* We read the line word per word. */
-			while ( iss.good() )
+			for ( ; i + 12 <= n ; i += 12 )
 			{
-				iTail -= 1;
-				iHead -= 1;
-				/* So that the index goes from 0. */
-				
-				index = this->getIVert( iTail )->containsEdge( iTail, iHead );
-				if ( index == -1 )
-				{
-					/* If the iTail vertex does not have the edge [iTail, iHead] yet, we have to create the edge and its twin */
-					Edge* e = new Edge ( this->getNEdges(), this->getIVert( iTail ), this->getIVert( iHead) );
-					Edge* eTwin = new Edge ( this->getNEdges()+1, this->getIVert( iHead ), this->getIVert( iTail ) );
-					
-					e->setTwin( eTwin );
-					eTwin->setTwin( e );
-					
-					e->addFace( f );
-					f->addEdge( e );
-					
-					this->addEdge( e );
-					this->addEdge( eTwin );
-					
-					this->addEdgeToIVertex( iTail, e );
-					this->addEdgeToIVertex( iHead, eTwin );
-				}
-				
-				else
+				for ( int k = 0 ; k < 12 ; k++ )
 				{
-					/* The edge already exists, we just have to add it to the face and to add the face to the edge */
-					f->addEdge( this->getIEdge( index ) );
-					this->addFaceToIEdge( index, f );
+					lo[k] = ( p[i+k] < lo[k] ) ? p[i+k] : lo[k];
+					hi[k] = ( p[i+k] > hi[k] ) ? p[i+k] : hi[k];
 				}
-				
-				iTail = iHead;
-				iss >> iHead;
 			}
 			
-			/* Now checking the [iTail, iHead] edge which is not taken in acount by the while loop. */
-			iHead -= 1;
-			
-			index = this->getIVert( iTail )->containsEdge( iTail, iHead );
-			if ( index == -1 )
+			for ( ; i < n ; i++ )
 			{
-				Edge* e = new Edge ( this->getNEdges(), this->getIVert( iTail ), this->getIVert( iHead) );
-				Edge* eTwin = new Edge ( this->getNEdges()+1, this->getIVert( iHead ), this->getIVert( iTail ) );
-				
-				e->setTwin( eTwin );
-				eTwin->setTwin( e );
-				
-				e->addFace( f );
-				f->addEdge( e );
-				
-				this->addEdge( e );
-				this->addEdge( eTwin );
-				
-				this->addEdgeToIVertex( iTail, e );
-				this->addEdgeToIVertex( iHead, eTwin );
+				lo[i%3] = min( lo[i%3], p[i] );
+				hi[i%3] = max( hi[i%3], p[i] );
 			}
 			
-			else
+			for ( int k = 3 ; k < 12 ; k++ )
 			{
-				f->addEdge( this->getIEdge( index ) );
-				this->addFaceToIEdge( index, f );
+				lo[k%3] = min( lo[k%3], lo[k] );
+				hi[k%3] = max( hi[k%3], hi[k] );
 			}
 			
-			/* Now checking the [last, first] edge of the face. */
-			iTail = iHead;
-			iHead = first-1;
-						
-			index = this->getIVert( iTail )->containsEdge( iTail, iHead );
-			if ( index == -1 )
+			for ( int k = 0 ; k < 3 ; k++ )
 			{
-				Edge* e = new Edge ( this->getNEdges(), this->getIVert( iTail ), this->getIVert( iHead) );
-				Edge* eTwin = new Edge ( this->getNEdges()+1, this->getIVert( iHead ), this->getIVert( iTail ) );
-				
-				e->setTwin( eTwin );
-				eTwin->setTwin( e );
-				
-				e->addFace( f );
-				f->addEdge( e );
-				
-				this->addEdge( e );
-				this->addEdge( eTwin );
-				
-				this->addEdgeToIVertex( iTail, e );
-				this->addEdgeToIVertex( iHead, eTwin );
+				bot[3*_t+k] = lo[k];
+				top[3*_t+k] = hi[k];
 			}
-			
-			else
+		} );
+		
+		for ( int t = 1 ; t < T ; t++ )
+		{
+			for ( int k = 0 ; k < 3 ; k++ )
 			{
-				f->addEdge( this->getIEdge( index ) );
-				this->addFaceToIEdge( index, f );
+				bot[k] = min( bot[k], bot[3*t+k] );
+				top[k] = max( top[k], top[3*t+k] );
 			}
-			
-			/* We finally add the face created to the mesh */
-			this->addFace( f );
 		}
+		
+		boxBot = Vector3D( bot[0], bot[1], bot[2] );
+		boxTop = Vector3D( top[0], top[1], top[2] );
+		boxValid = true;
 	}
 	
-	file.close();
+	_bot = boxBot;
+	_top = boxTop;
 	
 	return 1;
 }
 
-void Mesh::computeNormals()
+void Mesh::normalize(int _nThreads)
 {
-	for ( int i = 0 ; i < nFaces ; i++ )
+	Vector3D	bot, top;
+	Real		scaleCoeff;
+	
+	if ( this->getBoundingBox( bot, top, _nThreads ) == -1 )
+		return;
+	
+	/* The biggest direction of the mesh (Ox, Oy or Oz) gives the scale. */
+	scaleCoeff = tools_boxSize( bot, top );
+	
+	if ( scaleCoeff <= 0 )
+		return;
+	
+	/* Now we apply the scale to every vertex of the mesh. */
+	for ( size_t i = 0 ; i < positions.size() ; i++ )
+	{
+		positions[i] /= scaleCoeff;
+	}
+	
+	/* The scale keeps the order of the coordinates : the corners of the box are scaled like the vertices they come from. */
+	Real b[3] = { (Real)bot.getX(), (Real)bot.getY(), (Real)bot.getZ() };
+	Real t[3] = { (Real)top.getX(), (Real)top.getY(), (Real)top.getZ() };
+	
+	for ( int k = 0 ; k < 3 ; k++ )
+	{
+		b[k] /= scaleCoeff;
+		t[k] /= scaleCoeff;
+	}
+	
+	boxBot = Vector3D( b[0], b[1], b[2] );
+	boxTop = Vector3D( t[0], t[1], t[2] );
+	
+	/* Every vertex was moved : refreshNormals will compute every normal again. */
+	normalsValid = false;
+}
+
+int Mesh::reorder(int _policy)
+{
+	if ( _policy != REORDER_MORTON && _policy != REORDER_HILBERT && _policy != REORDER_RCM )
 	{
-		/* For each face of the mesh, the normal will be the orthogonal vector to the face.
-		   i.e. the cross product of two different edges of the face.
-		   We then normalize the normal of the face.
-		   
-		   The implementation could be done in another way, maybe faster, but this way, the code is simple and there is no encapsulation violation.
-		*/
-		Vector3D normal = tools_crossProduct( faces[i]->getEdges()[0]->toVector(), faces[i]->getEdges()[1]->toVector() );
-		normal.normalize();
-		faces[i]->setNormal ( normal );
+		cout<<"Error while reordering the mesh : "<<_policy<<" is not a reorder policy"<<endl;
+		cout<<"Method Mesh::reorder is returning -1, check it if you didn't"<<endl;
+		return -1;
 	}
 	
+	vector<int>	vertOrder( nVerts );
+	vector<int>	faceOrder( nFaces );
+	
 	for ( int i = 0 ; i < nVerts ; i++ )
+		vertOrder[i] = i;
+	for ( int i = 0 ; i < nFaces ; i++ )
+		faceOrder[i] = i;
+	
+	if ( _policy == REORDER_RCM )
+	{
+		/* Breadth first search from a vertex of lowest degree in each connected part, the neighbours being visited by increasing degree (Cuthill-McKee).
+		   The order is then reversed. */
+		vector<int>		degree( nVerts, 0 );
+		vector<char>	visited( nVerts, 0 );
+		vector<int>		neighbours;
+		int				n = 0;
+		
+		for ( int i = 0 ; i < nVerts ; i++ )
+			for ( int e = topo->vertEdge[i] ; e != -1 ; e = topo->heNextOut[e] )
+				degree[i]++;
+		
+		stable_sort( vertOrder.begin(), vertOrder.end(), [&] ( int _a, int _b ) { return degree[_a] < degree[_b]; } );
+		
+		vector<int> byDegree( vertOrder );
+		
+		for ( int k = 0 ; k < nVerts ; k++ )
+		{
+			if ( visited[ byDegree[k] ] )
+				continue;
+			
+			int head = n;
+			
+			vertOrder[n++] = byDegree[k];
+			visited[ byDegree[k] ] = 1;
+			
+			while ( head < n )
+			{
+				int v = vertOrder[head++];
+				
+				neighbours.clear();
+				for ( int e = topo->vertEdge[v] ; e != -1 ; e = topo->heNextOut[e] )
+				{
+					if ( !visited[ topo->heHead[e] ] )
+					{
+						visited[ topo->heHead[e] ] = 1;
+						neighbours.push_back( topo->heHead[e] );
+					}
+				}
+				
+				stable_sort( neighbours.begin(), neighbours.end(), [&] ( int _a, int _b ) { return degree[_a] < degree[_b]; } );
+				for ( int j = 0 ; j < (int)neighbours.size() ; j++ )
+					vertOrder[n++] = neighbours[j];
+			}
+		}
+		
+		reverse( vertOrder.begin(), vertOrder.end() );
+		
+		/* Each face goes with its vertex which comes first. */
+		vector<int> rank( nVerts ), faceKey( nFaces, INT_MAX );
+		
+		for ( int i = 0 ; i < nVerts ; i++ )
+			rank[ vertOrder[i] ] = i;
+		for ( int i = 0 ; i < nFaces ; i++ )
+			for ( int j = topo->faceStart[i] ; j < topo->faceStart[i+1] ; j++ )
+				faceKey[i] = min( faceKey[i], rank[ topo->heHead[ topo->faceEdges[j] ] ] );
+		
+		stable_sort( faceOrder.begin(), faceOrder.end(), [&] ( int _a, int _b ) { return faceKey[_a] < faceKey[_b]; } );
+	}
+	else
 	{
-		/* For each vertex of the mesh, its normal will be the mean of the normal of the faces the vertex belongs.
-		   We then normalize the normal.
-		*/
-		Vector3D normal ( 0, 0, 0 );
-		int nbFaces = 0;
+		/* The bounding box of the mesh is split in a grid of 2^21 cells per side, the code of a cell gives its place along the curve. */
+		unsigned long long	(*code)( unsigned, unsigned, unsigned ) = ( _policy == REORDER_MORTON ) ? tools_mortonCode : tools_hilbertCode;
+		Vector3D			boxMin, boxMax;
+		double				bot[3], top[3];
+		double				scale[3];
+		
+		this->getBoundingBox( boxMin, boxMax );
+		
+		bot[0] = boxMin.getX(); bot[1] = boxMin.getY(); bot[2] = boxMin.getZ();
+		top[0] = boxMax.getX(); top[1] = boxMax.getY(); top[2] = boxMax.getZ();
 		
-		/* We cover all the edges that goes from this vertex. */ 
-		for ( int j = 0 ; j < (int)verts[i]->getEdges().size() ; j++ )
+		for ( int k = 0 ; k < 3 ; k++ )
+			scale[k] = ( top[k] > bot[k] ) ? ( ( 1 << 21 ) - 1 ) / ( top[k] - bot[k] ) : 0;
+		
+		auto cellCode = [&] ( double _x, double _y, double _z )
+		{
+			return code( (unsigned)( ( _x - bot[0] ) * scale[0] ), (unsigned)( ( _y - bot[1] ) * scale[1] ), (unsigned)( ( _z - bot[2] ) * scale[2] ) );
+		};
+		
+		/* The codes are sorted with the IDs : equal codes keep the order of the IDs. */
+		vector< pair<unsigned long long, int> > vertKey( nVerts ), faceKey( nFaces );
+		
+		for ( int i = 0 ; i < nVerts ; i++ )
+			vertKey[i] = make_pair( cellCode( positions[3*(size_t)i], positions[3*(size_t)i+1], positions[3*(size_t)i+2] ), i );
+		
+		for ( int i = 0 ; i < nFaces ; i++ )
 		{
-			/* In order to cover all the faces which contain this vertex. */
-			for ( int k = 0 ; k < (int)verts[i]->getEdges()[j]->getFaces().size() ; k++ )
+			double	center[3] = { 0, 0, 0 };
+			int		n = topo->faceStart[i+1] - topo->faceStart[i];
+			
+			for ( int j = topo->faceStart[i] ; j < topo->faceStart[i+1] ; j++ )
 			{
-				normal += verts[i]->getEdges()[j]->getFaces()[k]->getNormal();
-				nbFaces++;
+				const Real* p = &positions[ 3 * (size_t)topo->heHead[ topo->faceEdges[j] ] ];
+				
+				center[0] += p[0];
+				center[1] += p[1];
+				center[2] += p[2];
 			}
+			
+			faceKey[i] = make_pair( ( n > 0 ) ? cellCode( center[0] / n, center[1] / n, center[2] / n ) : 0, i );
 		}
 		
-		normal /= nbFaces;
-		normal.normalize();
-		verts[i]->setNormal ( normal );
+		sort( vertKey.begin(), vertKey.end() );
+		sort( faceKey.begin(), faceKey.end() );
+		
+		for ( int i = 0 ; i < nVerts ; i++ )
+			vertOrder[i] = vertKey[i].second;
+		for ( int i = 0 ; i < nFaces ; i++ )
+			faceOrder[i] = faceKey[i].second;
 	}
+	
+	this->permute( vertOrder, faceOrder );
+	
+	return 1;
 }
 
-void Mesh::normalize()
+void Mesh::permute(const vector<int> &_vertOrder, const vector<int> &_faceOrder)
 {
-	/* Top and bot will be set to the top and bottom of the mesh bounding box. */
-	Vector3D top( INT_MIN, INT_MIN, INT_MIN );
-	Vector3D bot( INT_MAX, INT_MAX, INT_MAX );
-	float	scaleCoeff = 0;
+	vector<int>		vertNew( nVerts ), faceNew( nFaces ), edgeOrder, edgeNew( nEdges, -1 );
 	
 	for ( int i = 0 ; i < nVerts ; i++ )
+		vertNew[ _vertOrder[i] ] = i;
+	for ( int i = 0 ; i < nFaces ; i++ )
+		faceNew[ _faceOrder[i] ] = i;
+	
+	/* The half edges are numbered as they are met along the loops of the faces, with their twin, then come the ones that no face reaches. */
+	edgeOrder.reserve( nEdges );
+	
+	auto number = [&] ( int _e )
 	{
-		if ( verts[i]->getPos().getX() < bot.getX() )
-			bot.setX( verts[i]->getPos().getX() );
+		if ( edgeNew[_e] != -1 )
+			return;
 		
-		if ( verts[i]->getPos().getY() < bot.getY() )
-			bot.setY( verts[i]->getPos().getY() );
+		edgeNew[_e] = (int)edgeOrder.size();
+		edgeOrder.push_back( _e );
+		edgeNew[ topo->heTwin[_e] ] = (int)edgeOrder.size();
+		edgeOrder.push_back( topo->heTwin[_e] );
+	};
+	
+	for ( int i = 0 ; i < nFaces ; i++ )
+		for ( int j = topo->faceStart[ _faceOrder[i] ] ; j < topo->faceStart[ _faceOrder[i] + 1 ] ; j++ )
+			number( topo->faceEdges[j] );
+	for ( int i = 0 ; i < nEdges ; i++ )
+		number( i );
+	
+	/* The new connectivity is built aside : the old one may be shared with a copy of the mesh. */
+	shared_ptr<MeshTopology>	newTopo = make_shared<MeshTopology>();
+	MeshTopology&				t = *newTopo;
+	auto						mapEdge = [&] ( int _e ) { return ( _e == -1 ) ? -1 : edgeNew[_e]; };
+	
+	t.vertEdge.resize( nVerts );
+	t.vertLastEdge.resize( nVerts );
+	for ( int i = 0 ; i < nVerts ; i++ )
+	{
+		t.vertEdge[i] = mapEdge( topo->vertEdge[ _vertOrder[i] ] );
+		t.vertLastEdge[i] = mapEdge( topo->vertLastEdge[ _vertOrder[i] ] );
+	}
+	
+	t.heHead.resize( nEdges );
+	t.heTwin.resize( nEdges );
+	t.heNext.resize( nEdges );
+	t.hePrev.resize( nEdges );
+	t.heFace.resize( nEdges );
+	t.heNextOut.resize( nEdges );
+	t.heExtra.resize( nEdges );
+	for ( int i = 0 ; i < nEdges ; i++ )
+	{
+		int e = edgeOrder[i];
 		
-		if ( verts[i]->getPos().getZ() < bot.getZ() )
-			bot.setZ( verts[i]->getPos().getZ() );
+		t.heHead[i] = vertNew[ topo->heHead[e] ];
+		t.heTwin[i] = edgeNew[ topo->heTwin[e] ];
+		t.heNext[i] = mapEdge( topo->heNext[e] );
+		t.hePrev[i] = mapEdge( topo->hePrev[e] );
+		t.heFace[i] = ( topo->heFace[e] == -1 ) ? -1 : faceNew[ topo->heFace[e] ];
+		t.heNextOut[i] = mapEdge( topo->heNextOut[e] );
+		t.heExtra[i] = topo->heExtra[e];
+	}
+	
+	/* The extra lists stay where they are, only their faces are renumbered. */
+	t.extraNext = topo->extraNext;
+	t.extraFace.resize( topo->extraFace.size() );
+	for ( size_t i = 0 ; i < topo->extraFace.size() ; i++ )
+		t.extraFace[i] = faceNew[ topo->extraFace[i] ];
+	
+	t.nNonTriangles = topo->nNonTriangles;
+	t.faceStart.resize( nFaces + 1 );
+	t.faceEdges.resize( topo->faceEdges.size() );
+	for ( int i = 0 ; i < nFaces ; i++ )
+	{
+		int k = t.faceStart[i];
 		
-		if ( verts[i]->getPos().getX() > top.getX() )
-			top.setX( verts[i]->getPos().getX() );
+		for ( int j = topo->faceStart[ _faceOrder[i] ] ; j < topo->faceStart[ _faceOrder[i] + 1 ] ; j++ )
+			t.faceEdges[k++] = edgeNew[ topo->faceEdges[j] ];
+		t.faceStart[i+1] = k;
+	}
+	
+	topo = newTopo;
+	
+	/* The attributes and the properties follow their element. */
+	auto permute3 = [] ( vector<Real>& _values, const vector<int>& _order )
+	{
+		vector<Real> tmp( _values.size() );
 		
-		if ( verts[i]->getPos().getY() > top.getY() )
-			top.setY( verts[i]->getPos().getY() );
+		for ( size_t i = 0 ; i < _order.size() ; i++ )
+		{
+			tmp[3*i] = _values[ 3 * (size_t)_order[i] ];
+			tmp[3*i+1] = _values[ 3 * (size_t)_order[i] + 1 ];
+			tmp[3*i+2] = _values[ 3 * (size_t)_order[i] + 2 ];
+		}
+		_values.swap( tmp );
+	};
+	
+	permute3( positions, _vertOrder );
+	permute3( normals, _vertOrder );
+	permute3( colors, _vertOrder );
+	permute3( faceNormals, _faceOrder );
+	
+	vertProps.permute( _vertOrder );
+	edgeProps.permute( edgeOrder );
+	faceProps.permute( _faceOrder );
+	
+	/* The flags of the moved vertices follow them. */
+	if ( !movedFlags.empty() )
+	{
+		vector<char> flags( nVerts );
 		
-		if ( verts[i]->getPos().getZ() > top.getZ() )
-			top.setZ( verts[i]->getPos().getZ() );
+		for ( int i = 0 ; i < nVerts ; i++ )
+			flags[i] = movedFlags[ _vertOrder[i] ];
+		movedFlags.swap( flags );
 	}
 	
-	Vector3D diff = top - bot;
+	/* The edge index is rebuilt the first time it is needed. */
+	edgeIndex.clear();
+	edgeIndexValid = false;
+}
+
+bool Mesh::isTriangleMesh()
+{
+	return topo->nNonTriangles == 0;
+}
+
+int Mesh::triangulate(int _nThreads)
+{
+	if ( this->isTriangleMesh() )
+		return 1;
+	
+	/* Triangles (v0, vj, vj+1) of each face : in the loop, vj is the head of the half edge j-1 and v0 the head of the last one. */
+	vector<int>		faceStarts( 1, 0 ), indices, triFace;
 	
-	if ( diff.getX() > diff.getY() && diff.getX() > diff.getZ() )
+	for ( int i = 0 ; i < nFaces ; i++ )
 	{
-		/* The Ox axe is the biggest direction of the mesh. */
-		scaleCoeff = diff.getX();
+		const int*	loop = &topo->faceEdges[ topo->faceStart[i] ];
+		int			n = topo->faceStart[i+1] - topo->faceStart[i];
+		
+		for ( int j = 1 ; j < n-1 ; j++ )
+		{
+			indices.push_back( topo->heHead[ loop[n-1] ] );
+			indices.push_back( topo->heHead[ loop[j-1] ] );
+			indices.push_back( topo->heHead[ loop[j] ] );
+			faceStarts.push_back( (int)indices.size() );
+			triFace.push_back( i );
+		}
 	}
 	
-	else if ( diff.getY() > diff.getX() && diff.getY() > diff.getZ() )
+	/* The mesh is rebuilt from the triangles, the old one gives back its attributes and properties. */
+	Mesh			old( std::move( *this ) );
+	vector<double>	pos( old.positions.begin(), old.positions.end() );
+	int				nTris = (int)triFace.size();
+	
+	if ( _nThreads < 1 )
+		_nThreads = tools_nThreads();
+	
+	if ( _nThreads == 1 )
+		this->build( old.nVerts, pos.data(), nTris, faceStarts.data(), indices.data() );
+	else
+		this->buildParallel( old.nVerts, pos.data(), nTris, faceStarts.data(), indices.data(), _nThreads );
+	
+	id = old.id;
+	normalsWeighting = old.normalsWeighting;
+	normals.swap( old.normals );
+	colors.swap( old.colors );
+	
+	for ( int i = 0 ; i < nTris ; i++ )
+		for ( int k = 0 ; k < 3 ; k++ )
+			faceNormals[ 3 * (size_t)i + k ] = old.faceNormals[ 3 * (size_t)triFace[i] + k ];
+	
+	/* Each half edge takes the properties of the old half edge with the same vertices (-1 for a diagonal). */
+	vector<int> edgeOrder( nEdges, -1 );
+	
+	for ( int i = 0 ; i < nEdges ; i++ )
 	{
-		/* The Oy axe is the biggest direction of the mesh. */
-		scaleCoeff = diff.getY();
+		int iTail = topo->heHead[ topo->heTwin[i] ];
+		
+		for ( int e = old.topo->vertEdge[iTail] ; e != -1 ; e = old.topo->heNextOut[e] )
+		{
+			if ( old.topo->heHead[e] == topo->heHead[i] )
+			{
+				edgeOrder[i] = e;
+				break;
+			}
+		}
 	}
 	
-	else if ( diff.getZ() > diff.getY() && diff.getZ() > diff.getX() )
+	vertProps = std::move( old.vertProps );
+	edgeProps = std::move( old.edgeProps );
+	faceProps = std::move( old.faceProps );
+	edgeProps.permute( edgeOrder );
+	faceProps.permute( triFace );
+	
+	return 1;
+}
+
+double Mesh::getArea()
+{
+	double area = 0;
+	
+	if ( !this->isTriangleMesh() )
 	{
-		/* The Oz axe is the biggest direction of the mesh. */
-		scaleCoeff = diff.getZ();
+		for ( int i = 0 ; i < nFaces ; i++ )
+			area += Face( this, i ).getArea();
+		
+		return area;
 	}
 	
-	/* Now we apply the scale to every vertex of the mesh. */
-	for ( int i = 0 ; i < nVerts ; i++ )
+	for ( int i = 0 ; i < nFaces ; i++ )
 	{
-		verts[i]->setPos( verts[i]->getPos() /= scaleCoeff );
+		const int*	loop = &topo->faceEdges[ 3 * (size_t)i ];
+		const Real*	p0 = &positions[ 3 * (size_t)topo->heHead[ loop[2] ] ];
+		const Real*	p1 = &positions[ 3 * (size_t)topo->heHead[ loop[0] ] ];
+		const Real*	p2 = &positions[ 3 * (size_t)topo->heHead[ loop[1] ] ];
+		double		a[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+		double		b[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+		double		n[3] = { a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0] };
+		
+		area += 0.5 * sqrt( n[0] * n[0] + n[1] * n[1] + n[2] * n[2] );
 	}
+	
+	return area;
 }
 
-int Mesh::colorFromMap(Map _m)
+int Mesh::colorFromMap(const Map &_m)
 {
 	if ( _m.getSize() != nVerts )
 	{
@@ -473,19 +2745,52 @@ int Mesh::colorFromMap(Map _m)
 		return -1;
 	}
 	
-	/* The map has values between min and max, we want to attribute each value another one between -(7*pi/4) and 0.
+	this->colorFromValues( _m.getDataView(), _m.getMin(), _m.getMax() );
+	
+	return 1;
+}
+
+int Mesh::colorFromProperty(const string &_name)
+{
+	Property<double>* property = this->getProperty<double>( VERTICES, _name );
+	
+	if ( property == NULL )
+	{
+		cout<<"Error while coloring the mesh : the vertices have no property \""<<_name<<"\" of doubles"<<endl;
+		cout<<"Method Mesh::colorFromProperty is returning -1, check it if you didn't"<<endl;
+		return -1;
+	}
+	
+	if ( nVerts == 0 )
+		return 1;
+	
+	ArrayView<double>	values = property->getView();
+	double				min = values[0], max = values[0];
+	
+	for ( int i = 1 ; i < nVerts ; i++ )
+	{
+		min = ( values[i] < min ) ? values[i] : min;
+		max = ( values[i] > max ) ? values[i] : max;
+	}
+	
+	this->colorFromValues( values, min, max );
+	
+	return 1;
+}
+
+void Mesh::colorFromValues(ArrayView<double> _values, double _min, double _max)
+{
+	/* The values are between min and max, we want to attribute each value another one between -(7*pi/4) and 0.
 	   a & b will contain the coefficient of the linear interpolation from [min, max] to [-(7*pi/4), 0].
 	 */
-	double a = -( (7*M_PI_4) / ( _m.getMax() - _m.getMin() ));
-	double b = -( a * _m.getMax() );
+	double a = -( (7*M_PI_4) / ( _max - _min ));
+	double b = -( a * _max );
 	
-	/* Setting the color for each vertex of the mesh according to the map. */
+	/* Setting the color for each vertex of the mesh according to its value. */
 	for ( int i = 0 ; i < nVerts ; i++ )
 	{
-		verts[i]->setColor( tools_colorFromValue( RADIANS, _m.getIData(i) * a + b ) );
+		this->getIVert( i ).setColor( tools_colorFromValue( RADIANS, _values[i] * a + b ) );
 	}
-	
-	return 1;
 }
 
 void Mesh::printInfos()
@@ -501,66 +2806,82 @@ void Mesh::displayIVertex( int _i, float _r, float _g, float _b)
 {
 	glColor3f ( _r, _g, _b );
 	glBegin ( GL_POINTS );
-		glNormal3dv ( verts[_i]->getNormalArray() );
-		glVertex3dv ( verts[_i]->getPosArray() );
+		glNormal3rv ( &normals[ 3 * (size_t)_i ] );
+		glVertex3rv ( &positions[ 3 * (size_t)_i ] );
 	glEnd();
 }
 
 void Mesh::displayIVertex( int _i )
 {
-	glColor3dv( verts[_i]->getColorArray() );
+	glColor3rv( &colors[ 3 * (size_t)_i ] );
 	glBegin ( GL_POINTS );
-		glNormal3dv ( verts[_i]->getNormalArray() );
-		glVertex3dv ( verts[_i]->getPosArray() );
+		glNormal3rv ( &normals[ 3 * (size_t)_i ] );
+		glVertex3rv ( &positions[ 3 * (size_t)_i ] );
 	glEnd();
 }
 
 void Mesh::displayVertices(float _r, float _g, float _b)
 {
+	if ( nVerts == 0 )
+		return;
+	
 	glColor3f ( _r, _g, _b );
-	glBegin ( GL_POINTS );
-	for ( int i = 0 ; i < nVerts ; i++ )
-	{
-		glNormal3dv ( verts[i]->getNormalArray() );
-		glVertex3dv ( verts[i]->getPosArray() );
-	}
-	glEnd();
+	glEnableClientState( GL_VERTEX_ARRAY );
+	glEnableClientState( GL_NORMAL_ARRAY );
+	glVertexPointer( 3, GL_REAL, 0, positions.data() );
+	glNormalPointer( GL_REAL, 0, normals.data() );
+	
+	glDrawArrays( GL_POINTS, 0, nVerts );
+	
+	glDisableClientState( GL_NORMAL_ARRAY );
+	glDisableClientState( GL_VERTEX_ARRAY );
 }
 
 void Mesh::displayVertices()
 {
-	glBegin ( GL_POINTS );
-	for ( int i = 0 ; i < nVerts ; i++ )
-	{
-		glColor3dv ( verts[i]->getColorArray() );
-		glNormal3dv ( verts[i]->getNormalArray() );
-		glVertex3dv ( verts[i]->getPosArray() );
-	}
-	glEnd();
+	if ( nVerts == 0 )
+		return;
+	
+	glEnableClientState( GL_VERTEX_ARRAY );
+	glEnableClientState( GL_NORMAL_ARRAY );
+	glEnableClientState( GL_COLOR_ARRAY );
+	glVertexPointer( 3, GL_REAL, 0, positions.data() );
+	glNormalPointer( GL_REAL, 0, normals.data() );
+	glColorPointer( 3, GL_REAL, 0, colors.data() );
+	
+	glDrawArrays( GL_POINTS, 0, nVerts );
+	
+	glDisableClientState( GL_COLOR_ARRAY );
+	glDisableClientState( GL_NORMAL_ARRAY );
+	glDisableClientState( GL_VERTEX_ARRAY );
 }
 
 void Mesh::displayIEdge(int _i, float _r, float _g, float _b)
 {
+	size_t tail = 3 * (size_t)topo->heHead[ topo->heTwin[_i] ], head = 3 * (size_t)topo->heHead[_i];
+	
 	glColor3f ( _r, _g, _b );
 	glBegin ( GL_LINES );
-		glNormal3dv ( edges[_i]->getTail()->getNormalArray() );
-		glVertex3dv ( edges[_i]->getTail()->getPosArray() );
+		glNormal3rv ( &normals[tail] );
+		glVertex3rv ( &positions[tail] );
 		
-		glNormal3dv ( edges[_i]->getHead()->getNormalArray() );
-		glVertex3dv ( edges[_i]->getHead()->getPosArray() );
+		glNormal3rv ( &normals[head] );
+		glVertex3rv ( &positions[head] );
 	glEnd();
 }
 
 void Mesh::displayIEdge(int _i )
 {
+	size_t tail = 3 * (size_t)topo->heHead[ topo->heTwin[_i] ], head = 3 * (size_t)topo->heHead[_i];
+	
 	glBegin ( GL_LINES );
-		glColor3dv ( edges[_i]->getTail()->getColorArray() );
-		glNormal3dv ( edges[_i]->getTail()->getNormalArray() );
-		glVertex3dv ( edges[_i]->getTail()->getPosArray() );
+		glColor3rv ( &colors[tail] );
+		glNormal3rv ( &normals[tail] );
+		glVertex3rv ( &positions[tail] );
 		
-		glColor3dv ( edges[_i]->getHead()->getColorArray() );
-		glNormal3dv ( edges[_i]->getHead()->getNormalArray() );
-		glVertex3dv ( edges[_i]->getHead()->getPosArray() );
+		glColor3rv ( &colors[head] );
+		glNormal3rv ( &normals[head] );
+		glVertex3rv ( &positions[head] );
 	glEnd();
 }
 
@@ -570,11 +2891,13 @@ void Mesh::displayEdges(float _r, float _g, float _b)
 	glBegin ( GL_LINES );
 	for ( int i = 0 ; i < nEdges ; i++ )
 	{
-		glNormal3dv ( edges[i]->getTail()->getNormalArray() );
-		glVertex3dv ( edges[i]->getTail()->getPosArray() );
+		size_t tail = 3 * (size_t)topo->heHead[ topo->heTwin[i] ], head = 3 * (size_t)topo->heHead[i];
 		
-		glNormal3dv ( edges[i]->getHead()->getNormalArray() );
-		glVertex3dv ( edges[i]->getHead()->getPosArray() );
+		glNormal3rv ( &normals[tail] );
+		glVertex3rv ( &positions[tail] );
+		
+		glNormal3rv ( &normals[head] );
+		glVertex3rv ( &positions[head] );
 	}
 	glEnd();
 }
@@ -584,13 +2907,15 @@ void Mesh::displayEdges()
 	glBegin ( GL_LINES );
 	for ( int i = 0 ; i < nEdges ; i++ )
 	{
-		glColor3dv ( edges[i]->getTail()->getColorArray() );
-		glNormal3dv ( edges[i]->getTail()->getNormalArray() );
-		glVertex3dv ( edges[i]->getTail()->getPosArray() );
+		size_t tail = 3 * (size_t)topo->heHead[ topo->heTwin[i] ], head = 3 * (size_t)topo->heHead[i];
+		
+		glColor3rv ( &colors[tail] );
+		glNormal3rv ( &normals[tail] );
+		glVertex3rv ( &positions[tail] );
 		
-		glColor3dv ( edges[i]->getHead()->getColorArray() );
-		glNormal3dv ( edges[i]->getHead()->getNormalArray() );
-		glVertex3dv ( edges[i]->getHead()->getPosArray() );
+		glColor3rv ( &colors[head] );
+		glNormal3rv ( &normals[head] );
+		glVertex3rv ( &positions[head] );
 	}
 	glEnd();
 }
@@ -599,10 +2924,10 @@ void Mesh::displayIFace(int _i, float _r, float _g, float _b)
 {
 	glColor3f ( _r, _g, _b );
 	glBegin ( GL_POLYGON );
-	for ( int i = 0 ; i < (int)faces[_i]->getEdges().size() ; i++ )
+	for ( int j = topo->faceStart[_i] ; j < topo->faceStart[_i+1] ; j++ )
 	{	
-		glNormal3dv ( faces[_i]->getNormalArray() );
-		glVertex3dv ( faces[_i]->getEdges()[i]->getHead()->getPosArray() );
+		glNormal3rv ( &faceNormals[ 3 * (size_t)_i ] );
+		glVertex3rv ( &positions[ 3 * (size_t)topo->heHead[ topo->faceEdges[j] ] ] );
 	}
 	glEnd();
 }
@@ -610,11 +2935,13 @@ void Mesh::displayIFace(int _i, float _r, float _g, float _b)
 void Mesh::displayIFace(int _i )
 {
 	glBegin ( GL_POLYGON );
-	for ( int i = 0 ; i < (int)faces[_i]->getEdges().size() ; i++ )
+	for ( int j = topo->faceStart[_i] ; j < topo->faceStart[_i+1] ; j++ )
 	{	
-		glColor3dv ( faces[_i]->getEdges()[i]->getHead()->getColorArray() );
-		glNormal3dv ( faces[_i]->getNormalArray() );
-		glVertex3dv ( faces[_i]->getEdges()[i]->getHead()->getPosArray() );
+		size_t head = 3 * (size_t)topo->heHead[ topo->faceEdges[j] ];
+		
+		glColor3rv ( &colors[head] );
+		glNormal3rv ( &faceNormals[ 3 * (size_t)_i ] );
+		glVertex3rv ( &positions[head] );
 	}
 	glEnd();
 }
@@ -623,10 +2950,12 @@ void Mesh::displayIFaceSmooth(int _i, float _r, float _g, float _b)
 {
 	glColor3f ( _r, _g, _b );
 	glBegin ( GL_POLYGON );
-	for ( int i = 0 ; i < (int)faces[_i]->getEdges().size() ; i++ )
+	for ( int j = topo->faceStart[_i] ; j < topo->faceStart[_i+1] ; j++ )
 	{	
-		glNormal3dv ( faces[_i]->getEdges()[i]->getHead()->getNormalArray() );
-		glVertex3dv ( faces[_i]->getEdges()[i]->getHead()->getPosArray() );
+		size_t head = 3 * (size_t)topo->heHead[ topo->faceEdges[j] ];
+		
+		glNormal3rv ( &normals[head] );
+		glVertex3rv ( &positions[head] );
 	}
 	glEnd();
 }
@@ -634,45 +2963,125 @@ void Mesh::displayIFaceSmooth(int _i, float _r, float _g, float _b)
 void Mesh::displayIFaceSmooth(int _i)
 {
 	glBegin ( GL_POLYGON );
-	for ( int i = 0 ; i < (int)faces[_i]->getEdges().size() ; i++ )
+	for ( int j = topo->faceStart[_i] ; j < topo->faceStart[_i+1] ; j++ )
 	{	
-		glColor3dv ( faces[_i]->getEdges()[i]->getHead()->getColorArray() );
-		glNormal3dv ( faces[_i]->getEdges()[i]->getHead()->getNormalArray() );
-		glVertex3dv ( faces[_i]->getEdges()[i]->getHead()->getPosArray() );
+		size_t head = 3 * (size_t)topo->heHead[ topo->faceEdges[j] ];
+		
+		glColor3rv ( &colors[head] );
+		glNormal3rv ( &normals[head] );
+		glVertex3rv ( &positions[head] );
 	}
 	glEnd();
 }
 
 void Mesh::displayFaces(float _r, float _g, float _b)
 {
+	if ( !this->isTriangleMesh() )
+	{
+		for ( int i = 0 ; i < nFaces ; i++ )
+		{
+			this->displayIFace( i, _r, _g, _b );
+		}
+		return;
+	}
+	
+	/* A triangle mesh is sent in one block, three corners per face. */
+	glColor3f ( _r, _g, _b );
+	glBegin ( GL_TRIANGLES );
 	for ( int i = 0 ; i < nFaces ; i++ )
 	{
-		this->displayIFace( i, _r, _g, _b );
+		const int* loop = &topo->faceEdges[ 3 * (size_t)i ];
+		
+		glNormal3rv ( &faceNormals[ 3 * (size_t)i ] );
+		glVertex3rv ( &positions[ 3 * (size_t)topo->heHead[ loop[0] ] ] );
+		glVertex3rv ( &positions[ 3 * (size_t)topo->heHead[ loop[1] ] ] );
+		glVertex3rv ( &positions[ 3 * (size_t)topo->heHead[ loop[2] ] ] );
 	}
+	glEnd();
 }
 
 void Mesh::displayFaces()
 {
+	if ( !this->isTriangleMesh() )
+	{
+		for ( int i = 0 ; i < nFaces ; i++ )
+		{
+			this->displayIFace( i );
+		}
+		return;
+	}
+	
+	glBegin ( GL_TRIANGLES );
 	for ( int i = 0 ; i < nFaces ; i++ )
 	{
-		this->displayIFace( i );
+		const int* loop = &topo->faceEdges[ 3 * (size_t)i ];
+		
+		glNormal3rv ( &faceNormals[ 3 * (size_t)i ] );
+		for ( int j = 0 ; j < 3 ; j++ )
+		{
+			size_t head = 3 * (size_t)topo->heHead[ loop[j] ];
+			
+			glColor3rv ( &colors[head] );
+			glVertex3rv ( &positions[head] );
+		}
 	}
+	glEnd();
 }
 
 void Mesh::displayFacesSmooth(float _r, float _g, float _b)
 {
+	if ( !this->isTriangleMesh() )
+	{
+		for ( int i = 0 ; i < nFaces ; i++ )
+		{
+			this->displayIFaceSmooth( i, _r, _g, _b );
+		}
+		return;
+	}
+	
+	glColor3f ( _r, _g, _b );
+	glBegin ( GL_TRIANGLES );
 	for ( int i = 0 ; i < nFaces ; i++ )
 	{
-		this->displayIFaceSmooth( i, _r, _g, _b );
+		const int* loop = &topo->faceEdges[ 3 * (size_t)i ];
+		
+		for ( int j = 0 ; j < 3 ; j++ )
+		{
+			size_t head = 3 * (size_t)topo->heHead[ loop[j] ];
+			
+			glNormal3rv ( &normals[head] );
+			glVertex3rv ( &positions[head] );
+		}
 	}
+	glEnd();
 }
 
 void Mesh::displayFacesSmooth()
 {
+	if ( !this->isTriangleMesh() )
+	{
+		for ( int i = 0 ; i < nFaces ; i++ )
+		{
+			this->displayIFaceSmooth( i );
+		}
+		return;
+	}
+	
+	glBegin ( GL_TRIANGLES );
 	for ( int i = 0 ; i < nFaces ; i++ )
 	{
-		this->displayIFaceSmooth( i );
+		const int* loop = &topo->faceEdges[ 3 * (size_t)i ];
+		
+		for ( int j = 0 ; j < 3 ; j++ )
+		{
+			size_t head = 3 * (size_t)topo->heHead[ loop[j] ];
+			
+			glColor3rv ( &colors[head] );
+			glNormal3rv ( &normals[head] );
+			glVertex3rv ( &positions[head] );
+		}
 	}
+	glEnd();
 }
 
 void Mesh::display(int _mode, float _r, float _g, float _b)
@@ -0,0 +1,562 @@
+#include "../inc/meshbvh.h"
+#include "../inc/parallel.h"
+#include <math.h>
+#include <algorithm>
+
+/* Largest float lower or equal to _x, and smallest float greater or equal to _x : the boxes in float still contain their triangles. */
+static float floatDown ( double _x )
+{
+	float f = (float)_x;
+
+	return ( f > _x ) ? nextafterf( f, -numeric_limits<float>::infinity() ) : f;
+}
+
+static float floatUp ( double _x )
+{
+	float f = (float)_x;
+
+	return ( f < _x ) ? nextafterf( f, numeric_limits<float>::infinity() ) : f;
+}
+
+/* Half of the area of a box given as its bottom then top corner. */
+static double halfArea ( const float* _box )
+{
+	double dx = (double)_box[3] - _box[0], dy = (double)_box[4] - _box[1], dz = (double)_box[5] - _box[2];
+
+	return dx * dy + dy * dz + dz * dx;
+}
+
+/* Grows the box _box (bottom then top corner) to contain the box _b. */
+static void growBox ( float* _box, const float* _b )
+{
+	for ( int k = 0 ; k < 3 ; k++ )
+	{
+		_box[k] = min( _box[k], _b[k] );
+		_box[k+3] = max( _box[k+3], _b[k+3] );
+	}
+}
+
+static void emptyBox ( float* _box )
+{
+	for ( int k = 0 ; k < 3 ; k++ )
+	{
+		_box[k] = numeric_limits<float>::infinity();
+		_box[k+3] = -numeric_limits<float>::infinity();
+	}
+}
+
+MeshBVH::MeshBVH()
+{
+	nodes.clear();
+	triangles.clear();
+	triFaces.clear();
+}
+
+MeshBVH::MeshBVH(Mesh &_mesh, int _nThreads)
+{
+	this->build( _mesh, _nThreads );
+}
+
+void MeshBVH::clear()
+{
+	vector<Node>().swap( nodes );
+	vector<Real>().swap( triangles );
+	vector<int>().swap( triFaces );
+}
+
+int MeshBVH::getNNodes() const
+{
+	return (int)nodes.size();
+}
+
+int MeshBVH::getNTriangles() const
+{
+	return (int)triFaces.size();
+}
+
+void MeshBVH::buildNode(vector<Node> &_out, int _node, int _begin, int _end, int *_order, const float *_boxes, int _taskSize, vector<int> *_tasks, int _depth, int _nThreads)
+{
+	int		n = _end - _begin;
+	int		T = ( n < 65536 ) ? 1 : _nThreads;
+	float	box[6], centers[6];
+
+	/* Box of the triangles and box of their centers, each thread reduces its part of the range.
+	   The small nodes (all the nodes of the tasks) keep their buffers on the stack. */
+	float			partStack[12];
+	vector<float>	partHeap;
+	float*			part = partStack;
+
+	if ( T > 1 )
+	{
+		partHeap.resize( 12 * (size_t)T );
+		part = partHeap.data();
+	}
+
+	tools_parallelFor( n, T, [&] ( int _b, int _e, int _t )
+	{
+		float* b = &part[12*(size_t)_t];
+
+		emptyBox( b );
+		emptyBox( b+6 );
+		for ( int i = _begin + _b ; i < _begin + _e ; i++ )
+		{
+			const float* tri = &_boxes[ 6 * (size_t)_order[i] ];
+
+			growBox( b, tri );
+			for ( int k = 0 ; k < 3 ; k++ )
+			{
+				float c = 0.5f * ( tri[k] + tri[k+3] );
+
+				b[6+k] = min( b[6+k], c );
+				b[9+k] = max( b[9+k], c );
+			}
+		}
+	} );
+
+	emptyBox( box );
+	emptyBox( centers );
+	for ( int t = 0 ; t < T ; t++ )
+	{
+		growBox( box, &part[12*(size_t)t] );
+		growBox( centers, &part[12*(size_t)t+6] );
+	}
+
+	for ( int k = 0 ; k < 3 ; k++ )
+	{
+		_out[_node].bot[k] = box[k];
+		_out[_node].top[k] = box[k+3];
+	}
+
+	/* The split : the axis and the bin after which the triangles go to the second child (-1 for a leaf). */
+	int		axis = -1, split = -1;
+	double	bestCost = numeric_limits<double>::infinity();
+
+	if ( n > 1 && _depth < BVH_MAX_DEPTH - 32 )
+	{
+		/* Bins of the centers : number of triangles and box along each axis, each thread fills its own bins. */
+		int				countStack[3*BVH_BINS];
+		float			binsStack[6*3*BVH_BINS];
+		vector<int>		countHeap;
+		vector<float>	binsHeap;
+		int*			count = countStack;
+		float*			bins = binsStack;
+		double			scale[3];
+
+		if ( T > 1 )
+		{
+			countHeap.resize( 3 * BVH_BINS * (size_t)T );
+			binsHeap.resize( 6 * 3 * BVH_BINS * (size_t)T );
+			count = countHeap.data();
+			bins = binsHeap.data();
+		}
+
+		for ( int k = 0 ; k < 3 ; k++ )
+			scale[k] = ( centers[k+3] > centers[k] ) ? BVH_BINS / ( (double)centers[k+3] - centers[k] ) : 0;
+
+		tools_parallelFor( n, T, [&] ( int _b, int _e, int _t )
+		{
+			int*	c = &count[ 3 * BVH_BINS * (size_t)_t ];
+			float*	b = &bins[ 6 * 3 * BVH_BINS * (size_t)_t ];
+
+			for ( int j = 0 ; j < 3 * BVH_BINS ; j++ )
+			{
+				c[j] = 0;
+				emptyBox( b + 6*j );
+			}
+
+			for ( int i = _begin + _b ; i < _begin + _e ; i++ )
+			{
+				const float* tri = &_boxes[ 6 * (size_t)_order[i] ];
+
+				for ( int k = 0 ; k < 3 ; k++ )
+				{
+					int j = min( BVH_BINS - 1, (int)( ( 0.5f * ( tri[k] + tri[k+3] ) - centers[k] ) * scale[k] ) );
+
+					c[ k * BVH_BINS + j ]++;
+					growBox( b + 6 * ( k * BVH_BINS + j ), tri );
+				}
+			}
+		} );
+
+		for ( int t = 1 ; t < T ; t++ )
+		{
+			for ( int j = 0 ; j < 3 * BVH_BINS ; j++ )
+			{
+				count[j] += count[ 3 * BVH_BINS * (size_t)t + j ];
+				growBox( &bins[6*j], &bins[ 6 * ( 3 * BVH_BINS * (size_t)t + j ) ] );
+			}
+		}
+
+		/* Surface area heuristic : a ray which hits the node hits a child with a probability given by the ratio of their areas,
+		   a split costs the test of the boxes of the children and the triangles of the children hit. */
+		for ( int k = 0 ; k < 3 ; k++ )
+		{
+			if ( scale[k] == 0 )
+				continue;
+
+			double	leftCost[BVH_BINS];
+			float	b[6];
+			int		c = 0;
+
+			emptyBox( b );
+			for ( int j = 0 ; j < BVH_BINS - 1 ; j++ )
+			{
+				c += count[ k * BVH_BINS + j ];
+				growBox( b, &bins[ 6 * ( k * BVH_BINS + j ) ] );
+				leftCost[j] = ( c > 0 ) ? c * halfArea( b ) : 0;
+			}
+
+			emptyBox( b );
+			c = 0;
+			for ( int j = BVH_BINS - 1 ; j > 0 ; j-- )
+			{
+				c += count[ k * BVH_BINS + j ];
+				growBox( b, &bins[ 6 * ( k * BVH_BINS + j ) ] );
+
+				double cost = leftCost[j-1] + ( ( c > 0 ) ? c * halfArea( b ) : 0 );
+
+				if ( c > 0 && c < n && cost < bestCost )
+				{
+					bestCost = cost;
+					axis = k;
+					split = j-1;
+				}
+			}
+		}
+
+		/* Not split if testing the triangles costs less, unless there are too many of them. */
+		if ( axis != -1 && n <= BVH_MAX_LEAF && n * halfArea( box ) <= halfArea( box ) + bestCost )
+			axis = -1;
+	}
+
+	int mid = -1;
+
+	if ( axis != -1 )
+	{
+		double s = BVH_BINS / ( (double)centers[axis+3] - centers[axis] );
+
+		mid = (int)( partition( _order + _begin, _order + _end, [&] ( int _i )
+		{
+			const float* tri = &_boxes[ 6 * (size_t)_i ];
+
+			return min( BVH_BINS - 1, (int)( ( 0.5f * ( tri[axis] + tri[axis+3] ) - centers[axis] ) * s ) ) <= split;
+		} ) - _order );
+	}
+
+	/* The triangles which can not be split by the bins (same centers, or a hierarchy getting too deep) are split in two halves. */
+	else if ( n > BVH_MAX_LEAF || ( n > 1 && _depth >= BVH_MAX_DEPTH - 32 ) )
+		mid = _begin + n / 2;
+
+	if ( mid == -1 )
+	{
+		_out[_node].first = _begin;
+		_out[_node].count = n;
+		return;
+	}
+
+	int child = (int)_out.size();
+
+	_out.resize( _out.size() + 2 );
+	_out[_node].first = child;
+	_out[_node].count = 0;
+
+	int range[4] = { _begin, mid, mid, _end };
+
+	for ( int c = 0 ; c < 2 ; c++ )
+	{
+		if ( range[2*c+1] - range[2*c] < _taskSize )
+		{
+			_tasks->push_back( child + c );
+			_tasks->push_back( range[2*c] );
+			_tasks->push_back( range[2*c+1] );
+			_tasks->push_back( _depth + 1 );
+		}
+		else
+			buildNode( _out, child + c, range[2*c], range[2*c+1], _order, _boxes, _taskSize, _tasks, _depth + 1, _nThreads );
+	}
+}
+
+int MeshBVH::build(Mesh &_mesh, int _nThreads)
+{
+	int T = ( _nThreads < 1 ) ? tools_nThreads() : _nThreads;
+	int nFaces = _mesh.getNFaces();
+
+	this->clear();
+
+	/* Each face is cut in a fan of triangles from its first vertex. */
+	vector<int> triStart( nFaces + 1, 0 );
+
+	for ( int i = 0 ; i < nFaces ; i++ )
+		triStart[i+1] = triStart[i] + max( 0, _mesh.getIFace( i ).getNEdges() - 2 );
+
+	int				nTris = triStart[nFaces];
+	vector<Real>	tris( 9 * (size_t)nTris );
+	vector<float>	boxes( 6 * (size_t)nTris );
+	vector<int>		faces( nTris );
+	vector<char>	valid( nTris );
+
+	tools_parallelFor( nFaces, T, [&] ( int _begin, int _end, int )
+	{
+		for ( int i = _begin ; i < _end ; i++ )
+		{
+			Face		f = _mesh.getIFace( i );
+			int			size = f.getNEdges();
+			const Real*	p0 = f.getIEdge( size-1 ).getHead().getPosArray();
+
+			for ( int j = 1 ; j < size-1 ; j++ )
+			{
+				int			k = triStart[i] + j-1;
+				const Real*	p1 = f.getIEdge( j-1 ).getHead().getPosArray();
+				const Real*	p2 = f.getIEdge( j ).getHead().getPosArray();
+				Real*		tri = &tris[9*(size_t)k];
+				float*		box = &boxes[6*(size_t)k];
+
+				faces[k] = i;
+				valid[k] = 1;
+				for ( int c = 0 ; c < 3 ; c++ )
+				{
+					tri[c] = p0[c];
+					tri[c+3] = p1[c] - p0[c];
+					tri[c+6] = p2[c] - p0[c];
+					box[c] = floatDown( min( p0[c], min( p1[c], p2[c] ) ) );
+					box[c+3] = floatUp( max( p0[c], max( p1[c], p2[c] ) ) );
+
+					if ( !isfinite( p0[c] ) || !isfinite( p1[c] ) || !isfinite( p2[c] ) || !isfinite( box[c] ) || !isfinite( box[c+3] ) )
+						valid[k] = 0;
+				}
+			}
+		}
+	} );
+
+	vector<int> order;
+
+	order.reserve( nTris );
+	for ( int i = 0 ; i < nTris ; i++ )
+		if ( valid[i] )
+			order.push_back( i );
+
+	int n = (int)order.size();
+
+	if ( n == 0 )
+	{
+		cout<<"Error while building the BVH : the mesh has no face with finite vertices"<<endl;
+		cout<<"Method MeshBVH::build is returning -1, check it if you didn't"<<endl;
+		return -1;
+	}
+
+	/* The top of the hierarchy is built first, its large nodes binned by every thread. The subtrees below it are tasks, built by the threads at the same time.
+	   The size of the tasks only depends on the number of triangles : the hierarchy is the same for any number of threads. */
+	vector<int> tasks;
+
+	nodes.resize( 1 );
+	buildNode( nodes, 0, 0, n, order.data(), boxes.data(), max( 1024, n / 256 ), &tasks, 0, T );
+
+	int					nTasks = (int)tasks.size() / 4;
+	vector< vector<Node> >	subtrees( nTasks );
+
+	tools_parallelFor( nTasks, T, [&] ( int _begin, int _end, int )
+	{
+		for ( int i = _begin ; i < _end ; i++ )
+		{
+			subtrees[i].resize( 1 );
+			buildNode( subtrees[i], 0, tasks[4*i+1], tasks[4*i+2], order.data(), boxes.data(), 0, NULL, tasks[4*i+3], 1 );
+		}
+	} );
+
+	/* The root of a subtree takes the place of its task, its other nodes follow the hierarchy : the two children of a node stay side by side. */
+	size_t nNodes = nodes.size();
+
+	for ( int i = 0 ; i < nTasks ; i++ )
+		nNodes += subtrees[i].size() - 1;
+	nodes.reserve( nNodes );
+
+	for ( int i = 0 ; i < nTasks ; i++ )
+	{
+		int shift = (int)nodes.size() - 1;
+
+		for ( size_t j = 0 ; j < subtrees[i].size() ; j++ )
+			if ( subtrees[i][j].count == 0 )
+				subtrees[i][j].first += shift;
+
+		nodes[ tasks[4*i] ] = subtrees[i][0];
+		nodes.insert( nodes.end(), subtrees[i].begin() + 1, subtrees[i].end() );
+		vector<Node>().swap( subtrees[i] );
+	}
+
+
+	/* The triangles are copied in the order of the leaves. */
+	triangles.resize( 9 * (size_t)n );
+	triFaces.resize( n );
+
+	tools_parallelFor( n, T, [&] ( int _begin, int _end, int )
+	{
+		for ( int i = _begin ; i < _end ; i++ )
+		{
+			int k = order[i];
+
+			std::copy( &tris[9*(size_t)k], &tris[9*(size_t)k] + 9, &triangles[9*(size_t)i] );
+			triFaces[i] = faces[k];
+		}
+	} );
+
+	return 1;
+}
+
+template < bool ANY >
+int MeshBVH::traverse(const double *_origin, const double *_dir, double _tMax, double *_t) const
+{
+	if ( nodes.empty() )
+		return -1;
+
+	/* The distances to the planes of the boxes are computed in float, from their offsets to the origin computed in double :
+	   rounding the origin itself to float would move it by much more than the size of the triangles far from (0, 0, 0).
+	   A null direction is replaced by a tiny one : the inverse stays finite, so no test gives 0 * infinity. */
+	const float	inf = numeric_limits<float>::infinity();
+	const float	pad = 1.0000006f;
+	float		inv[3];
+
+	for ( int k = 0 ; k < 3 ; k++ )
+	{
+		float d = (float)_dir[k];
+
+		if ( fabsf( d ) < 1e-20f )
+			d = ( d < 0 ) ? -1e-20f : 1e-20f;
+		inv[k] = 1.0f / d;
+	}
+
+	double	best = _tMax;
+	float	bestF = ( _tMax < numeric_limits<float>::max() ) ? floatUp( _tMax ) * pad : inf;
+	int		hit = -1;
+
+	/* Distance at which the ray enters a box, infinity if it misses it or enters it after the nearest hit.
+	   Each distance has four roundings (direction, inverse, offset and product) : the exit distance and the nearest hit are pushed a little further to make up for them. */
+	auto enter = [&] ( const Node& _n ) -> float
+	{
+		float tx0 = (float)( _n.bot[0] - _origin[0] ) * inv[0], tx1 = (float)( _n.top[0] - _origin[0] ) * inv[0];
+		float ty0 = (float)( _n.bot[1] - _origin[1] ) * inv[1], ty1 = (float)( _n.top[1] - _origin[1] ) * inv[1];
+		float tz0 = (float)( _n.bot[2] - _origin[2] ) * inv[2], tz1 = (float)( _n.top[2] - _origin[2] ) * inv[2];
+		float tIn = max( max( min( tx0, tx1 ), min( ty0, ty1 ) ), max( min( tz0, tz1 ), 0.0f ) );
+		float tOut = min( min( max( tx0, tx1 ), max( ty0, ty1 ) ), max( tz0, tz1 ) ) * pad;
+
+		return ( tIn <= tOut && tIn <= bestF ) ? tIn : inf;
+	};
+
+	int		stack[BVH_MAX_DEPTH];
+	float	stackT[BVH_MAX_DEPTH];
+	int		size = 0;
+	int		node = 0;
+
+	if ( enter( nodes[0] ) == inf )
+		return -1;
+
+	while ( true )
+	{
+		const Node& n = nodes[node];
+
+		if ( n.count > 0 )
+		{
+			/* Moller-Trumbore test of each triangle of the leaf. */
+			for ( int i = n.first ; i < n.first + n.count ; i++ )
+			{
+				const Real*	tri = &triangles[9*(size_t)i];
+				double		p[3] = { _dir[1] * tri[8] - _dir[2] * tri[7], _dir[2] * tri[6] - _dir[0] * tri[8], _dir[0] * tri[7] - _dir[1] * tri[6] };
+				double		det = tri[3] * p[0] + tri[4] * p[1] + tri[5] * p[2];
+
+				if ( det == 0 )
+					continue;
+
+				double	invDet = 1.0 / det;
+				double	s[3] = { _origin[0] - tri[0], _origin[1] - tri[1], _origin[2] - tri[2] };
+				double	u = ( s[0] * p[0] + s[1] * p[1] + s[2] * p[2] ) * invDet;
+
+				if ( u < 0 || u > 1 )
+					continue;
+
+				double	q[3] = { s[1] * tri[5] - s[2] * tri[4], s[2] * tri[3] - s[0] * tri[5], s[0] * tri[4] - s[1] * tri[3] };
+				double	v = ( _dir[0] * q[0] + _dir[1] * q[1] + _dir[2] * q[2] ) * invDet;
+
+				if ( v < 0 || u + v > 1 )
+					continue;
+
+				double t = ( tri[6] * q[0] + tri[7] * q[1] + tri[8] * q[2] ) * invDet;
+
+				if ( t > 0 && t < best )
+				{
+					best = t;
+					hit = i;
+
+					if ( ANY )
+						break;
+					bestF = floatUp( t ) * pad;
+				}
+			}
+
+			if ( ANY && hit != -1 )
+				break;
+
+			/* Next node of the stack, unless it is further than the nearest hit. */
+			while ( size > 0 && stackT[size-1] > bestF )
+				size--;
+
+			if ( size == 0 )
+				break;
+
+			node = stack[--size];
+		}
+
+		else
+		{
+			/* The nearest child is visited first, the other one is pushed. */
+			int		c0 = n.first, c1 = n.first + 1;
+			float	t0 = enter( nodes[c0] ), t1 = enter( nodes[c1] );
+
+			if ( t1 < t0 )
+			{
+				swap( c0, c1 );
+				swap( t0, t1 );
+			}
+
+			if ( t0 == inf )
+			{
+				while ( size > 0 && stackT[size-1] > bestF )
+					size--;
+
+				if ( size == 0 )
+					break;
+
+				node = stack[--size];
+				continue;
+			}
+
+			node = c0;
+			if ( t1 != inf )
+			{
+				stack[size] = c1;
+				stackT[size] = t1;
+				size++;
+			}
+		}
+	}
+
+	if ( hit != -1 && _t != NULL )
+		*_t = best;
+
+	return hit;
+}
+
+int MeshBVH::firstHit(Vector3D _origin, Vector3D _dir, double _tMax, double *_t) const
+{
+	double	o[3] = { _origin.getX(), _origin.getY(), _origin.getZ() };
+	double	d[3] = { _dir.getX(), _dir.getY(), _dir.getZ() };
+	int		hit = this->traverse<false>( o, d, _tMax, _t );
+
+	return ( hit == -1 ) ? -1 : triFaces[hit];
+}
+
+bool MeshBVH::anyHit(Vector3D _origin, Vector3D _dir, double _tMax) const
+{
+	double	o[3] = { _origin.getX(), _origin.getY(), _origin.getZ() };
+	double	d[3] = { _dir.getX(), _dir.getY(), _dir.getZ() };
+
+	return this->traverse<true>( o, d, _tMax, NULL ) != -1;
+}
@@ -0,0 +1,156 @@
+#include "../inc/meshloader.h"
+#include <iostream>
+#include <cstring>
+#include <cctype>
+
+/* Returns true if the _path file has the _ext extension (whatever its case). */
+static bool hasExtension ( const string& _path, const char* _ext )
+{
+	size_t n = strlen( _ext );
+	
+	if ( _path.size() < n )
+		return false;
+	
+	for ( size_t i = 0 ; i < n ; i++ )
+		if ( tolower( (unsigned char)_path[ _path.size() - n + i ] ) != _ext[i] )
+			return false;
+	
+	return true;
+}
+
+MeshLoader::MeshLoader()
+{
+	result = -1;
+	nThreads = 1;
+	normals = true;
+	normalized = true;
+	triangulated = false;
+}
+
+MeshLoader::~MeshLoader()
+{
+	this->cancel();
+	this->wait();
+}
+
+int MeshLoader::start(const char *_path, int _nThreads, bool _normals, bool _normalize, bool _triangulate)
+{
+	if ( result == 0 )
+	{
+		cout<<"Error while loading the file \""<<_path<<"\" : a loading is already running"<<endl;
+		cout<<"Method MeshLoader::start is returning -1, check it if you didn't"<<endl;
+		return -1;
+	}
+	
+	/* The previous loading thread is over, it only has to be joined. */
+	if ( worker.joinable() )
+		worker.join();
+	
+	path = _path;
+	nThreads = _nThreads;
+	normals = _normals;
+	normalized = _normalize;
+	triangulated = _triangulate;
+	
+	progress.reset();
+	result = 0;
+	worker = thread( &MeshLoader::run, this );
+	
+	return 1;
+}
+
+void MeshLoader::run()
+{
+	int r;
+	
+	/* Wavefront ".obj" (compressed or not) is the default format. */
+	if ( !hasExtension( path, ".smlb" ) && !hasExtension( path, ".ply" ) && !hasExtension( path, ".stl" ) )
+		r = mesh.loadOBJ( &path[0], nThreads, &progress );
+	
+	else
+	{
+		/* These loaders do not report their progress : they only go from one stage to the other. */
+		progress.stage = LOAD_PARSING;
+		
+		if ( hasExtension( path, ".smlb" ) )
+			r = mesh.loadBinary( &path[0], nThreads );
+		else if ( hasExtension( path, ".ply" ) )
+			r = mesh.loadPLY( &path[0], nThreads );
+		else
+			r = mesh.loadSTL( &path[0] );
+		
+		if ( r == 1 )
+			progress.facesRead = progress.facesBuilt = mesh.getNFaces();
+	}
+	
+	if ( r == 1 && progress.cancelled )
+	{
+		/* Cancelled once loaded : the mesh is dropped as it would have been earlier. */
+		mesh.clear();
+		r = -1;
+	}
+	
+	if ( r == 1 && ( normals || normalized || triangulated ) )
+	{
+		progress.stage = LOAD_PROCESSING;
+		
+		if ( triangulated )
+			mesh.triangulate( nThreads );
+		/* Normalized first : scaling the mesh would leave the normals to be computed again (see Mesh::refreshNormals). */
+		if ( normalized )
+			mesh.normalize( nThreads );
+		if ( normals )
+			mesh.computeNormals( NORMALS_UNIFORM, nThreads );
+	}
+	
+	progress.stage = LOAD_DONE;
+	result = r;
+}
+
+void MeshLoader::cancel()
+{
+	progress.cancelled = true;
+}
+
+int MeshLoader::wait()
+{
+	if ( worker.joinable() )
+		worker.join();
+	
+	return result;
+}
+
+int MeshLoader::getResult() const
+{
+	return result;
+}
+
+int MeshLoader::getStage() const
+{
+	return progress.stage;
+}
+
+long long MeshLoader::getBytesRead() const
+{
+	return progress.bytesRead;
+}
+
+long long MeshLoader::getBytesTotal() const
+{
+	return progress.bytesTotal;
+}
+
+long long MeshLoader::getFacesRead() const
+{
+	return progress.facesRead;
+}
+
+long long MeshLoader::getFacesBuilt() const
+{
+	return progress.facesBuilt;
+}
+
+Mesh& MeshLoader::getMesh()
+{
+	return mesh;
+}
@@ -0,0 +1,205 @@
+#include "../inc/objstats.h"
+#include "../inc/parser.h"
+#include "../inc/tools.h"
+#include <iostream>
+#include <limits>
+#include <cmath>
+#include <algorithm>
+
+ObjStats::ObjStats(bool _areas)
+{
+	areas = _areas;
+	this->clear();
+}
+
+void ObjStats::clear()
+{
+	vector<float>().swap( positions );
+	face.clear();
+
+	nVerts = 0;
+	nFaces = 0;
+	nIndices = 0;
+	nBadIndices = 0;
+	nDegenerate = 0;
+	degrees.clear();
+
+	bot.set( numeric_limits<double>::max(), numeric_limits<double>::max(), numeric_limits<double>::max() );
+	top.set( -numeric_limits<double>::max(), -numeric_limits<double>::max(), -numeric_limits<double>::max() );
+
+	totalArea = 0;
+	nAreas = 0;
+	minArea = 0;
+	maxArea = 0;
+}
+
+int ObjStats::read(const char *_path)
+{
+	int errorLine;
+
+	this->clear();
+
+	if ( parser_streamOBJ( _path, *this, errorLine ) == -1 )
+	{
+		if ( errorLine == 0 )
+			cout<<"Error while reading the file \""<<_path<<"\""<<endl;
+		else
+			cout<<"Error while reading the file \""<<_path<<"\" at line "<<errorLine<<endl;
+		cout<<"Method ObjStats::read is returning -1, check it if you didn't"<<endl;
+		return -1;
+	}
+
+	return 1;
+}
+
+void ObjStats::vertex(double _x, double _y, double _z)
+{
+	tools_extendBox( bot, top, Vector3D( _x, _y, _z ) );
+
+	if ( areas )
+	{
+		positions.push_back( (float)_x );
+		positions.push_back( (float)_y );
+		positions.push_back( (float)_z );
+	}
+
+	nVerts++;
+}
+
+void ObjStats::beginFace()
+{
+	face.clear();
+}
+
+void ObjStats::faceIndex(int _i)
+{
+	/* Same resolution as the loader : from 1, or relative to the last vertex read if negative. */
+	long long i = ( _i > 0 ) ? _i - 1 : ( _i < 0 ) ? nVerts + _i : -1;
+
+	if ( i < 0 || i >= nVerts )
+	{
+		nBadIndices++;
+		i = -1;
+	}
+
+	face.push_back( (int)i );
+}
+
+void ObjStats::endFace()
+{
+	int n = (int)face.size();
+
+	if ( (int)degrees.size() <= n )
+		degrees.resize( n+1, 0 );
+	degrees[n]++;
+
+	nFaces++;
+	nIndices += n;
+
+	if ( n < 3 )
+	{
+		nDegenerate++;
+		return;
+	}
+
+	if ( !areas || find( face.begin(), face.end(), -1 ) != face.end() )
+		return;
+
+	/* The face is split in triangles from its first vertex : the length of the sum of their normals is twice the area of the face. */
+	Vector3D	p0( positions[3*face[0]], positions[3*face[0]+1], positions[3*face[0]+2] );
+	double		sum[3] = { 0, 0, 0 };
+
+	for ( int j = 1 ; j+1 < n ; j++ )
+	{
+		Vector3D cross = tools_faceCross( p0, Vector3D( positions[3*face[j]], positions[3*face[j]+1], positions[3*face[j]+2] ),
+											  Vector3D( positions[3*face[j+1]], positions[3*face[j+1]+1], positions[3*face[j+1]+2] ) );
+
+		sum[0] += cross.getX();
+		sum[1] += cross.getY();
+		sum[2] += cross.getZ();
+	}
+
+	double area = 0.5 * sqrt( sum[0]*sum[0] + sum[1]*sum[1] + sum[2]*sum[2] );
+
+	if ( area == 0 )
+		nDegenerate++;
+
+	totalArea += area;
+	minArea = ( nAreas == 0 ) ? area : min( minArea, area );
+	maxArea = ( nAreas == 0 ) ? area : max( maxArea, area );
+	nAreas++;
+}
+
+long long ObjStats::getNVerts() const
+{
+	return nVerts;
+}
+
+long long ObjStats::getNFaces() const
+{
+	return nFaces;
+}
+
+long long ObjStats::getNBadIndices() const
+{
+	return nBadIndices;
+}
+
+long long ObjStats::getNDegenerate() const
+{
+	return nDegenerate;
+}
+
+const vector<long long>& ObjStats::getDegrees() const
+{
+	return degrees;
+}
+
+Vector3D ObjStats::getBot() const
+{
+	return bot;
+}
+
+Vector3D ObjStats::getTop() const
+{
+	return top;
+}
+
+double ObjStats::getTotalArea() const
+{
+	return totalArea;
+}
+
+double ObjStats::getMinArea() const
+{
+	return minArea;
+}
+
+double ObjStats::getMaxArea() const
+{
+	return maxArea;
+}
+
+void ObjStats::print()
+{
+	cout<<"OBJ Statistics :"<<endl;
+	cout<<"________________"<<endl;
+	cout<<"Nb vertices    = "<<nVerts<<endl;
+	cout<<"Nb faces       = "<<nFaces<<endl;
+	cout<<"Nb indices     = "<<nIndices<<endl;
+	cout<<"Bad indices    = "<<nBadIndices<<endl;
+	cout<<"Degenerate     = "<<nDegenerate<<endl;
+
+	if ( nVerts > 0 )
+	{
+		cout<<"Bounding box   = [ "<<bot.getX()<<", "<<bot.getY()<<", "<<bot.getZ()<<" ] - [ "<<top.getX()<<", "<<top.getY()<<", "<<top.getZ()<<" ]"<<endl;
+		cout<<"Box size       = "<<tools_boxSize( bot, top )<<endl;
+	}
+
+	if ( areas )
+		cout<<"Area           = "<<totalArea<<" (min "<<minArea<<", max "<<maxArea<<")"<<endl;
+
+	for ( int n = 0 ; n < (int)degrees.size() ; n++ )
+		if ( degrees[n] > 0 )
+			cout<<"Faces with "<<n<<" vertices : "<<degrees[n]<<endl;
+}
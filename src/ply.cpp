@@ -0,0 +1,190 @@
+#include "../inc/ply.h"
+#include <sstream>
+
+/* Returns the PLY_* type of a type name, -1 if it is unknown. */
+static int typeFromName ( const string& _name )
+{
+	static const char* names[] = { "char", "uchar", "short", "ushort", "int", "uint", "float", "double" };
+	static const char* sizedNames[] = { "int8", "uint8", "int16", "uint16", "int32", "uint32", "float32", "float64" };
+
+	for ( int i = 0 ; i < 8 ; i++ )
+		if ( _name == names[i] || _name == sizedNames[i] )
+			return i;
+
+	return -1;
+}
+
+int PlyElement::findProperty(const char *_name) const
+{
+	for ( int i = 0 ; i < (int)properties.size() ; i++ )
+		if ( properties[i].name == _name )
+			return i;
+
+	return -1;
+}
+
+int PlyElement::getRowSize() const
+{
+	int size = 0;
+
+	for ( int i = 0 ; i < (int)properties.size() ; i++ )
+	{
+		if ( properties[i].countType != -1 )
+			return -1;
+		size += ply_typeSize( properties[i].type );
+	}
+
+	return size;
+}
+
+const char* PlyProperty::skip(const char *_p, const char *_end) const
+{
+	size_t size;
+
+	if ( countType == -1 )
+		size = ply_typeSize( type );
+
+	else
+	{
+		if ( _end - _p < ply_typeSize( countType ) )
+			return NULL;
+
+		int n = (int)ply_readValue( _p, countType );
+		if ( n < 0 )
+			return NULL;
+		size = ply_typeSize( countType ) + (size_t)n * ply_typeSize( type );
+	}
+
+	if ( (size_t)( _end - _p ) < size )
+		return NULL;
+
+	return _p + size;
+}
+
+const char* PlyElement::skipRow(const char *_p, const char *_end) const
+{
+	for ( int i = 0 ; i < (int)properties.size() && _p != NULL ; i++ )
+		_p = properties[i].skip( _p, _end );
+
+	return _p;
+}
+
+PlyHeader::PlyHeader()
+{
+	format = PLY_ASCII;
+	elements.clear();
+	size = 0;
+}
+
+int PlyHeader::read(const char *_data, size_t _size)
+{
+	const char*	p = _data;
+	const char*	end = _data + _size;
+	bool		first = true;
+
+	elements.clear();
+	format = -1;
+
+	while ( p < end )
+	{
+		const char*		eol = (const char*) memchr( p, '\n', end - p );
+		string			line( p, ( eol == NULL ) ? end : eol );
+		istringstream	words( line );
+		string			word;
+
+		p = ( eol == NULL ) ? end : eol + 1;
+		words>>word;
+
+		/* The header is short : it is read with a stream, word by word. */
+		if ( first )
+		{
+			if ( word != "ply" )
+				return -1;
+			first = false;
+		}
+
+		else if ( word == "format" )
+		{
+			words>>word;
+			if ( word == "ascii" )
+				format = PLY_ASCII;
+			else if ( word == "binary_little_endian" )
+				format = PLY_BINARY_LE;
+			else if ( word == "binary_big_endian" )
+				format = PLY_BINARY_BE;
+			else
+				return -1;
+		}
+
+		else if ( word == "element" )
+		{
+			PlyElement element;
+
+			if ( !( words>>element.name>>element.count ) || element.count < 0 )
+				return -1;
+			elements.push_back( element );
+		}
+
+		else if ( word == "property" )
+		{
+			PlyProperty	prop;
+			string		type;
+
+			if ( elements.empty() || !( words>>type ) )
+				return -1;
+
+			if ( type == "list" )
+			{
+				string countType;
+
+				if ( !( words>>countType>>type ) )
+					return -1;
+				prop.countType = typeFromName( countType );
+				if ( prop.countType == -1 || prop.countType >= PLY_FLOAT )
+					return -1;
+			}
+			else
+				prop.countType = -1;
+
+			prop.type = typeFromName( type );
+			if ( prop.type == -1 || !( words>>prop.name ) )
+				return -1;
+
+			elements.back().properties.push_back( prop );
+		}
+
+		else if ( word == "end_header" )
+		{
+			size = p - _data;
+			return ( format == -1 ) ? -1 : 1;
+		}
+
+		/* The "comment" and "obj_info" lines are skipped. */
+	}
+
+	return -1;
+}
+
+int PlyHeader::getFormat() const
+{
+	return format;
+}
+
+size_t PlyHeader::getSize() const
+{
+	return size;
+}
+
+const vector<PlyElement>& PlyHeader::getElements() const
+{
+	return elements;
+}
+
+int PlyHeader::findElement(const char *_name) const
+{
+	for ( int i = 0 ; i < (int)elements.size() ; i++ )
+		if ( elements[i].name == _name )
+			return i;
+
+	return -1;
+}
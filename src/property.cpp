@@ -0,0 +1,157 @@
+#include "../inc/property.h"
+
+PropertySet::PropertySet()
+{
+	size = 0;
+}
+
+PropertySet::PropertySet(const PropertySet &_s)
+{
+	size = 0;
+	*this = _s;
+}
+
+PropertySet::PropertySet(PropertySet &&_s)
+{
+	size = 0;
+	*this = std::move( _s );
+}
+
+PropertySet::~PropertySet()
+{
+	for ( int i = 0 ; i < (int)properties.size() ; i++ )
+		delete properties[i];
+}
+
+PropertySet& PropertySet::operator = ( const PropertySet& _s )
+{
+	if ( this == &_s )
+		return *this;
+
+	/* The properties found in both sets are kept, so that the pointers held on them stay valid. */
+	vector<BaseProperty*> kept;
+
+	for ( int i = 0 ; i < (int)_s.properties.size() ; i++ )
+	{
+		BaseProperty* p = this->find( _s.properties[i]->getName() );
+
+		if ( p != NULL && p->assign( _s.properties[i] ) == 1 )
+			kept.push_back( p );
+		else
+			kept.push_back( _s.properties[i]->clone() );
+	}
+
+	this->replace( kept );
+	size = _s.size;
+
+	return *this;
+}
+
+PropertySet& PropertySet::operator = ( PropertySet&& _s )
+{
+	if ( this == &_s )
+		return *this;
+
+	vector<BaseProperty*> kept;
+
+	for ( int i = 0 ; i < (int)_s.properties.size() ; i++ )
+	{
+		BaseProperty* p = this->find( _s.properties[i]->getName() );
+
+		if ( p != NULL && p->take( _s.properties[i] ) == 1 )
+		{
+			kept.push_back( p );
+			delete _s.properties[i];
+		}
+		else
+			kept.push_back( _s.properties[i] );
+	}
+
+	this->replace( kept );
+	_s.properties.clear();
+	size = _s.size;
+	_s.size = 0;
+
+	return *this;
+}
+
+void PropertySet::replace(vector<BaseProperty*> &_kept)
+{
+	for ( int i = 0 ; i < (int)properties.size() ; i++ )
+		if ( std::find( _kept.begin(), _kept.end(), properties[i] ) == _kept.end() )
+			delete properties[i];
+
+	properties.swap( _kept );
+}
+
+int PropertySet::getNProperties() const
+{
+	return (int)properties.size();
+}
+
+BaseProperty* PropertySet::getIProperty(int _i) const
+{
+	return properties[_i];
+}
+
+BaseProperty* PropertySet::find(const string &_name) const
+{
+	for ( int i = 0 ; i < (int)properties.size() ; i++ )
+		if ( properties[i]->getName() == _name )
+			return properties[i];
+
+	return NULL;
+}
+
+int PropertySet::add(BaseProperty *_p)
+{
+	if ( this->find( _p->getName() ) != NULL )
+		return -1;
+
+	_p->resize( size );
+	properties.push_back( _p );
+
+	return 1;
+}
+
+int PropertySet::remove(const string &_name)
+{
+	for ( int i = 0 ; i < (int)properties.size() ; i++ )
+	{
+		if ( properties[i]->getName() == _name )
+		{
+			delete properties[i];
+			properties.erase( properties.begin() + i );
+			return 1;
+		}
+	}
+
+	return -1;
+}
+
+void PropertySet::resize(int _size)
+{
+	size = _size;
+	for ( int i = 0 ; i < (int)properties.size() ; i++ )
+		properties[i]->resize( _size );
+}
+
+void PropertySet::reserve(int _size)
+{
+	for ( int i = 0 ; i < (int)properties.size() ; i++ )
+		properties[i]->reserve( _size );
+}
+
+void PropertySet::clear()
+{
+	size = 0;
+	for ( int i = 0 ; i < (int)properties.size() ; i++ )
+		properties[i]->clear();
+}
+
+void PropertySet::permute(const vector<int> &_order)
+{
+	size = (int)_order.size();
+	for ( int i = 0 ; i < (int)properties.size() ; i++ )
+		properties[i]->permute( _order );
+}
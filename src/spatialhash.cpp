@@ -0,0 +1,113 @@
+#include "../inc/spatialhash.h"
+#include <cmath>
+#include <cstring>
+
+SpatialHash::SpatialHash(double _tolerance)
+{
+	tolerance = ( _tolerance > 0 ) ? _tolerance : 0;
+	points.clear();
+	next.clear();
+	cells.clear();
+}
+
+long long SpatialHash::key(long long _x, long long _y, long long _z)
+{
+	unsigned long long h = (unsigned long long)_x * 0x9E3779B97F4A7C15ull;
+
+	h = ( h ^ ( h >> 29 ) ) + (unsigned long long)_y * 0xBF58476D1CE4E5B9ull;
+	h = ( h ^ ( h >> 29 ) ) + (unsigned long long)_z * 0x94D049BB133111EBull;
+
+	return (long long)( h ^ ( h >> 31 ) );
+}
+
+int SpatialHash::search(long long _key, double _x, double _y, double _z) const
+{
+	unordered_map<long long, int>::const_iterator cell = cells.find( _key );
+
+	if ( cell == cells.end() )
+		return -1;
+
+	/* Different cells can share a key : the points are always compared. */
+	for ( int i = cell->second ; i != -1 ; i = next[i] )
+	{
+		double dx = points[3*i] - _x, dy = points[3*i+1] - _y, dz = points[3*i+2] - _z;
+
+		if ( dx*dx + dy*dy + dz*dz <= tolerance * tolerance )
+			return i;
+	}
+
+	return -1;
+}
+
+void SpatialHash::reserve(int _n)
+{
+	points.reserve( 3 * (size_t)_n );
+	next.reserve( _n );
+	cells.reserve( _n );
+}
+
+int SpatialHash::insert(double _x, double _y, double _z)
+{
+	long long	cx, cy, cz;
+	long long	k;
+	int			found = -1;
+
+	if ( tolerance == 0 )
+	{
+		/* Exact welding : the cell of a point is the point itself (-0 and 0 are the same point). */
+		double x = _x + 0.0, y = _y + 0.0, z = _z + 0.0;
+
+		memcpy( &cx, &x, sizeof( double ) );
+		memcpy( &cy, &y, sizeof( double ) );
+		memcpy( &cz, &z, sizeof( double ) );
+		found = this->search( key( cx, cy, cz ), _x, _y, _z );
+	}
+
+	else
+	{
+		/* A point closer than the tolerance is in the same cell or in one of the 26 neighbouring ones. */
+		cx = (long long)floor( _x / tolerance );
+		cy = (long long)floor( _y / tolerance );
+		cz = (long long)floor( _z / tolerance );
+
+		for ( int dx = -1 ; dx <= 1 && found == -1 ; dx++ )
+			for ( int dy = -1 ; dy <= 1 && found == -1 ; dy++ )
+				for ( int dz = -1 ; dz <= 1 && found == -1 ; dz++ )
+					found = this->search( key( cx+dx, cy+dy, cz+dz ), _x, _y, _z );
+	}
+
+	if ( found != -1 )
+		return found;
+
+	/* New point : it becomes the first point of its cell. */
+	int i = this->getSize();
+	k = key( cx, cy, cz );
+
+	points.push_back( _x );
+	points.push_back( _y );
+	points.push_back( _z );
+
+	unordered_map<long long, int>::iterator cell = cells.find( k );
+	if ( cell == cells.end() )
+	{
+		next.push_back( -1 );
+		cells[k] = i;
+	}
+	else
+	{
+		next.push_back( cell->second );
+		cell->second = i;
+	}
+
+	return i;
+}
+
+int SpatialHash::getSize() const
+{
+	return (int)next.size();
+}
+
+const vector<double>& SpatialHash::getPoints() const
+{
+	return points;
+}
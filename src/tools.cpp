@@ -1,6 +1,7 @@
 #include "../inc/tools.h"
 #include <iostream>
 #include <math.h>
+#include <algorithm>
 
 Vector3D tools_crossProduct(Vector3D _u, Vector3D _v )
 {
@@ -13,6 +14,95 @@ Vector3D tools_crossProduct(Vector3D _u, Vector3D _v )
 	return rslt;
 }
 
+Vector3D tools_faceCross(Vector3D _p0, Vector3D _p1, Vector3D _p2)
+{
+	Vector3D u( _p1.getX() - _p0.getX(), _p1.getY() - _p0.getY(), _p1.getZ() - _p0.getZ() );
+	Vector3D v( _p2.getX() - _p1.getX(), _p2.getY() - _p1.getY(), _p2.getZ() - _p1.getZ() );
+	
+	return tools_crossProduct( u, v );
+}
+
+void tools_extendBox(Vector3D &_bot, Vector3D &_top, Vector3D _p)
+{
+	if ( _p.getX() < _bot.getX() )
+		_bot.setX( _p.getX() );
+	
+	if ( _p.getY() < _bot.getY() )
+		_bot.setY( _p.getY() );
+	
+	if ( _p.getZ() < _bot.getZ() )
+		_bot.setZ( _p.getZ() );
+	
+	if ( _p.getX() > _top.getX() )
+		_top.setX( _p.getX() );
+	
+	if ( _p.getY() > _top.getY() )
+		_top.setY( _p.getY() );
+	
+	if ( _p.getZ() > _top.getZ() )
+		_top.setZ( _p.getZ() );
+}
+
+double tools_boxSize(Vector3D _bot, Vector3D _top)
+{
+	double dx = _top.getX() - _bot.getX();
+	double dy = _top.getY() - _bot.getY();
+	double dz = _top.getZ() - _bot.getZ();
+	
+	return max( dx, max( dy, dz ) );
+}
+
+/* Spreads the 21 lowest bits of _v, two zeros between each of them. */
+static unsigned long long spreadBits ( unsigned _v )
+{
+	unsigned long long x = _v & 0x1FFFFF;
+	
+	x = ( x | x << 32 ) & 0x1F00000000FFFFULL;
+	x = ( x | x << 16 ) & 0x1F0000FF0000FFULL;
+	x = ( x | x << 8 ) & 0x100F00F00F00F00FULL;
+	x = ( x | x << 4 ) & 0x10C30C30C30C30C3ULL;
+	x = ( x | x << 2 ) & 0x1249249249249249ULL;
+	
+	return x;
+}
+
+unsigned long long tools_mortonCode(unsigned _x, unsigned _y, unsigned _z)
+{
+	return ( spreadBits( _x ) << 2 ) | ( spreadBits( _y ) << 1 ) | spreadBits( _z );
+}
+
+unsigned long long tools_hilbertCode(unsigned _x, unsigned _y, unsigned _z)
+{
+	unsigned X[3] = { _x & 0x1FFFFF, _y & 0x1FFFFF, _z & 0x1FFFFF };
+	unsigned t;
+	
+	/* The coordinates are turned into the "transposed" Hilbert index, whose bits only have to be interleaved as a Morton code. */
+	for ( unsigned q = 1u << 20 ; q > 1 ; q >>= 1 )
+	{
+		unsigned p = q - 1;
+		
+		/* If the bit q of X[i] is set, the low bits of X[0] are inverted, else they are exchanged with those of X[i] (without branch, the bits are random). */
+		for ( int i = 0 ; i < 3 ; i++ )
+		{
+			unsigned s = p & ( 0u - ( ( X[i] & q ) != 0 ) );
+			
+			t = ( X[0] ^ X[i] ) & p & ~s;
+			X[0] ^= s ^ t;
+			X[i] ^= t;
+		}
+	}
+	
+	/* Gray encoding. */
+	X[1] ^= X[0];
+	X[2] ^= X[1];
+	
+	t = 0;
+	for ( unsigned q = 1u << 20 ; q > 1 ; q >>= 1 )
+		t ^= ( q - 1 ) & ( 0u - ( ( X[2] & q ) != 0 ) );
+	
+	return tools_mortonCode( X[0] ^ t, X[1] ^ t, X[2] ^ t );
+}
+
 void tools_couleurpure ( Vector3D tls, Vector3D& rgb )
 {
 	float t = tls.getX();
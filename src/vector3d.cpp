@@ -4,249 +4,279 @@
 
 using namespace std;
 
-Vector3D::Vector3D()
+template < class T >
+Vector3<T>::Vector3()
 {
-	x = 0;
-	y = 0;
-	z = 0;
+	coords[0] = 0;
+	coords[1] = 0;
+	coords[2] = 0;
 }
 
-Vector3D::Vector3D(double _x, double _y, double _z)
+template < class T >
+Vector3<T>::Vector3(T _x, T _y, T _z)
 {
-	x = _x;
-	y = _y;
-	z = _z;
+	coords[0] = _x;
+	coords[1] = _y;
+	coords[2] = _z;
 }
 
-Vector3D::Vector3D(const Vector3D &_v)
+template < class T >
+Vector3<T>::Vector3(const Vector3<T> &_v)
 {
-	x = _v.x;
-	y = _v.y;
-	z = _v.z;
+	coords[0] = _v.coords[0];
+	coords[1] = _v.coords[1];
+	coords[2] = _v.coords[2];
 }
 
-Vector3D::~Vector3D()
+template < class T >
+Vector3<T>::~Vector3()
 {
 	
 }
 
-Vector3D& Vector3D::operator = ( const Vector3D& _v )
+template < class T >
+Vector3<T>& Vector3<T>::operator = ( const Vector3<T>& _v )
 {
-	x = _v.x;
-	y = _v.y;
-	z = _v.z;
+	coords[0] = _v.coords[0];
+	coords[1] = _v.coords[1];
+	coords[2] = _v.coords[2];
 	
 	return *this;
 }
 
-Vector3D Vector3D::operator+= ( const double& _a )
+template < class T >
+Vector3<T> Vector3<T>::operator+= ( const T& _a )
 {
-	x += _a;
-	y += _a;
-	z += _a;
+	coords[0] += _a;
+	coords[1] += _a;
+	coords[2] += _a;
 	
 	return *this;
 }
 
-Vector3D Vector3D::operator+= ( const Vector3D& _v )
+template < class T >
+Vector3<T> Vector3<T>::operator+= ( const Vector3<T>& _v )
 {
-	x += _v.x;
-	y += _v.y;
-	z += _v.z;
+	coords[0] += _v.coords[0];
+	coords[1] += _v.coords[1];
+	coords[2] += _v.coords[2];
 	
 	return *this;
 }
 
-Vector3D Vector3D::operator+ ( const double& _a )
+template < class T >
+Vector3<T> Vector3<T>::operator+ ( const T& _a )
 {
-	x += _a;
-	y += _a;
-	z += _a;
+	coords[0] += _a;
+	coords[1] += _a;
+	coords[2] += _a;
 	
 	return *this;
 }
 
-Vector3D Vector3D::operator+ ( const Vector3D& _v )
+template < class T >
+Vector3<T> Vector3<T>::operator+ ( const Vector3<T>& _v )
 {
-	x += _v.x;
-	y += _v.y;
-	z += _v.z;
+	coords[0] += _v.coords[0];
+	coords[1] += _v.coords[1];
+	coords[2] += _v.coords[2];
 	
 	return *this;
 }
 
-Vector3D Vector3D::operator-= ( const double& _a )
+template < class T >
+Vector3<T> Vector3<T>::operator-= ( const T& _a )
 {
-	x -= _a;
-	y -= _a;
-	z -= _a;
+	coords[0] -= _a;
+	coords[1] -= _a;
+	coords[2] -= _a;
 	
 	return *this;
 }
 
-Vector3D Vector3D::operator-= ( const Vector3D& _v )
+template < class T >
+Vector3<T> Vector3<T>::operator-= ( const Vector3<T>& _v )
 {
-	x -= _v.x;
-	y -= _v.y;
-	z -= _v.z;
+	coords[0] -= _v.coords[0];
+	coords[1] -= _v.coords[1];
+	coords[2] -= _v.coords[2];
 	
 	return *this;
 }
 
-Vector3D Vector3D::operator- ( const double& _a )
+template < class T >
+Vector3<T> Vector3<T>::operator- ( const T& _a )
 {
-	x -= _a;
-	y -= _a;
-	z -= _a;
+	coords[0] -= _a;
+	coords[1] -= _a;
+	coords[2] -= _a;
 	
 	return *this;
 }
 
-Vector3D Vector3D::operator- ( const Vector3D& _v )
+template < class T >
+Vector3<T> Vector3<T>::operator- ( const Vector3<T>& _v )
 {
-	x -= _v.x;
-	y -= _v.y;
-	z -= _v.z;
+	coords[0] -= _v.coords[0];
+	coords[1] -= _v.coords[1];
+	coords[2] -= _v.coords[2];
 	
 	return *this;
 }
 
-Vector3D Vector3D::operator*= ( const double& _a )
+template < class T >
+Vector3<T> Vector3<T>::operator*= ( const T& _a )
 {
-	x *= _a;
-	y *= _a;
-	z *= _a;
+	coords[0] *= _a;
+	coords[1] *= _a;
+	coords[2] *= _a;
 	
 	return *this;
 }
 
-Vector3D Vector3D::operator*= ( const Vector3D& _v )
+template < class T >
+Vector3<T> Vector3<T>::operator*= ( const Vector3<T>& _v )
 {
-	x *= _v.x;
-	y *= _v.y;
-	z *= _v.z;
+	coords[0] *= _v.coords[0];
+	coords[1] *= _v.coords[1];
+	coords[2] *= _v.coords[2];
 	
 	return *this;
 }
 
-Vector3D Vector3D::operator* ( const double& _a )
+template < class T >
+Vector3<T> Vector3<T>::operator* ( const T& _a )
 {
-	x *= _a;
-	y *= _a;
-	z *= _a;
+	coords[0] *= _a;
+	coords[1] *= _a;
+	coords[2] *= _a;
 	
 	return *this;
 }
 
-Vector3D Vector3D::operator* ( const Vector3D& _v )
+template < class T >
+Vector3<T> Vector3<T>::operator* ( const Vector3<T>& _v )
 {
-	x *= _v.x;
-	y *= _v.y;
-	z *= _v.z;
+	coords[0] *= _v.coords[0];
+	coords[1] *= _v.coords[1];
+	coords[2] *= _v.coords[2];
 	
 	return *this;
 }
 
-Vector3D Vector3D::operator/= ( const Vector3D& _v )
+template < class T >
+Vector3<T> Vector3<T>::operator/= ( const Vector3<T>& _v )
 {
-	x /= _v.x;
-	y /= _v.y;
-	z /= _v.z;
+	coords[0] /= _v.coords[0];
+	coords[1] /= _v.coords[1];
+	coords[2] /= _v.coords[2];
 	
 	return *this;
 }
 
-Vector3D Vector3D::operator/= ( const double& _a )
+template < class T >
+Vector3<T> Vector3<T>::operator/= ( const T& _a )
 {
-	x /= _a;
-	y /= _a;
-	z /= _a;
+	coords[0] /= _a;
+	coords[1] /= _a;
+	coords[2] /= _a;
 	
 	return *this;
 }
 
-Vector3D Vector3D::operator/ ( const Vector3D& _v )
+template < class T >
+Vector3<T> Vector3<T>::operator/ ( const Vector3<T>& _v )
 {
-	x /= _v.x;
-	y /= _v.y;
-	z /= _v.z;
+	coords[0] /= _v.coords[0];
+	coords[1] /= _v.coords[1];
+	coords[2] /= _v.coords[2];
 	
 	return *this;
 }
 
-Vector3D Vector3D::operator/ ( const double& _a )
+template < class T >
+Vector3<T> Vector3<T>::operator/ ( const T& _a )
 {
-	x /= _a;
-	y /= _a;
-	z /= _a;
+	coords[0] /= _a;
+	coords[1] /= _a;
+	coords[2] /= _a;
 	
 	return *this;
 }
 
-double Vector3D::getX()
+template < class T >
+T Vector3<T>::getX()
 {
-	return x;
+	return coords[0];
 }
 
-double Vector3D::getY()
+template < class T >
+T Vector3<T>::getY()
 {
-	return y;
+	return coords[1];
 }
 
-double Vector3D::getZ()
+template < class T >
+T Vector3<T>::getZ()
 {
-	return z;
+	return coords[2];
 }
 
-double* Vector3D::getArray()
+template < class T >
+T* Vector3<T>::getArray()
 {
-	double* rslt = (double*) malloc ( 3 * sizeof (double));
-	
-	rslt[0] = x;
-	rslt[1] = y;
-	rslt[2] = z;
-	
-	return rslt;
+	return coords;
 }
 
-void Vector3D::setX(double _x)
+template < class T >
+void Vector3<T>::setX(T _x)
 {
-	x = _x;
+	coords[0] = _x;
 }
 
-void Vector3D::setY(double _y)
+template < class T >
+void Vector3<T>::setY(T _y)
 {
-	y = _y;
+	coords[1] = _y;
 }
 
-void Vector3D::setZ(double _z)
+template < class T >
+void Vector3<T>::setZ(T _z)
 {
-	z = _z;
+	coords[2] = _z;
 }
 
-void Vector3D::set(double _x, double _y, double _z)
+template < class T >
+void Vector3<T>::set(T _x, T _y, T _z)
 {
-	x = _x;
-	y = _y;
-	z = _z;
+	coords[0] = _x;
+	coords[1] = _y;
+	coords[2] = _z;
 }
 
-void Vector3D::clear()
+template < class T >
+void Vector3<T>::clear()
 {
-	x = 0;
-	y = 0;
-	z = 0;
+	coords[0] = 0;
+	coords[1] = 0;
+	coords[2] = 0;
 }
 
-void Vector3D::normalize()
+template < class T >
+void Vector3<T>::normalize()
 {
-	double norme = sqrt ( x*x + y*y + z*z );
-	x /= norme;
-	y /= norme;
-	z /= norme;
+	T norme = sqrt ( coords[0]*coords[0] + coords[1]*coords[1] + coords[2]*coords[2] );
+	coords[0] /= norme;
+	coords[1] /= norme;
+	coords[2] /= norme;
 }
 
-void Vector3D::print()
+template < class T >
+void Vector3<T>::print()
 {
-	cout<<"[ "<<x<<" "<<y<<" "<<z<<" ]"<<endl;
+	cout<<"[ "<<coords[0]<<" "<<coords[1]<<" "<<coords[2]<<" ]"<<endl;
 }
+
+/* The two precisions are compiled here, once and for all. */
+template class Vector3<double>;
+template class Vector3<float>;